@@ -563,7 +563,7 @@ static progType analyzeProg (const const_striType sourceFileArgument,
         shutIncludeFileHash((rtlHashType) resultProg->includeFileHash);
         resultProg->includeFileHash = NULL;
         if (options & SHOW_STATISTICS) {
-          show_statistic();
+          show_statistic(resultProg);
           if (resultProg->error_count >= 1) {
             printf("%6d error%s found\n",
                 resultProg->error_count,
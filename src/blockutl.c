@@ -46,6 +46,7 @@
 #include "traceutl.h"
 #include "objutl.h"
 #include "match.h"
+#include "tcode.h"
 
 #undef EXTERN
 #define EXTERN
@@ -205,6 +206,7 @@ void free_block (blockType block)
   { /* free_block */
     logFunction(printf("free_block(" FMT_U_MEM ")\n",
                        (memSizeType) block););
+    tcFree(block->tcode);
     free_expression(block->body);
     free_local_consts(block->local_consts);
     free_loclist(block->params);
@@ -243,6 +245,7 @@ blockType new_block (locListType block_params, const_locObjType block_result,
       created_block->local_vars = block_local_vars;
       created_block->local_consts = block_local_consts;
       created_block->body = block_body;
+      created_block->tcode = NULL;
     } /* if */
     logFunction(printf("new_block --> " FMT_U_MEM "\n", (memSizeType) created_block););
     return created_block;
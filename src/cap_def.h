@@ -66,6 +66,9 @@ EXTERN char *enter_reverse_mode;     /* mr turn on reverse video mode */
 EXTERN boolType ceol_standout_glitch;/* xs standout not erased by overwriting */
 EXTERN char *parm_insert_line;       /* AL add #1 new blank lines (PG*) */
 EXTERN char *parm_delete_line;       /* DL delete #1 lines (PG*) */
+EXTERN char *change_scroll_region;   /* cs change region to line #1 to line #2 */
+EXTERN char *scroll_forward;         /* sf scroll text up */
+EXTERN char *scroll_reverse;         /* sr scroll text down */
 EXTERN char *keypad_local;           /* ke out of keypad transmit mode */
 EXTERN char *keypad_xmit;            /* ks put terminal in keypad transmit mode */
 EXTERN char *key_backspace;          /* kb sent by backspace key */
@@ -160,6 +160,13 @@
  *      C programs are compiled with a 64-bit C compiler.
  *  CC_OPT_LINK_TIME_OPTIMIZATION: (optional)
  *      Contains the compiler option for link time optimization (e.g.: "-flto").
+ *  CC_OPT_PROFILE_GENERATE: (optional)
+ *      Contains the compiler and linker option to generate a program, which
+ *      writes profile data when it is executed (e.g.: "-fprofile-generate").
+ *  CC_OPT_PROFILE_USE: (optional)
+ *      Contains the compiler option to optimize with the profile data
+ *      written by a program compiled with CC_OPT_PROFILE_GENERATE
+ *      (e.g.: "-fprofile-use").
  *  CC_OPT_POSITION_INDEPENDENT_CODE: (optional)
  *      Contains the compiler option to generate position independent code.
  *  LINKER_OPT_STATIC_LINKING: (optional)
@@ -1889,6 +1896,21 @@ static void checkSignal (FILE *versionFile)
       } /* if */
     } /* if */
     fprintf(versionFile, "#define SIGNAL_RESETS_HANDLER %d\n", signal_resets_handler);
+    if (has_sigaction &&
+        compileAndLinkOk("#include <stdio.h>\n#include <signal.h>\n"
+                         "#include <sys/time.h>\n"
+                         "int main(int argc, char *argv[]){\n"
+                         "struct itimerval timerVal;\n"
+                         "timerVal.it_interval.tv_sec = 0;\n"
+                         "timerVal.it_interval.tv_usec = 0;\n"
+                         "timerVal.it_value = timerVal.it_interval;\n"
+                         "printf(\"%d\\n\", SIGPROF != 0 &&\n"
+                         "    setitimer(ITIMER_PROF, &timerVal, NULL) == 0);\n"
+                         "return 0;}\n") && doTest() == 1) {
+      fputs("#define HAS_SETITIMER 1\n", versionFile);
+    } else {
+      fputs("#define HAS_SETITIMER 0\n", versionFile);
+    } /* if */
   } /* checkSignal */
 
 
@@ -4507,6 +4529,68 @@ static void determinePreprocessorProperties (FILE *versionFile)
 
 
 
+/**
+ *  Determine if functions can be compiled for a specific CPU feature.
+ *  Functions with __attribute__((target(...))) can use instructions
+ *  that are not available on all CPUs of an architecture. With
+ *  __builtin_cpu_supports() the availability of the feature is
+ *  checked at run-time.
+ */
+static void determineCpuFeatureDispatch (FILE *versionFile)
+
+  { /* determineCpuFeatureDispatch */
+    fprintf(versionFile, "#define HAS_PCLMUL_TARGET_ATTRIBUTE %d\n",
+            compileAndLinkOk("#include <stdio.h>\n"
+                             "#include <immintrin.h>\n"
+                             "__attribute__((target(\"pclmul,sse4.1\")))\n"
+                             "static int clmul (long long a, long long b)\n"
+                             "{ __m128i x = _mm_clmulepi64_si128(\n"
+                             "      _mm_set_epi64x(0, a), _mm_set_epi64x(0, b), 0x00);\n"
+                             "  return _mm_extract_epi32(x, 0); }\n"
+                             "int main(int argc, char *argv[]){\n"
+                             "if (__builtin_cpu_supports(\"pclmul\") &&\n"
+                             "    __builtin_cpu_supports(\"sse4.1\")) {\n"
+                             "  printf(\"%d\\n\", clmul(3, 3) == 5);\n"
+                             "} else {\n"
+                             "  printf(\"1\\n\");\n"
+                             "}\n"
+                             "return 0;}\n") &&
+            doTest() == 1);
+    fprintf(versionFile, "#define HAS_SSE42_TARGET_ATTRIBUTE %d\n",
+            compileAndLinkOk("#include <stdio.h>\n"
+                             "#include <immintrin.h>\n"
+                             "__attribute__((target(\"sse4.2\")))\n"
+                             "static unsigned int crc32c (unsigned long long word)\n"
+                             "{ return (unsigned int) _mm_crc32_u64(0, word); }\n"
+                             "int main(int argc, char *argv[]){\n"
+                             "if (__builtin_cpu_supports(\"sse4.2\")) {\n"
+                             "  printf(\"%d\\n\", crc32c(0) == 0);\n"
+                             "} else {\n"
+                             "  printf(\"1\\n\");\n"
+                             "}\n"
+                             "return 0;}\n") &&
+            doTest() == 1);
+    fprintf(versionFile, "#define HAS_AES_TARGET_ATTRIBUTE %d\n",
+            compileAndLinkOk("#include <stdio.h>\n"
+                             "#include <immintrin.h>\n"
+                             "__attribute__((target(\"aes,sse4.1\")))\n"
+                             "static int sbox (void)\n"
+                             "{ __m128i x = _mm_aesenclast_si128(\n"
+                             "      _mm_setzero_si128(), _mm_setzero_si128());\n"
+                             "  return _mm_extract_epi32(x, 0); }\n"
+                             "int main(int argc, char *argv[]){\n"
+                             "if (__builtin_cpu_supports(\"aes\") &&\n"
+                             "    __builtin_cpu_supports(\"sse4.1\")) {\n"
+                             "  printf(\"%d\\n\", sbox() == 0x63636363);\n"
+                             "} else {\n"
+                             "  printf(\"1\\n\");\n"
+                             "}\n"
+                             "return 0;}\n") &&
+            doTest() == 1);
+  } /* determineCpuFeatureDispatch */
+
+
+
 static void localtimeProperties (FILE *versionFile)
 
   { /* localtimeProperties */
@@ -7001,6 +7085,18 @@ static void determineOsFunctions (FILE *versionFile)
                              "printf(\"%d\\n\", pipe2(pipefd, 0) == 0);\n"
                              "return 0;}\n") &&
             doTest() == 1);
+    fprintf(versionFile,
+            "#define HAS_POSIX_SPAWN %d\n",
+            compileAndLinkOk("#include <stdio.h>\n#include <spawn.h>\n"
+                             "int main(int argc,char *argv[])\n"
+                             "{posix_spawn_file_actions_t actions;\n"
+                             "printf(\"%d\\n\", posix_spawn != NULL &&\n"
+                             "    posix_spawn_file_actions_init(&actions) == 0 &&\n"
+                             "    posix_spawn_file_actions_adddup2(&actions, 1, 2) == 0 &&\n"
+                             "    posix_spawn_file_actions_addclose(&actions, 1) == 0 &&\n"
+                             "    posix_spawn_file_actions_destroy(&actions) == 0);\n"
+                             "return 0;}\n") &&
+            doTest() == 1);
     fprintf(versionFile,
             "#define HAS_SNPRINTF %d\n",
             compileAndLinkOk("#include <stdio.h>\n"
@@ -7468,6 +7564,53 @@ static void determineOptionForLinkTimeOptimization (FILE *versionFile)
 
 
 
+static void determineOptionsForProfileGuidedOptimization (FILE *versionFile)
+
+  {
+#if defined CC_OPT_PROFILE_GENERATE && defined CC_OPT_PROFILE_USE
+    char profileFileName[NAME_SIZE];
+    int canDoProfileGuidedOptimization = 0;
+#endif
+
+  /* determineOptionsForProfileGuidedOptimization */
+    fprintf(logFile, "Check for profile guided optimization: ");
+#if defined CC_OPT_PROFILE_GENERATE && defined CC_OPT_PROFILE_USE
+    if (compileAndLinkWithOptionsOk("#include <stdio.h>\n"
+                                    "int main (int argc, char *argv[]) {\n"
+                                    "printf(\"%d\\n\", 1);\n"
+                                    "return 0; }\n",
+                                    CC_OPT_PROFILE_GENERATE,
+                                    CC_OPT_PROFILE_GENERATE) &&
+        doTest() == 1) {
+      /* The profile data written by the test program is not needed. */
+      sprintf(profileFileName, "ctest%d.gcda", testNumber);
+      doRemove(profileFileName);
+      if (compileAndLinkWithOptionsOk("#include <stdio.h>\n"
+                                      "int main (int argc, char *argv[]) {\n"
+                                      "printf(\"%d\\n\", 1);\n"
+                                      "return 0; }\n",
+                                      CC_OPT_PROFILE_USE, "") &&
+          doTest() == 1) {
+        canDoProfileGuidedOptimization = 1;
+      } /* if */
+    } /* if */
+    if (canDoProfileGuidedOptimization) {
+      fprintf(logFile, " Done with the options: %s and %s\n",
+              CC_OPT_PROFILE_GENERATE, CC_OPT_PROFILE_USE);
+      fprintf(versionFile, "#define CC_OPT_PROFILE_GENERATE \"%s\"\n",
+              CC_OPT_PROFILE_GENERATE);
+      fprintf(versionFile, "#define CC_OPT_PROFILE_USE \"%s\"\n",
+              CC_OPT_PROFILE_USE);
+    } else {
+      fprintf(logFile, " Not available.\n");
+    } /* if */
+#else
+    fprintf(logFile, "Not available.\n");
+#endif
+  } /* determineOptionsForProfileGuidedOptimization */
+
+
+
 #ifdef POTENTIAL_PARTIAL_LINKING_OPTIONS
 static int checkPartialLinking (const char *ccOptPartialLinking)
 
@@ -11520,6 +11663,7 @@ int main (int argc, char **argv)
     setSeed7Library(seed7_library_arg, buildDirectory, seed7Library);
     fprintf(logFile, " done\n");
     determineOptionForLinkTimeOptimization(versionFile);
+    determineOptionsForProfileGuidedOptimization(versionFile);
     determinePartialLinking(versionFile);
     determineLibraryProperties(versionFile);
     numericSizes(versionFile);
@@ -11743,6 +11887,7 @@ int main (int argc, char **argv)
     determineStackDirection(versionFile);
     determineLanguageProperties(versionFile);
     determinePreprocessorProperties(versionFile);
+    determineCpuFeatureDispatch(versionFile);
 #ifndef DEFAULT_STACK_SIZE
     if (sizeof(char *) == 8) { /* Machine with 64-bit addresses */
       /* Due to alignment some 64-bit machines have huge stack requirements. */
@@ -112,6 +112,12 @@
 #ifndef CC_OPT_LINK_TIME_OPTIMIZATION
 #define CC_OPT_LINK_TIME_OPTIMIZATION ""
 #endif
+#ifndef CC_OPT_PROFILE_GENERATE
+#define CC_OPT_PROFILE_GENERATE ""
+#endif
+#ifndef CC_OPT_PROFILE_USE
+#define CC_OPT_PROFILE_USE ""
+#endif
 #ifndef LINKER_OPT_LTO_MANDATORY
 #define LINKER_OPT_LTO_MANDATORY 0
 #endif
@@ -2193,6 +2199,10 @@ striType cmdConfigValue (const const_striType name)
       opt = CC_OPT_OPTIMIZE_3;
     } else if (strcmp(opt_name, "CC_OPT_POSITION_INDEPENDENT_CODE") == 0) {
       opt = CC_OPT_POSITION_INDEPENDENT_CODE;
+    } else if (strcmp(opt_name, "CC_OPT_PROFILE_GENERATE") == 0) {
+      opt = CC_OPT_PROFILE_GENERATE;
+    } else if (strcmp(opt_name, "CC_OPT_PROFILE_USE") == 0) {
+      opt = CC_OPT_PROFILE_USE;
     } else if (strcmp(opt_name, "CC_OPT_TRAP_OVERFLOW") == 0) {
       opt = CC_OPT_TRAP_OVERFLOW;
     } else if (strcmp(opt_name, "CC_OPT_VERSION_INFO") == 0) {
@@ -0,0 +1,3430 @@
+/********************************************************************/
+/*                                                                  */
+/*  cmp_rtl.c     Primitive actions for compression.                */
+/*  Copyright (C) 2026  agent                                       */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/cmp_rtl.c                                       */
+/*  Changes: 2026  agent                                            */
+/*  Content: Primitive actions for compression.                     */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#if HAS_PCLMUL_TARGET_ATTRIBUTE || HAS_SSE42_TARGET_ATTRIBUTE
+#include "immintrin.h"
+#endif
+
+#include "common.h"
+#include "heaputl.h"
+#include "striutl.h"
+#include "int_rtl.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#include "cmp_rtl.h"
+
+
+#define DEFLATE_WINDOW_SIZE     32768
+#define DEFLATE_WINDOW_MASK     (DEFLATE_WINDOW_SIZE - 1)
+#define DEFLATE_HASH_BITS       15
+#define DEFLATE_HASH_SIZE       (1 << DEFLATE_HASH_BITS)
+#define DEFLATE_MIN_MATCH       3
+#define DEFLATE_MAX_MATCH       258
+#define DEFLATE_TOO_FAR         4096
+#define DEFLATE_BLOCK_SYMBOLS   16384
+#define DEFLATE_STORED_MAX      65535
+#define DEFLATE_END_OF_BLOCK    256
+#define DEFLATE_LIT_LEN_CODES   286
+#define DEFLATE_FIXED_LIT_LEN   288
+#define DEFLATE_DIST_CODES      30
+#define DEFLATE_CODE_LEN_CODES  19
+#define DEFLATE_MAX_CODE_LENGTH 15
+#define DEFLATE_MAX_CL_LENGTH   7
+#define DEFLATE_MAX_SYMBOLS     DEFLATE_FIXED_LIT_LEN
+
+typedef struct {
+    unsigned int goodLength;  /* Reduce the search if the previous match is this long. */
+    unsigned int maxLazy;     /* Lazy: Do not search if the previous match is this long. */
+                              /* Fast: Do not insert substrings of longer matches.      */
+    unsigned int niceLength;  /* Stop the search if a match is this long.               */
+    unsigned int maxChain;    /* Maximum number of hash chain entries to check.         */
+    boolType lazy;            /* Use lazy match evaluation.                             */
+  } deflateConfigType;
+
+/* The parameters for the levels 1 to 9 are the same as the ones used by zlib. */
+static const deflateConfigType deflateConfig[] = {
+    /* 0 */ { 0,   0,   0,    0, FALSE},  /* Store only */
+    /* 1 */ { 4,   4,   8,    4, FALSE},
+    /* 2 */ { 4,   5,  16,    8, FALSE},
+    /* 3 */ { 4,   6,  32,   32, FALSE},
+    /* 4 */ { 4,   4,  16,   16, TRUE},
+    /* 5 */ { 8,  16,  32,   32, TRUE},
+    /* 6 */ { 8,  16, 128,  128, TRUE},
+    /* 7 */ { 8,  32, 128,  256, TRUE},
+    /* 8 */ {32, 128, 258, 1024, TRUE},
+    /* 9 */ {32, 258, 258, 4096, TRUE}};
+
+static const uint16Type lengthBase[] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+
+static const uint8Type lengthExtraBits[] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+
+static const uint16Type distanceBase[] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+    8193, 12289, 16385, 24577};
+
+static const uint8Type distanceExtraBits[] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+/* Order in which the code length code lengths are written. */
+static const uint8Type codeLengthOrder[] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+typedef struct {
+    uint32Type key;
+    uint16Type symbol;
+  } symFreqType;
+
+typedef struct {
+    uint8Type length[DEFLATE_MAX_SYMBOLS];
+    uint16Type code[DEFLATE_MAX_SYMBOLS];
+  } huffmanCodeType;
+
+typedef struct {
+    const deflateConfigType *config;
+    const_ustriType data;        /* Window followed by the data to compress. */
+    memSizeType dataLength;
+    memSizeType *head;           /* Hash value -> position + 1 (0 = none). */
+    memSizeType *prev;           /* Position mod window size -> position + 1. */
+    uint16Type *symLength;       /* Literal or match length of a symbol. */
+    uint16Type *symDistance;     /* Zero for literals. */
+    memSizeType numSymbols;
+    memSizeType blockStart;      /* Data position where the current block starts. */
+    memSizeType emittedPos;      /* Data position after the last emitted symbol. */
+    uint32Type litLenFreq[DEFLATE_LIT_LEN_CODES];
+    uint32Type distFreq[DEFLATE_DIST_CODES];
+    ustriType out;
+    memSizeType outSize;
+    memSizeType outCapacity;
+    uint32Type bitBuffer;
+    unsigned int bitCount;
+    boolType memoryError;
+  } deflateStateType;
+
+
+
+static inline unsigned int deflateHash (const_ustriType data)
+
+  { /* deflateHash */
+    return (unsigned int) ((((uint32Type) data[0] |
+                             (uint32Type) data[1] << 8 |
+                             (uint32Type) data[2] << 16) *
+                            UINT32_SUFFIX(2654435761)) >> (32 - DEFLATE_HASH_BITS));
+  } /* deflateHash */
+
+
+
+static inline void insertString (deflateStateType *state, memSizeType pos)
+
+  {
+    unsigned int hash;
+
+  /* insertString */
+    if (pos + DEFLATE_MIN_MATCH <= state->dataLength) {
+      hash = deflateHash(&state->data[pos]);
+      state->prev[pos & DEFLATE_WINDOW_MASK] = state->head[hash];
+      state->head[hash] = pos + 1;
+    } /* if */
+  } /* insertString */
+
+
+
+/**
+ *  Find the longest match for the data at 'pos' in the window.
+ *  Only matches longer than 'prevLength' are considered.
+ *  @return the length of the longest match, or 'prevLength' if
+ *          no longer match was found.
+ */
+static unsigned int longestMatch (const deflateStateType *state,
+    memSizeType pos, unsigned int prevLength, memSizeType *matchPos)
+
+  {
+    const_ustriType data;
+    const_ustriType scan;
+    const_ustriType candidate;
+    memSizeType limit;
+    memSizeType chainPos;
+    unsigned int chainLength;
+    unsigned int maxLength;
+    unsigned int niceLength;
+    unsigned int bestLength;
+    unsigned int length;
+
+  /* longestMatch */
+    data = state->data;
+    scan = &data[pos];
+    limit = pos > DEFLATE_WINDOW_SIZE ? pos - DEFLATE_WINDOW_SIZE : 0;
+    maxLength = state->dataLength - pos > DEFLATE_MAX_MATCH ?
+                DEFLATE_MAX_MATCH : (unsigned int) (state->dataLength - pos);
+    niceLength = state->config->niceLength < maxLength ?
+                 state->config->niceLength : maxLength;
+    chainLength = state->config->maxChain;
+    if (prevLength >= state->config->goodLength) {
+      chainLength >>= 2;
+    } /* if */
+    bestLength = prevLength < DEFLATE_MIN_MATCH - 1 ? DEFLATE_MIN_MATCH - 1 : prevLength;
+    if (bestLength >= maxLength) {
+      return prevLength;
+    } /* if */
+    chainPos = state->head[deflateHash(scan)];
+    while (chainPos != 0 && chainLength != 0) {
+      chainPos--;
+      if (chainPos < limit) {
+        break;
+      } /* if */
+      candidate = &data[chainPos];
+      if (candidate[bestLength] == scan[bestLength] &&
+          candidate[0] == scan[0] && candidate[1] == scan[1]) {
+        length = 2;
+        while (length < maxLength && candidate[length] == scan[length]) {
+          length++;
+        } /* while */
+        if (length > bestLength) {
+          bestLength = length;
+          *matchPos = chainPos;
+          if (length >= niceLength) {
+            break;
+          } /* if */
+        } /* if */
+      } /* if */
+      chainPos = state->prev[chainPos & DEFLATE_WINDOW_MASK];
+      chainLength--;
+    } /* while */
+    return bestLength > prevLength && bestLength >= DEFLATE_MIN_MATCH ?
+           bestLength : prevLength;
+  } /* longestMatch */
+
+
+
+static inline unsigned int lengthCodeIndex (unsigned int length)
+
+  {
+    unsigned int value;
+    unsigned int extraBits;
+
+  /* lengthCodeIndex */
+    if (length == DEFLATE_MAX_MATCH) {
+      return 28;
+    } else {
+      value = length - DEFLATE_MIN_MATCH;
+      if (value < 8) {
+        return value;
+      } else {
+        extraBits = 1;
+        while ((value >> extraBits) >= 8) {
+          extraBits++;
+        } /* while */
+        return 4 * (extraBits + 1) + ((value >> extraBits) & 3);
+      } /* if */
+    } /* if */
+  } /* lengthCodeIndex */
+
+
+
+static inline unsigned int distanceCode (unsigned int distance)
+
+  {
+    unsigned int value;
+    unsigned int bitLength;
+
+  /* distanceCode */
+    value = distance - 1;
+    if (value < 4) {
+      return value;
+    } else {
+      bitLength = 2;
+      while ((value >> bitLength) != 0) {
+        bitLength++;
+      } /* while */
+      return 2 * (bitLength - 1) + ((value >> (bitLength - 2)) & 1);
+    } /* if */
+  } /* distanceCode */
+
+
+
+static boolType ensureOutCapacity (deflateStateType *state, memSizeType additional)
+
+  {
+    memSizeType newCapacity;
+    ustriType newOut;
+
+  /* ensureOutCapacity */
+    if (state->outCapacity - state->outSize < additional) {
+      newCapacity = state->outCapacity * 2 + additional;
+      newOut = REALLOC_TABLE(state->out, ucharType, state->outCapacity, newCapacity);
+      if (unlikely(newOut == NULL)) {
+        state->memoryError = TRUE;
+        return FALSE;
+      } else {
+        COUNT3_TABLE(ucharType, state->outCapacity, newCapacity);
+        state->out = newOut;
+        state->outCapacity = newCapacity;
+      } /* if */
+    } /* if */
+    return TRUE;
+  } /* ensureOutCapacity */
+
+
+
+/**
+ *  Write 'bitWidth' bits of 'value' in LSB-First order.
+ *  The caller must make sure that at least 4 bytes are available
+ *  in the output buffer.
+ */
+static inline void putBits (deflateStateType *state, uint32Type value,
+    unsigned int bitWidth)
+
+  { /* putBits */
+    state->bitBuffer |= value << state->bitCount;
+    state->bitCount += bitWidth;
+    while (state->bitCount >= 8) {
+      state->out[state->outSize] = (ucharType) (state->bitBuffer & 0xff);
+      state->outSize++;
+      state->bitBuffer >>= 8;
+      state->bitCount -= 8;
+    } /* while */
+  } /* putBits */
+
+
+
+static inline void alignToByte (deflateStateType *state)
+
+  { /* alignToByte */
+    if (state->bitCount != 0) {
+      state->out[state->outSize] = (ucharType) (state->bitBuffer & 0xff);
+      state->outSize++;
+      state->bitBuffer = 0;
+      state->bitCount = 0;
+    } /* if */
+  } /* alignToByte */
+
+
+
+/**
+ *  Compute the code lengths of a minimum redundancy code.
+ *  This is the in-place algorithm of Moffat and Katajainen.
+ *  The elements of 'symFreq' must be sorted by ascending key
+ *  (frequency). Afterwards the key contains the code length.
+ */
+static void calculateMinimumRedundancy (symFreqType *symFreq, int numSymbols)
+
+  {
+    int root;
+    int leaf;
+    int next;
+    int available;
+    int used;
+    uint32Type depth;
+
+  /* calculateMinimumRedundancy */
+    if (numSymbols == 1) {
+      symFreq[0].key = 1;
+    } else if (numSymbols >= 2) {
+      symFreq[0].key += symFreq[1].key;
+      root = 0;
+      leaf = 2;
+      for (next = 1; next < numSymbols - 1; next++) {
+        if (leaf >= numSymbols || symFreq[root].key < symFreq[leaf].key) {
+          symFreq[next].key = symFreq[root].key;
+          symFreq[root].key = (uint32Type) next;
+          root++;
+        } else {
+          symFreq[next].key = symFreq[leaf].key;
+          leaf++;
+        } /* if */
+        if (leaf >= numSymbols ||
+            (root < next && symFreq[root].key < symFreq[leaf].key)) {
+          symFreq[next].key += symFreq[root].key;
+          symFreq[root].key = (uint32Type) next;
+          root++;
+        } else {
+          symFreq[next].key += symFreq[leaf].key;
+          leaf++;
+        } /* if */
+      } /* for */
+      symFreq[numSymbols - 2].key = 0;
+      for (next = numSymbols - 3; next >= 0; next--) {
+        symFreq[next].key = symFreq[symFreq[next].key].key + 1;
+      } /* for */
+      available = 1;
+      used = 0;
+      depth = 0;
+      root = numSymbols - 2;
+      next = numSymbols - 1;
+      while (available > 0) {
+        while (root >= 0 && symFreq[root].key == depth) {
+          used++;
+          root--;
+        } /* while */
+        while (available > used) {
+          symFreq[next].key = depth;
+          next--;
+          available--;
+        } /* while */
+        available = 2 * used;
+        depth++;
+        used = 0;
+      } /* while */
+    } /* if */
+  } /* calculateMinimumRedundancy */
+
+
+
+static int compareSymFreq (const void *elem1, const void *elem2)
+
+  {
+    const symFreqType *symFreq1;
+    const symFreqType *symFreq2;
+
+  /* compareSymFreq */
+    symFreq1 = (const symFreqType *) elem1;
+    symFreq2 = (const symFreqType *) elem2;
+    if (symFreq1->key != symFreq2->key) {
+      return symFreq1->key < symFreq2->key ? -1 : 1;
+    } else {
+      return (int) symFreq1->symbol - (int) symFreq2->symbol;
+    } /* if */
+  } /* compareSymFreq */
+
+
+
+/**
+ *  Assign canonical Huffman codes to the code lengths of 'huffmanCode'.
+ *  The codes are bit reversed, such that they can be written LSB-First.
+ */
+static void assignCanonicalCodes (huffmanCodeType *huffmanCode, int numSymbols,
+    unsigned int maxCodeLength)
+
+  {
+    uint32Type numCodes[DEFLATE_MAX_CODE_LENGTH + 2];
+    uint16Type nextCode[DEFLATE_MAX_CODE_LENGTH + 2];
+    int symbol;
+    unsigned int length;
+    uint16Type code;
+    uint16Type reversed;
+    unsigned int bit;
+
+  /* assignCanonicalCodes */
+    memset(numCodes, 0, sizeof(numCodes));
+    for (symbol = 0; symbol < numSymbols; symbol++) {
+      numCodes[huffmanCode->length[symbol]]++;
+    } /* for */
+    numCodes[0] = 0;
+    code = 0;
+    for (length = 1; length <= maxCodeLength; length++) {
+      code = (uint16Type) ((code + numCodes[length - 1]) << 1);
+      nextCode[length] = code;
+    } /* for */
+    for (symbol = 0; symbol < numSymbols; symbol++) {
+      length = huffmanCode->length[symbol];
+      if (length != 0) {
+        code = nextCode[length];
+        nextCode[length]++;
+        reversed = 0;
+        for (bit = 0; bit < length; bit++) {
+          reversed = (uint16Type) ((reversed << 1) | ((code >> bit) & 1));
+        } /* for */
+        huffmanCode->code[symbol] = reversed;
+      } /* if */
+    } /* for */
+  } /* assignCanonicalCodes */
+
+
+
+/**
+ *  Create a length limited canonical Huffman code for the given frequencies.
+ *  At least two symbols get a code, even if less frequencies are non-zero.
+ */
+static void createHuffmanCode (const uint32Type *freq, int numSymbols,
+    unsigned int maxCodeLength, huffmanCodeType *huffmanCode)
+
+  {
+    symFreqType symFreq[DEFLATE_MAX_SYMBOLS];
+    int numUsed = 0;
+    int symbol;
+    int index;
+    unsigned int length;
+    uint32Type numCodes[DEFLATE_MAX_CODE_LENGTH + 2];
+    uint32Type total;
+
+  /* createHuffmanCode */
+    memset(huffmanCode->length, 0, sizeof(huffmanCode->length));
+    for (symbol = 0; symbol < numSymbols; symbol++) {
+      if (freq[symbol] != 0) {
+        symFreq[numUsed].key = freq[symbol];
+        symFreq[numUsed].symbol = (uint16Type) symbol;
+        numUsed++;
+      } /* if */
+    } /* for */
+    /* Inflate needs at least two codes to be sure that a code is complete. */
+    for (symbol = 0; numUsed < 2 && symbol < numSymbols; symbol++) {
+      if (freq[symbol] == 0) {
+        symFreq[numUsed].key = 1;
+        symFreq[numUsed].symbol = (uint16Type) symbol;
+        numUsed++;
+      } /* if */
+    } /* for */
+    qsort(symFreq, (size_t) numUsed, sizeof(symFreqType), compareSymFreq);
+    calculateMinimumRedundancy(symFreq, numUsed);
+    memset(numCodes, 0, sizeof(numCodes));
+    for (index = 0; index < numUsed; index++) {
+      length = symFreq[index].key;
+      if (length > maxCodeLength) {
+        length = maxCodeLength;
+      } /* if */
+      numCodes[length]++;
+    } /* for */
+    /* Enforce the maximum code length by making the code complete again. */
+    total = 0;
+    for (length = maxCodeLength; length > 0; length--) {
+      total += numCodes[length] << (maxCodeLength - length);
+    } /* for */
+    while (total > ((uint32Type) 1 << maxCodeLength)) {
+      numCodes[maxCodeLength]--;
+      for (length = maxCodeLength - 1; length > 0; length--) {
+        if (numCodes[length] != 0) {
+          numCodes[length]--;
+          numCodes[length + 1] += 2;
+          break;
+        } /* if */
+      } /* for */
+      total--;
+    } /* while */
+    /* The most frequent symbols get the shortest codes. */
+    index = numUsed;
+    for (length = 1; length <= maxCodeLength; length++) {
+      for (total = numCodes[length]; total > 0; total--) {
+        index--;
+        huffmanCode->length[symFreq[index].symbol] = (uint8Type) length;
+      } /* for */
+    } /* for */
+    assignCanonicalCodes(huffmanCode, numSymbols, maxCodeLength);
+  } /* createHuffmanCode */
+
+
+
+static void createFixedHuffmanCodes (huffmanCodeType *litLenCode,
+    huffmanCodeType *distCode)
+
+  {
+    int symbol;
+
+  /* createFixedHuffmanCodes */
+    for (symbol = 0; symbol <= 143; symbol++) {
+      litLenCode->length[symbol] = 8;
+    } /* for */
+    for (; symbol <= 255; symbol++) {
+      litLenCode->length[symbol] = 9;
+    } /* for */
+    for (; symbol <= 279; symbol++) {
+      litLenCode->length[symbol] = 7;
+    } /* for */
+    /* The symbols 286 and 287 never occur in the data, but they */
+    /* are part of the fixed code (RFC 1951 section 3.2.6).       */
+    for (; symbol < DEFLATE_FIXED_LIT_LEN; symbol++) {
+      litLenCode->length[symbol] = 8;
+    } /* for */
+    assignCanonicalCodes(litLenCode, DEFLATE_FIXED_LIT_LEN, DEFLATE_MAX_CODE_LENGTH);
+    for (symbol = 0; symbol < DEFLATE_DIST_CODES; symbol++) {
+      distCode->length[symbol] = 5;
+    } /* for */
+    assignCanonicalCodes(distCode, DEFLATE_DIST_CODES, DEFLATE_MAX_CODE_LENGTH);
+  } /* createFixedHuffmanCodes */
+
+
+
+static void writeHuffmanSymbols (deflateStateType *state,
+    const huffmanCodeType *litLenCode, const huffmanCodeType *distCode)
+
+  {
+    memSizeType index;
+    unsigned int length;
+    unsigned int distance;
+    unsigned int code;
+
+  /* writeHuffmanSymbols */
+    for (index = 0; index < state->numSymbols; index++) {
+      distance = state->symDistance[index];
+      if (distance == 0) {
+        code = state->symLength[index];
+        putBits(state, litLenCode->code[code], litLenCode->length[code]);
+      } else {
+        length = state->symLength[index];
+        code = lengthCodeIndex(length);
+        putBits(state, litLenCode->code[257 + code], litLenCode->length[257 + code]);
+        putBits(state, length - lengthBase[code], lengthExtraBits[code]);
+        code = distanceCode(distance);
+        putBits(state, distCode->code[code], distCode->length[code]);
+        putBits(state, distance - distanceBase[code], distanceExtraBits[code]);
+      } /* if */
+    } /* for */
+    putBits(state, litLenCode->code[DEFLATE_END_OF_BLOCK],
+            litLenCode->length[DEFLATE_END_OF_BLOCK]);
+  } /* writeHuffmanSymbols */
+
+
+
+static memSizeType huffmanDataBits (const deflateStateType *state,
+    const huffmanCodeType *litLenCode, const huffmanCodeType *distCode)
+
+  {
+    int code;
+    memSizeType bits = 0;
+
+  /* huffmanDataBits */
+    for (code = 0; code < DEFLATE_LIT_LEN_CODES; code++) {
+      bits += (memSizeType) state->litLenFreq[code] * litLenCode->length[code];
+    } /* for */
+    for (code = 257; code < DEFLATE_LIT_LEN_CODES; code++) {
+      bits += (memSizeType) state->litLenFreq[code] * lengthExtraBits[code - 257];
+    } /* for */
+    for (code = 0; code < DEFLATE_DIST_CODES; code++) {
+      bits += (memSizeType) state->distFreq[code] *
+              (distCode->length[code] + distanceExtraBits[code]);
+    } /* for */
+    return bits;
+  } /* huffmanDataBits */
+
+
+
+/**
+ *  Run length encode the code lengths of the literal/length and
+ *  distance codes with the code length symbols 0 to 18.
+ *  @return the number of code length symbols.
+ */
+static int encodeCodeLengths (const uint8Type *lengths, int numLengths,
+    uint8Type *rleSymbol, uint8Type *rleExtra)
+
+  {
+    int index = 0;
+    int runLength;
+    int count;
+    int numRle = 0;
+    uint8Type current;
+
+  /* encodeCodeLengths */
+    while (index < numLengths) {
+      current = lengths[index];
+      runLength = 1;
+      while (index + runLength < numLengths && lengths[index + runLength] == current) {
+        runLength++;
+      } /* while */
+      index += runLength;
+      if (current == 0) {
+        while (runLength >= 11) {
+          count = runLength > 138 ? 138 : runLength;
+          rleSymbol[numRle] = 18;
+          rleExtra[numRle++] = (uint8Type) (count - 11);
+          runLength -= count;
+        } /* while */
+        if (runLength >= 3) {
+          rleSymbol[numRle] = 17;
+          rleExtra[numRle++] = (uint8Type) (runLength - 3);
+          runLength = 0;
+        } /* if */
+      } else {
+        rleSymbol[numRle] = current;
+        rleExtra[numRle++] = 0;
+        runLength--;
+        while (runLength >= 3) {
+          count = runLength > 6 ? 6 : runLength;
+          rleSymbol[numRle] = 16;
+          rleExtra[numRle++] = (uint8Type) (count - 3);
+          runLength -= count;
+        } /* while */
+      } /* if */
+      for (; runLength > 0; runLength--) {
+        rleSymbol[numRle] = current;
+        rleExtra[numRle++] = 0;
+      } /* for */
+    } /* while */
+    return numRle;
+  } /* encodeCodeLengths */
+
+
+
+static void writeStoredBlocks (deflateStateType *state, memSizeType start,
+    memSizeType end, boolType last)
+
+  {
+    memSizeType length;
+
+  /* writeStoredBlocks */
+    if (ensureOutCapacity(state, end - start +
+        5 * ((end - start) / DEFLATE_STORED_MAX + 1) + 8)) {
+      do {
+        length = end - start > DEFLATE_STORED_MAX ? DEFLATE_STORED_MAX : end - start;
+        putBits(state, last && start + length == end, 1);
+        putBits(state, 0, 2);
+        alignToByte(state);
+        state->out[state->outSize++] = (ucharType) (length & 0xff);
+        state->out[state->outSize++] = (ucharType) (length >> 8);
+        state->out[state->outSize++] = (ucharType) (~length & 0xff);
+        state->out[state->outSize++] = (ucharType) ((~length >> 8) & 0xff);
+        memcpy(&state->out[state->outSize], &state->data[start], length);
+        state->outSize += length;
+        start += length;
+      } while (start < end);
+    } /* if */
+  } /* writeStoredBlocks */
+
+
+
+/**
+ *  Write the symbols collected since the last block as one block.
+ *  The block type (stored, fixed Huffman or dynamic Huffman)
+ *  which needs the fewest bits is chosen.
+ */
+static void flushBlock (deflateStateType *state, boolType last)
+
+  {
+    huffmanCodeType litLenCode;
+    huffmanCodeType distCode;
+    huffmanCodeType fixedLitLenCode;
+    huffmanCodeType fixedDistCode;
+    huffmanCodeType codeLengthCode;
+    uint8Type lengths[DEFLATE_LIT_LEN_CODES + DEFLATE_DIST_CODES];
+    uint8Type rleSymbol[DEFLATE_LIT_LEN_CODES + DEFLATE_DIST_CODES];
+    uint8Type rleExtra[DEFLATE_LIT_LEN_CODES + DEFLATE_DIST_CODES];
+    uint32Type codeLengthFreq[DEFLATE_CODE_LEN_CODES];
+    int numLitLen;
+    int numDist;
+    int numCodeLen;
+    int numRle;
+    int index;
+    memSizeType storedBytes;
+    memSizeType storedBits;
+    memSizeType fixedBits;
+    memSizeType dynamicBits;
+
+  /* flushBlock */
+    state->litLenFreq[DEFLATE_END_OF_BLOCK] = 1;
+    createHuffmanCode(state->litLenFreq, DEFLATE_LIT_LEN_CODES,
+                      DEFLATE_MAX_CODE_LENGTH, &litLenCode);
+    createHuffmanCode(state->distFreq, DEFLATE_DIST_CODES,
+                      DEFLATE_MAX_CODE_LENGTH, &distCode);
+    createFixedHuffmanCodes(&fixedLitLenCode, &fixedDistCode);
+    numLitLen = DEFLATE_LIT_LEN_CODES;
+    while (numLitLen > 257 && litLenCode.length[numLitLen - 1] == 0) {
+      numLitLen--;
+    } /* while */
+    numDist = DEFLATE_DIST_CODES;
+    while (numDist > 1 && distCode.length[numDist - 1] == 0) {
+      numDist--;
+    } /* while */
+    memcpy(lengths, litLenCode.length, (size_t) numLitLen);
+    memcpy(&lengths[numLitLen], distCode.length, (size_t) numDist);
+    numRle = encodeCodeLengths(lengths, numLitLen + numDist, rleSymbol, rleExtra);
+    memset(codeLengthFreq, 0, sizeof(codeLengthFreq));
+    for (index = 0; index < numRle; index++) {
+      codeLengthFreq[rleSymbol[index]]++;
+    } /* for */
+    createHuffmanCode(codeLengthFreq, DEFLATE_CODE_LEN_CODES,
+                      DEFLATE_MAX_CL_LENGTH, &codeLengthCode);
+    numCodeLen = DEFLATE_CODE_LEN_CODES;
+    while (numCodeLen > 4 &&
+           codeLengthCode.length[codeLengthOrder[numCodeLen - 1]] == 0) {
+      numCodeLen--;
+    } /* while */
+    dynamicBits = 3 + 5 + 5 + 4 + 3 * (memSizeType) numCodeLen;
+    for (index = 0; index < numRle; index++) {
+      dynamicBits += codeLengthCode.length[rleSymbol[index]];
+      dynamicBits += rleSymbol[index] == 16 ? 2 : rleSymbol[index] == 17 ? 3 :
+                     rleSymbol[index] == 18 ? 7 : 0;
+    } /* for */
+    dynamicBits += huffmanDataBits(state, &litLenCode, &distCode);
+    fixedBits = 3 + huffmanDataBits(state, &fixedLitLenCode, &fixedDistCode);
+    storedBytes = state->emittedPos - state->blockStart;
+    storedBits = 8 * (storedBytes + 5 * (storedBytes / DEFLATE_STORED_MAX + 1));
+    if (storedBits <= fixedBits && storedBits <= dynamicBits) {
+      writeStoredBlocks(state, state->blockStart, state->emittedPos, last);
+    } else if (ensureOutCapacity(state, (fixedBits < dynamicBits ?
+                                         fixedBits : dynamicBits) / 8 + 8)) {
+      if (fixedBits <= dynamicBits) {
+        putBits(state, last, 1);
+        putBits(state, 1, 2);
+        writeHuffmanSymbols(state, &fixedLitLenCode, &fixedDistCode);
+      } else {
+        putBits(state, last, 1);
+        putBits(state, 2, 2);
+        putBits(state, (uint32Type) (numLitLen - 257), 5);
+        putBits(state, (uint32Type) (numDist - 1), 5);
+        putBits(state, (uint32Type) (numCodeLen - 4), 4);
+        for (index = 0; index < numCodeLen; index++) {
+          putBits(state, codeLengthCode.length[codeLengthOrder[index]], 3);
+        } /* for */
+        for (index = 0; index < numRle; index++) {
+          putBits(state, codeLengthCode.code[rleSymbol[index]],
+                  codeLengthCode.length[rleSymbol[index]]);
+          if (rleSymbol[index] >= 16) {
+            putBits(state, rleExtra[index], rleSymbol[index] == 16 ? 2 :
+                                            rleSymbol[index] == 17 ? 3 : 7);
+          } /* if */
+        } /* for */
+        writeHuffmanSymbols(state, &litLenCode, &distCode);
+      } /* if */
+    } /* if */
+    memset(state->litLenFreq, 0, sizeof(state->litLenFreq));
+    memset(state->distFreq, 0, sizeof(state->distFreq));
+    state->numSymbols = 0;
+    state->blockStart = state->emittedPos;
+  } /* flushBlock */
+
+
+
+static inline void recordLiteral (deflateStateType *state, ucharType literal)
+
+  { /* recordLiteral */
+    state->symLength[state->numSymbols] = literal;
+    state->symDistance[state->numSymbols] = 0;
+    state->numSymbols++;
+    state->litLenFreq[literal]++;
+    state->emittedPos++;
+    if (state->numSymbols == DEFLATE_BLOCK_SYMBOLS) {
+      flushBlock(state, FALSE);
+    } /* if */
+  } /* recordLiteral */
+
+
+
+static inline void recordMatch (deflateStateType *state, unsigned int length,
+    unsigned int distance)
+
+  { /* recordMatch */
+    state->symLength[state->numSymbols] = (uint16Type) length;
+    state->symDistance[state->numSymbols] = (uint16Type) distance;
+    state->numSymbols++;
+    state->litLenFreq[257 + lengthCodeIndex(length)]++;
+    state->distFreq[distanceCode(distance)]++;
+    state->emittedPos += length;
+    if (state->numSymbols == DEFLATE_BLOCK_SYMBOLS) {
+      flushBlock(state, FALSE);
+    } /* if */
+  } /* recordMatch */
+
+
+
+/**
+ *  Greedy matching used by the levels 1 to 3.
+ *  Substrings of matches longer than maxLazy are not inserted
+ *  into the hash chains.
+ */
+static void deflateFast (deflateStateType *state, memSizeType pos)
+
+  {
+    unsigned int matchLength;
+    memSizeType matchPos = 0;
+    memSizeType end;
+
+  /* deflateFast */
+    while (pos < state->dataLength) {
+      matchLength = 0;
+      if (pos + DEFLATE_MIN_MATCH <= state->dataLength) {
+        matchLength = longestMatch(state, pos, 0, &matchPos);
+        insertString(state, pos);
+        if (matchLength == DEFLATE_MIN_MATCH && pos - matchPos > DEFLATE_TOO_FAR) {
+          matchLength = 0;
+        } /* if */
+      } /* if */
+      if (matchLength >= DEFLATE_MIN_MATCH) {
+        recordMatch(state, matchLength, (unsigned int) (pos - matchPos));
+        end = pos + matchLength;
+        if (matchLength <= state->config->maxLazy) {
+          for (pos++; pos < end; pos++) {
+            insertString(state, pos);
+          } /* for */
+        } /* if */
+        pos = end;
+      } else {
+        recordLiteral(state, state->data[pos]);
+        pos++;
+      } /* if */
+    } /* while */
+  } /* deflateFast */
+
+
+
+/**
+ *  Lazy match evaluation used by the levels 4 to 9.
+ *  A match is only taken, if the match at the next position
+ *  is not longer.
+ */
+static void deflateLazy (deflateStateType *state, memSizeType pos)
+
+  {
+    unsigned int matchLength;
+    unsigned int prevLength = 0;
+    memSizeType matchPos = 0;
+    memSizeType prevMatchPos = 0;
+    boolType matchAvailable = FALSE;
+    memSizeType end;
+
+  /* deflateLazy */
+    while (pos < state->dataLength) {
+      matchLength = 0;
+      if (pos + DEFLATE_MIN_MATCH <= state->dataLength) {
+        if (prevLength < state->config->maxLazy) {
+          matchLength = longestMatch(state, pos, prevLength, &matchPos);
+          if (matchLength == prevLength) {
+            matchLength = 0;
+          } /* if */
+        } /* if */
+        insertString(state, pos);
+        if (matchLength == DEFLATE_MIN_MATCH && pos - matchPos > DEFLATE_TOO_FAR) {
+          matchLength = 0;
+        } /* if */
+      } /* if */
+      if (prevLength >= DEFLATE_MIN_MATCH && matchLength <= prevLength) {
+        recordMatch(state, prevLength, (unsigned int) (pos - 1 - prevMatchPos));
+        end = pos - 1 + prevLength;
+        for (pos++; pos < end; pos++) {
+          insertString(state, pos);
+        } /* for */
+        prevLength = 0;
+        matchAvailable = FALSE;
+      } else {
+        if (matchAvailable) {
+          recordLiteral(state, state->data[pos - 1]);
+        } /* if */
+        matchAvailable = TRUE;
+        prevLength = matchLength;
+        prevMatchPos = matchPos;
+        pos++;
+      } /* if */
+    } /* while */
+    if (matchAvailable) {
+      if (prevLength >= DEFLATE_MIN_MATCH) {
+        recordMatch(state, prevLength, (unsigned int) (pos - 1 - prevMatchPos));
+      } else {
+        recordLiteral(state, state->data[pos - 1]);
+      } /* if */
+    } /* if */
+  } /* deflateLazy */
+
+
+
+/**
+ *  Compress a string with the DEFLATE algorithm (RFC 1951).
+ *  The string 'window' contains data that has already been compressed
+ *  and precedes 'uncompressed'. Matches may refer to the last 32768
+ *  characters of 'window'. This allows compressing a big stream in
+ *  chunks. If 'bfinal' is FALSE the result is padded to a byte boundary
+ *  with an empty stored block, such that the results of several calls
+ *  can be concatenated.
+ *  @param window Previously compressed data (only the last 32768
+ *         characters are used).
+ *  @param uncompressed Data to be compressed.
+ *  @param level Compression level from 0 (store only) to 9 (best).
+ *  @param bfinal TRUE if the last block of the stream should be written.
+ *  @return the compressed data as string of bytes.
+ *  @exception RANGE_ERROR If 'level' is not in the range 0 to 9 or
+ *             if a character in 'window' or 'uncompressed' is
+ *             beyond '\255;'.
+ *  @exception MEMORY_ERROR Not enough memory to compress the data.
+ */
+striType cmpDeflate (const const_striType window, const const_striType uncompressed,
+    intType level, boolType bfinal)
+
+  {
+    memSizeType windowLength;
+    ustriType data = NULL;
+    deflateStateType state;
+    memSizeType pos;
+    striType result;
+
+  /* cmpDeflate */
+    logFunction(printf("cmpDeflate(\"%s\", ",
+                       striAsUnquotedCStri(window));
+                printf("\"%s\", " FMT_D ", %d)\n",
+                       striAsUnquotedCStri(uncompressed), level, bfinal););
+    windowLength = window->size > DEFLATE_WINDOW_SIZE ?
+                   DEFLATE_WINDOW_SIZE : window->size;
+    memset(&state, 0, sizeof(deflateStateType));
+    if (unlikely(level < 0 || level > 9)) {
+      logError(printf("cmpDeflate: Level " FMT_D " not in range 0 to 9.\n",
+                      level););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if (unlikely(uncompressed->size > MAX_MEMSIZETYPE - windowLength ||
+                        !ALLOC_UBYTES(data, windowLength + uncompressed->size + 1))) {
+      raise_error(MEMORY_ERROR);
+      result = NULL;
+    } else if (unlikely(memcpy_from_strelem(data,
+                            &window->mem[window->size - windowLength],
+                            windowLength) ||
+                        memcpy_from_strelem(&data[windowLength],
+                            uncompressed->mem, uncompressed->size))) {
+      FREE_BYTES(data, windowLength + uncompressed->size + 1);
+      logError(printf("cmpDeflate: Character beyond '\\255;' in data.\n"););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      state.config = &deflateConfig[level];
+      state.data = data;
+      state.dataLength = windowLength + uncompressed->size;
+      state.blockStart = windowLength;
+      state.emittedPos = windowLength;
+      state.outCapacity = uncompressed->size / 4 + 1024;
+      if (unlikely(!ALLOC_TABLE(state.head, memSizeType, DEFLATE_HASH_SIZE) ||
+                   !ALLOC_TABLE(state.prev, memSizeType, DEFLATE_WINDOW_SIZE) ||
+                   !ALLOC_TABLE(state.symLength, uint16Type, DEFLATE_BLOCK_SYMBOLS) ||
+                   !ALLOC_TABLE(state.symDistance, uint16Type, DEFLATE_BLOCK_SYMBOLS) ||
+                   !ALLOC_TABLE(state.out, ucharType, state.outCapacity))) {
+        state.memoryError = TRUE;
+      } else if (level == 0) {
+        if (uncompressed->size != 0 || bfinal) {
+          writeStoredBlocks(&state, windowLength, state.dataLength, bfinal);
+        } /* if */
+      } else {
+        memset(state.head, 0, DEFLATE_HASH_SIZE * sizeof(memSizeType));
+        memset(state.prev, 0, DEFLATE_WINDOW_SIZE * sizeof(memSizeType));
+        for (pos = 0; pos < windowLength; pos++) {
+          insertString(&state, pos);
+        } /* for */
+        if (state.config->lazy) {
+          deflateLazy(&state, windowLength);
+        } else {
+          deflateFast(&state, windowLength);
+        } /* if */
+        if (state.numSymbols != 0 || bfinal) {
+          flushBlock(&state, bfinal);
+        } /* if */
+      } /* if */
+      if (!state.memoryError && ensureOutCapacity(&state, 8)) {
+        if (!bfinal && state.bitCount != 0) {
+          /* Sync flush: An empty stored block aligns to a byte boundary. */
+          writeStoredBlocks(&state, state.dataLength, state.dataLength, FALSE);
+        } else {
+          alignToByte(&state);
+        } /* if */
+      } /* if */
+      if (unlikely(state.memoryError ||
+                   !ALLOC_STRI_CHECK_SIZE(result, state.outSize))) {
+        raise_error(MEMORY_ERROR);
+        result = NULL;
+      } else {
+        result->size = state.outSize;
+        memcpy_to_strelem(result->mem, state.out, state.outSize);
+      } /* if */
+      if (state.head != NULL) {
+        FREE_TABLE(state.head, memSizeType, DEFLATE_HASH_SIZE);
+      } /* if */
+      if (state.prev != NULL) {
+        FREE_TABLE(state.prev, memSizeType, DEFLATE_WINDOW_SIZE);
+      } /* if */
+      if (state.symLength != NULL) {
+        FREE_TABLE(state.symLength, uint16Type, DEFLATE_BLOCK_SYMBOLS);
+      } /* if */
+      if (state.symDistance != NULL) {
+        FREE_TABLE(state.symDistance, uint16Type, DEFLATE_BLOCK_SYMBOLS);
+      } /* if */
+      if (state.out != NULL) {
+        FREE_TABLE(state.out, ucharType, state.outCapacity);
+      } /* if */
+      FREE_BYTES(data, windowLength + uncompressed->size + 1);
+    } /* if */
+    logFunction(printf("cmpDeflate --> \"%s\"\n",
+                       striAsUnquotedCStri(result)););
+    return result;
+  } /* cmpDeflate */
+
+
+
+#define ZSTD_BLOCK_SIZE_MAX     131072
+#define ZSTD_HUF_LOG_MAX        11
+#define ZSTD_HUF_WEIGHTS_MAX    255
+#define ZSTD_HUF_FSE_LOG_MAX    6
+#define ZSTD_LL_LOG_MAX         9
+#define ZSTD_OF_LOG_MAX         8
+#define ZSTD_ML_LOG_MAX         9
+#define ZSTD_LL_SYMBOL_MAX      35
+#define ZSTD_OF_SYMBOL_MAX      31
+#define ZSTD_ML_SYMBOL_MAX      52
+#define ZSTD_READ_BITS_MAX      25
+
+/* Layout of the state string used by cmpZstdDecodeBlock(). */
+#define ZSTD_STATE_REP          0
+#define ZSTD_STATE_HUF_LOG      3
+#define ZSTD_STATE_LL_LOG       4
+#define ZSTD_STATE_OF_LOG       5
+#define ZSTD_STATE_ML_LOG       6
+#define ZSTD_STATE_HUF_TABLE    8
+#define ZSTD_STATE_LL_TABLE     (ZSTD_STATE_HUF_TABLE + (1 << ZSTD_HUF_LOG_MAX))
+#define ZSTD_STATE_OF_TABLE     (ZSTD_STATE_LL_TABLE + (1 << ZSTD_LL_LOG_MAX))
+#define ZSTD_STATE_ML_TABLE     (ZSTD_STATE_OF_TABLE + (1 << ZSTD_OF_LOG_MAX))
+#define ZSTD_STATE_SIZE         (ZSTD_STATE_ML_TABLE + (1 << ZSTD_ML_LOG_MAX))
+
+/* An FSE table entry contains symbol, number of bits and baseline. */
+#define FSE_ENTRY(sym,bits,base) ((strElemType) (sym) | \
+                                  (strElemType) (bits) << 8 | \
+                                  (strElemType) (base) << 16)
+#define FSE_SYMBOL(entry)        ((entry) & 0xff)
+#define FSE_NUM_BITS(entry)      (((entry) >> 8) & 0xff)
+#define FSE_BASELINE(entry)      ((entry) >> 16)
+
+static const uint32Type zstdLiteralLengthBase[] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    16, 18, 20, 22, 24, 28, 32, 40, 48, 64, 128, 256, 512, 1024,
+    2048, 4096, 8192, 16384, 32768, 65536};
+
+static const uint8Type zstdLiteralLengthBits[] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 2, 2, 3, 3, 4, 6, 7, 8, 9, 10,
+    11, 12, 13, 14, 15, 16};
+
+static const uint32Type zstdMatchLengthBase[] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18,
+    19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34,
+    35, 37, 39, 41, 43, 47, 51, 59, 67, 83, 99, 131, 259, 515,
+    1027, 2051, 4099, 8195, 16387, 32771, 65539};
+
+static const uint8Type zstdMatchLengthBits[] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 2, 2, 3, 3, 4, 4, 5, 7, 8, 9,
+    10, 11, 12, 13, 14, 15, 16};
+
+/* Predefined distributions from RFC 8878. */
+static const int zstdDefaultLiteralLengthNorm[] = {
+    4, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 2, 1, 1, 1, 1, 1,
+    -1, -1, -1, -1};
+
+static const int zstdDefaultMatchLengthNorm[] = {
+    1, 4, 3, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, -1, -1,
+    -1, -1, -1, -1, -1};
+
+static const int zstdDefaultOffsetNorm[] = {
+    1, 1, 1, 1, 1, 1, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, -1, -1, -1, -1, -1};
+
+typedef struct {
+    const_ustriType data;
+    memSizeType bitPos;  /* Number of bits that have not been read. */
+    boolType overflow;
+  } backwardBitStreamType;
+
+
+
+/**
+ *  Get 'numBits' bits (at most 25) starting at bit position 'bitPos'.
+ *  Bytes beyond 'size' are considered to be zero.
+ */
+static inline uint32Type extractBits (const_ustriType data, memSizeType size,
+    memSizeType bitPos, unsigned int numBits)
+
+  {
+    memSizeType index;
+    uint32Type word;
+
+  /* extractBits */
+    index = bitPos >> 3;
+    if (likely(index + 4 <= size)) {
+      word = (uint32Type) data[index] |
+             (uint32Type) data[index + 1] << 8 |
+             (uint32Type) data[index + 2] << 16 |
+             (uint32Type) data[index + 3] << 24;
+    } else {
+      word = 0;
+      for (; index < size && index < (bitPos >> 3) + 4; index++) {
+        word |= (uint32Type) data[index] << (8 * (index - (bitPos >> 3)));
+      } /* for */
+    } /* if */
+    return (word >> (bitPos & 7)) & ((((uint32Type) 1) << numBits) - 1);
+  } /* extractBits */
+
+
+
+/**
+ *  Initialize a bit stream which is read backward from the end.
+ *  The highest set bit of the last byte marks the start of the stream.
+ *  @return FALSE if the last byte is zero or the stream is empty.
+ */
+static boolType initBackwardBitStream (backwardBitStreamType *stream,
+    const_ustriType data, memSizeType size)
+
+  {
+    boolType okay;
+
+  /* initBackwardBitStream */
+    stream->data = data;
+    stream->overflow = FALSE;
+    if (unlikely(size == 0 || data[size - 1] == 0)) {
+      stream->bitPos = 0;
+      okay = FALSE;
+    } else {
+      stream->bitPos = (size - 1) * 8 +
+          (memSizeType) uint32MostSignificantBit(data[size - 1]);
+      okay = TRUE;
+    } /* if */
+    return okay;
+  } /* initBackwardBitStream */
+
+
+
+/**
+ *  Get 'numBits' bits (at most 25) without consuming them.
+ *  If the stream contains fewer bits they are padded with zero bits.
+ */
+static inline uint32Type peekBitsBackward (const backwardBitStreamType *stream,
+    unsigned int numBits)
+
+  {
+    uint32Type bits;
+
+  /* peekBitsBackward */
+    if (likely(numBits <= stream->bitPos)) {
+      bits = extractBits(stream->data, (stream->bitPos + 7) >> 3,
+                         stream->bitPos - numBits, numBits);
+    } else if (stream->bitPos == 0) {
+      bits = 0;
+    } else {
+      bits = extractBits(stream->data, (stream->bitPos + 7) >> 3,
+                         0, (unsigned int) stream->bitPos) <<
+             (numBits - stream->bitPos);
+    } /* if */
+    return bits;
+  } /* peekBitsBackward */
+
+
+
+static inline void skipBitsBackward (backwardBitStreamType *stream,
+    unsigned int numBits)
+
+  { /* skipBitsBackward */
+    if (likely(numBits <= stream->bitPos)) {
+      stream->bitPos -= numBits;
+    } else {
+      stream->bitPos = 0;
+      stream->overflow = TRUE;
+    } /* if */
+  } /* skipBitsBackward */
+
+
+
+static inline uint32Type readBitsBackward (backwardBitStreamType *stream,
+    unsigned int numBits)
+
+  {
+    uint32Type bits;
+
+  /* readBitsBackward */
+    if (numBits == 0) {
+      bits = 0;
+    } else {
+      bits = peekBitsBackward(stream, numBits);
+      skipBitsBackward(stream, numBits);
+    } /* if */
+    return bits;
+  } /* readBitsBackward */
+
+
+
+/**
+ *  Read an FSE table description (normalized symbol counts).
+ *  @return the number of bytes used by the description or 0 if
+ *          the description is corrupt.
+ */
+static memSizeType readFseDistribution (const_ustriType data, memSizeType size,
+    unsigned int maxSymbol, unsigned int maxLog, int *norm,
+    unsigned int *accuracyLog)
+
+  {
+    memSizeType bitPos;
+    int remaining;
+    int threshold;
+    unsigned int numBits;
+    unsigned int symbol = 0;
+    unsigned int zeroEnd;
+    unsigned int repeat;
+    int max;
+    int count;
+    uint32Type value;
+    boolType previousZero = FALSE;
+    boolType okay = TRUE;
+
+  /* readFseDistribution */
+    *accuracyLog = (unsigned int) extractBits(data, size, 0, 4) + 5;
+    if (*accuracyLog > maxLog) {
+      return 0;
+    } /* if */
+    bitPos = 4;
+    remaining = (1 << *accuracyLog) + 1;
+    threshold = 1 << *accuracyLog;
+    numBits = *accuracyLog + 1;
+    while (okay && remaining > 1 && symbol <= maxSymbol) {
+      if (previousZero) {
+        zeroEnd = symbol;
+        while (extractBits(data, size, bitPos, 16) == 0xffff &&
+               bitPos <= size * 8) {
+          zeroEnd += 24;
+          bitPos += 16;
+        } /* while */
+        while ((repeat = (unsigned int) extractBits(data, size, bitPos, 2)) == 3) {
+          zeroEnd += 3;
+          bitPos += 2;
+        } /* while */
+        zeroEnd += repeat;
+        bitPos += 2;
+        if (zeroEnd > maxSymbol + 1) {
+          okay = FALSE;
+        } else {
+          while (symbol < zeroEnd) {
+            norm[symbol++] = 0;
+          } /* while */
+        } /* if */
+      } /* if */
+      if (okay && symbol <= maxSymbol) {
+        max = (2 * threshold - 1) - remaining;
+        value = extractBits(data, size, bitPos, numBits);
+        if ((int) (value & (uint32Type) (threshold - 1)) < max) {
+          count = (int) (value & (uint32Type) (threshold - 1));
+          bitPos += numBits - 1;
+        } else {
+          count = (int) (value & (uint32Type) (2 * threshold - 1));
+          if (count >= threshold) {
+            count -= max;
+          } /* if */
+          bitPos += numBits;
+        } /* if */
+        count--;
+        remaining -= count < 0 ? -count : count;
+        norm[symbol++] = count;
+        previousZero = count == 0;
+        while (remaining < threshold && threshold > 1) {
+          numBits--;
+          threshold >>= 1;
+        } /* while */
+      } /* if */
+    } /* while */
+    if (!okay || remaining != 1 || bitPos > size * 8) {
+      return 0;
+    } /* if */
+    while (symbol <= maxSymbol) {
+      norm[symbol++] = 0;
+    } /* while */
+    return (bitPos + 7) >> 3;
+  } /* readFseDistribution */
+
+
+
+/**
+ *  Build an FSE decoding table from normalized symbol counts.
+ *  @return FALSE if the counts do not describe a valid table.
+ */
+static boolType buildFseTable (const int *norm, unsigned int maxSymbol,
+    unsigned int accuracyLog, strElemType *table)
+
+  {
+    unsigned int tableSize;
+    unsigned int highThreshold;
+    unsigned int step;
+    unsigned int position = 0;
+    unsigned int symbol;
+    unsigned int index;
+    unsigned int nextState;
+    unsigned int numBits;
+    uint32Type symbolNext[256];
+
+  /* buildFseTable */
+    tableSize = 1U << accuracyLog;
+    highThreshold = tableSize - 1;
+    for (symbol = 0; symbol <= maxSymbol; symbol++) {
+      if (norm[symbol] == -1) {
+        table[highThreshold--] = symbol;
+        symbolNext[symbol] = 1;
+      } else {
+        symbolNext[symbol] = (uint32Type) norm[symbol];
+      } /* if */
+    } /* for */
+    step = (tableSize >> 1) + (tableSize >> 3) + 3;
+    for (symbol = 0; symbol <= maxSymbol; symbol++) {
+      for (index = 0; (int) index < norm[symbol]; index++) {
+        table[position] = symbol;
+        do {
+          position = (position + step) & (tableSize - 1);
+        } while (position > highThreshold);
+      } /* for */
+    } /* for */
+    if (position != 0) {
+      return FALSE;
+    } /* if */
+    for (index = 0; index < tableSize; index++) {
+      symbol = table[index];
+      nextState = symbolNext[symbol]++;
+      numBits = accuracyLog - (unsigned int) uint32MostSignificantBit(nextState);
+      table[index] = FSE_ENTRY(symbol, numBits, (nextState << numBits) - tableSize);
+    } /* for */
+    return TRUE;
+  } /* buildFseTable */
+
+
+
+/**
+ *  Read the Huffman tree description of a compressed literals section.
+ *  The decoding table is stored in the state.
+ *  @return the number of bytes used by the description or 0 if
+ *          the description is corrupt.
+ */
+static memSizeType readHuffmanTree (const_ustriType data, memSizeType size,
+    strElemType *state)
+
+  {
+    unsigned int headerByte;
+    uint8Type weights[ZSTD_HUF_WEIGHTS_MAX + 1];
+    unsigned int numWeights = 0;
+    int norm[ZSTD_HUF_LOG_MAX + 2];
+    unsigned int accuracyLog;
+    strElemType fseTable[1 << ZSTD_HUF_FSE_LOG_MAX];
+    memSizeType descriptionSize;
+    backwardBitStreamType stream;
+    strElemType state1;
+    strElemType state2;
+    uint32Type total = 0;
+    uint32Type rest;
+    unsigned int maxBits;
+    unsigned int symbol;
+    unsigned int weight;
+    unsigned int position = 0;
+    strElemType entry;
+    strElemType *table;
+    unsigned int index;
+
+  /* readHuffmanTree */
+    if (size == 0) {
+      return 0;
+    } /* if */
+    headerByte = data[0];
+    if (headerByte >= 128) {
+      numWeights = headerByte - 127;
+      if ((numWeights + 1) / 2 + 1 > size) {
+        return 0;
+      } /* if */
+      for (index = 0; index < numWeights; index++) {
+        weights[index] = (uint8Type) (index & 1 ? data[1 + index / 2] & 0xf :
+                                                  data[1 + index / 2] >> 4);
+      } /* for */
+      descriptionSize = (numWeights + 1) / 2 + 1;
+    } else {
+      if (headerByte + 1 > size) {
+        return 0;
+      } /* if */
+      descriptionSize = readFseDistribution(&data[1], headerByte,
+          ZSTD_HUF_LOG_MAX + 1, ZSTD_HUF_FSE_LOG_MAX, norm, &accuracyLog);
+      if (descriptionSize == 0 ||
+          !buildFseTable(norm, ZSTD_HUF_LOG_MAX + 1, accuracyLog, fseTable) ||
+          !initBackwardBitStream(&stream, &data[1 + descriptionSize],
+                                 headerByte - descriptionSize)) {
+        return 0;
+      } /* if */
+      state1 = readBitsBackward(&stream, accuracyLog);
+      state2 = readBitsBackward(&stream, accuracyLog);
+      if (stream.overflow) {
+        return 0;
+      } /* if */
+      /* Two interleaved states decode the weights until the stream ends. */
+      for (;;) {
+        if (numWeights >= ZSTD_HUF_WEIGHTS_MAX) {
+          return 0;
+        } /* if */
+        entry = fseTable[state1];
+        weights[numWeights++] = (uint8Type) FSE_SYMBOL(entry);
+        state1 = FSE_BASELINE(entry) + readBitsBackward(&stream, FSE_NUM_BITS(entry));
+        if (stream.overflow) {
+          weights[numWeights++] = (uint8Type) FSE_SYMBOL(fseTable[state2]);
+          break;
+        } /* if */
+        if (numWeights >= ZSTD_HUF_WEIGHTS_MAX) {
+          return 0;
+        } /* if */
+        entry = fseTable[state2];
+        weights[numWeights++] = (uint8Type) FSE_SYMBOL(entry);
+        state2 = FSE_BASELINE(entry) + readBitsBackward(&stream, FSE_NUM_BITS(entry));
+        if (stream.overflow) {
+          weights[numWeights++] = (uint8Type) FSE_SYMBOL(fseTable[state1]);
+          break;
+        } /* if */
+      } /* for */
+      if (numWeights > ZSTD_HUF_WEIGHTS_MAX) {
+        return 0;
+      } /* if */
+      descriptionSize = headerByte + 1;
+    } /* if */
+    for (index = 0; index < numWeights; index++) {
+      if (weights[index] > ZSTD_HUF_LOG_MAX) {
+        return 0;
+      } else if (weights[index] != 0) {
+        total += ((uint32Type) 1) << (weights[index] - 1);
+      } /* if */
+    } /* for */
+    if (total == 0) {
+      return 0;
+    } /* if */
+    maxBits = (unsigned int) uint32MostSignificantBit(total) + 1;
+    rest = (((uint32Type) 1) << maxBits) - total;
+    if (maxBits > ZSTD_HUF_LOG_MAX || (rest & (rest - 1)) != 0) {
+      return 0;
+    } /* if */
+    /* The weight of the last symbol is implied. */
+    weights[numWeights++] = (uint8Type) (uint32MostSignificantBit(rest) + 1);
+    table = &state[ZSTD_STATE_HUF_TABLE];
+    for (weight = 1; weight <= maxBits; weight++) {
+      for (symbol = 0; symbol < numWeights; symbol++) {
+        if (weights[symbol] == weight) {
+          entry = (strElemType) symbol | (strElemType) (maxBits + 1 - weight) << 8;
+          for (index = 0; index < 1U << (weight - 1); index++) {
+            table[position++] = entry;
+          } /* for */
+        } /* if */
+      } /* for */
+    } /* for */
+    state[ZSTD_STATE_HUF_LOG] = maxBits;
+    return descriptionSize;
+  } /* readHuffmanTree */
+
+
+
+/**
+ *  Decode one Huffman coded stream of literals.
+ *  @return FALSE if the stream is corrupt.
+ */
+static boolType decodeHuffmanStream (const_ustriType data, memSizeType size,
+    const strElemType *state, ucharType *literals, memSizeType numLiterals)
+
+  {
+    backwardBitStreamType stream;
+    unsigned int maxBits;
+    const strElemType *table;
+    strElemType entry;
+    memSizeType index;
+
+  /* decodeHuffmanStream */
+    if (!initBackwardBitStream(&stream, data, size)) {
+      return FALSE;
+    } /* if */
+    maxBits = state[ZSTD_STATE_HUF_LOG];
+    table = &state[ZSTD_STATE_HUF_TABLE];
+    for (index = 0; index < numLiterals; index++) {
+      entry = table[peekBitsBackward(&stream, maxBits)];
+      literals[index] = (ucharType) (entry & 0xff);
+      skipBitsBackward(&stream, (unsigned int) (entry >> 8));
+    } /* for */
+    return stream.bitPos == 0 && !stream.overflow;
+  } /* decodeHuffmanStream */
+
+
+
+/**
+ *  Decode the literals section of a compressed block.
+ *  @param literals Buffer for ZSTD_BLOCK_SIZE_MAX decoded literals.
+ *  @return the size of the literals section or 0 if it is corrupt.
+ */
+static memSizeType decodeLiterals (const_ustriType block, memSizeType size,
+    strElemType *state, ucharType *literals, const_ustriType *literalsStart,
+    memSizeType *numLiterals)
+
+  {
+    unsigned int literalsType;
+    unsigned int sizeFormat;
+    memSizeType headerSize;
+    memSizeType regeneratedSize;
+    memSizeType compressedSize = 0;
+    uint32Type header;
+    memSizeType treeSize = 0;
+    memSizeType streamSize[4];
+    memSizeType segmentSize;
+    const_ustriType stream;
+    int numStreams;
+    int index;
+
+  /* decodeLiterals */
+    if (size < 1) {
+      return 0;
+    } /* if */
+    literalsType = block[0] & 3;
+    sizeFormat = (block[0] >> 2) & 3;
+    header = extractBits(block, size, 0, 16) |
+             extractBits(block, size, 16, 16) << 16;
+    if (literalsType <= 1) {
+      if ((sizeFormat & 1) == 0) {
+        headerSize = 1;
+        regeneratedSize = block[0] >> 3;
+      } else if (sizeFormat == 1) {
+        headerSize = 2;
+        regeneratedSize = (header >> 4) & 0xfff;
+      } else {
+        headerSize = 3;
+        regeneratedSize = (header >> 4) & 0xfffff;
+      } /* if */
+      if (regeneratedSize > ZSTD_BLOCK_SIZE_MAX || headerSize + 1 > size) {
+        return 0;
+      } else if (literalsType == 0) {
+        if (headerSize + regeneratedSize > size) {
+          return 0;
+        } /* if */
+        *literalsStart = &block[headerSize];
+        *numLiterals = regeneratedSize;
+        return headerSize + regeneratedSize;
+      } else {
+        memset(literals, block[headerSize], regeneratedSize);
+        *literalsStart = literals;
+        *numLiterals = regeneratedSize;
+        return headerSize + 1;
+      } /* if */
+    } else {
+      if (sizeFormat <= 1) {
+        headerSize = 3;
+        regeneratedSize = (header >> 4) & 0x3ff;
+        compressedSize = (header >> 14) & 0x3ff;
+      } else if (sizeFormat == 2) {
+        headerSize = 4;
+        regeneratedSize = (header >> 4) & 0x3fff;
+        compressedSize = header >> 18;
+      } else {
+        headerSize = 5;
+        if (size < 5) {
+          return 0;
+        } /* if */
+        regeneratedSize = (header >> 4) & 0x3ffff;
+        compressedSize = (header >> 22) | (memSizeType) block[4] << 10;
+      } /* if */
+      numStreams = sizeFormat == 0 ? 1 : 4;
+      if (regeneratedSize > ZSTD_BLOCK_SIZE_MAX ||
+          headerSize + compressedSize > size) {
+        return 0;
+      } /* if */
+      block += headerSize;
+      if (literalsType == 2) {
+        treeSize = readHuffmanTree(block, compressedSize, state);
+        if (treeSize == 0) {
+          return 0;
+        } /* if */
+      } else if (state[ZSTD_STATE_HUF_LOG] == 0) {
+        return 0;
+      } /* if */
+      stream = &block[treeSize];
+      if (numStreams == 1) {
+        if (!decodeHuffmanStream(stream, compressedSize - treeSize,
+                                 state, literals, regeneratedSize)) {
+          return 0;
+        } /* if */
+      } else {
+        if (compressedSize - treeSize < 6) {
+          return 0;
+        } /* if */
+        streamSize[0] = (memSizeType) stream[0] | (memSizeType) stream[1] << 8;
+        streamSize[1] = (memSizeType) stream[2] | (memSizeType) stream[3] << 8;
+        streamSize[2] = (memSizeType) stream[4] | (memSizeType) stream[5] << 8;
+        if (streamSize[0] + streamSize[1] + streamSize[2] >
+            compressedSize - treeSize - 6) {
+          return 0;
+        } /* if */
+        streamSize[3] = compressedSize - treeSize - 6 -
+                        streamSize[0] - streamSize[1] - streamSize[2];
+        segmentSize = (regeneratedSize + 3) / 4;
+        if (3 * segmentSize > regeneratedSize) {
+          return 0;
+        } /* if */
+        stream += 6;
+        for (index = 0; index < 4; index++) {
+          if (!decodeHuffmanStream(stream, streamSize[index], state,
+                                   &literals[(memSizeType) index * segmentSize],
+                                   index == 3 ? regeneratedSize - 3 * segmentSize :
+                                                segmentSize)) {
+            return 0;
+          } /* if */
+          stream += streamSize[index];
+        } /* for */
+      } /* if */
+      *literalsStart = literals;
+      *numLiterals = regeneratedSize;
+      return headerSize + compressedSize;
+    } /* if */
+  } /* decodeLiterals */
+
+
+
+/**
+ *  Set up the FSE table of one sequence symbol type.
+ *  @return the number of bytes used or -1 if the data is corrupt.
+ */
+static int readSequenceTable (unsigned int mode, const_ustriType data,
+    memSizeType size, const int *defaultNorm, unsigned int defaultMaxSymbol,
+    unsigned int defaultLog, unsigned int maxSymbol, unsigned int maxLog,
+    strElemType *state, unsigned int logIndex, unsigned int tableIndex)
+
+  {
+    int norm[ZSTD_ML_SYMBOL_MAX + 1];
+    unsigned int accuracyLog;
+    memSizeType descriptionSize;
+    int used = 0;
+
+  /* readSequenceTable */
+    switch (mode) {
+      case 0:
+        if (!buildFseTable(defaultNorm, defaultMaxSymbol, defaultLog,
+                           &state[tableIndex])) {
+          return -1;
+        } /* if */
+        state[logIndex] = defaultLog + 1;
+        break;
+      case 1:
+        if (size < 1 || data[0] > maxSymbol) {
+          return -1;
+        } /* if */
+        state[tableIndex] = FSE_ENTRY(data[0], 0, 0);
+        state[logIndex] = 1;
+        used = 1;
+        break;
+      case 2:
+        descriptionSize = readFseDistribution(data, size, maxSymbol, maxLog,
+                                              norm, &accuracyLog);
+        if (descriptionSize == 0 ||
+            !buildFseTable(norm, maxSymbol, accuracyLog, &state[tableIndex])) {
+          return -1;
+        } /* if */
+        state[logIndex] = accuracyLog + 1;
+        used = (int) descriptionSize;
+        break;
+      default:
+        if (state[logIndex] == 0) {
+          return -1;
+        } /* if */
+        break;
+    } /* switch */
+    return used;
+  } /* readSequenceTable */
+
+
+
+/**
+ *  Make sure that a string has room for 'length' characters.
+ *  Afterwards the size must be set with setReservedSize().
+ */
+static boolType reserveOutput (striType *const stri, memSizeType length)
+
+  {
+    striType newStri;
+
+  /* reserveOutput */
+#if WITH_STRI_CAPACITY
+    if (length > (*stri)->capacity) {
+      newStri = growStri(*stri, length);
+      if (unlikely(newStri == NULL)) {
+        return FALSE;
+      } /* if */
+      *stri = newStri;
+    } /* if */
+#else
+    if (length > (*stri)->size) {
+      REALLOC_STRI_CHECK_SIZE2(newStri, *stri, (*stri)->size, length);
+      if (unlikely(newStri == NULL)) {
+        return FALSE;
+      } /* if */
+      *stri = newStri;
+      (*stri)->size = length;
+    } /* if */
+#endif
+    return TRUE;
+  } /* reserveOutput */
+
+
+
+/**
+ *  Set the size of a string that has been enlarged with reserveOutput()
+ *  or whose end is not used any more.
+ */
+static void setReservedSize (striType *const stri, memSizeType length)
+
+  {
+#if !WITH_STRI_CAPACITY
+    striType newStri;
+#endif
+
+  /* setReservedSize */
+#if !WITH_STRI_CAPACITY
+    if (length < (*stri)->size) {
+      REALLOC_STRI_SIZE_SMALLER2(newStri, *stri, (*stri)->size, length);
+      if (newStri != NULL) {
+        *stri = newStri;
+      } /* if */
+    } /* if */
+#endif
+    (*stri)->size = length;
+  } /* setReservedSize */
+
+
+
+/**
+ *  Decode the sequences section of a compressed block and execute
+ *  the sequences. The result is appended to 'out' and 'outSize'
+ *  is advanced accordingly. Offsets beyond 'windowSize' are corrupt.
+ *  @return FALSE if the data is corrupt.
+ */
+static boolType executeSequences (const_ustriType data, memSizeType size,
+    strElemType *state, const_ustriType literals, memSizeType numLiterals,
+    strElemType *out, memSizeType *outSize, memSizeType outLimit,
+    memSizeType windowSize)
+
+  {
+    memSizeType numSequences;
+    unsigned int modes;
+    int used;
+    backwardBitStreamType stream;
+    const strElemType *llTable;
+    const strElemType *ofTable;
+    const strElemType *mlTable;
+    strElemType llState;
+    strElemType ofState;
+    strElemType mlState;
+    strElemType llEntry;
+    strElemType ofEntry;
+    strElemType mlEntry;
+    unsigned int llCode;
+    unsigned int ofCode;
+    unsigned int mlCode;
+    uint32Type literalLength;
+    uint32Type matchLength;
+    uint32Type offset;
+    uint32Type offsetValue;
+    memSizeType outPos;
+    memSizeType literalPos = 0;
+    memSizeType index;
+    memSizeType sequence;
+    strElemType *rep;
+
+  /* executeSequences */
+    outPos = *outSize;
+    if (size < 1) {
+      return FALSE;
+    } else if (data[0] < 128) {
+      numSequences = data[0];
+      data++;
+      size--;
+    } else if (data[0] < 255) {
+      if (size < 2) {
+        return FALSE;
+      } /* if */
+      numSequences = ((memSizeType) (data[0] - 128) << 8) + data[1];
+      data += 2;
+      size -= 2;
+    } else {
+      if (size < 3) {
+        return FALSE;
+      } /* if */
+      numSequences = (memSizeType) data[1] + ((memSizeType) data[2] << 8) + 0x7f00;
+      data += 3;
+      size -= 3;
+    } /* if */
+    if (numSequences != 0) {
+      if (size < 1 || (data[0] & 3) != 0) {
+        return FALSE;
+      } /* if */
+      modes = data[0];
+      data++;
+      size--;
+      used = readSequenceTable((modes >> 6) & 3, data, size,
+          zstdDefaultLiteralLengthNorm, 35, 6, ZSTD_LL_SYMBOL_MAX, ZSTD_LL_LOG_MAX,
+          state, ZSTD_STATE_LL_LOG, ZSTD_STATE_LL_TABLE);
+      if (used < 0) {
+        return FALSE;
+      } /* if */
+      data += used;
+      size -= (memSizeType) used;
+      used = readSequenceTable((modes >> 4) & 3, data, size,
+          zstdDefaultOffsetNorm, 28, 5, ZSTD_OF_SYMBOL_MAX, ZSTD_OF_LOG_MAX,
+          state, ZSTD_STATE_OF_LOG, ZSTD_STATE_OF_TABLE);
+      if (used < 0) {
+        return FALSE;
+      } /* if */
+      data += used;
+      size -= (memSizeType) used;
+      used = readSequenceTable((modes >> 2) & 3, data, size,
+          zstdDefaultMatchLengthNorm, 52, 6, ZSTD_ML_SYMBOL_MAX, ZSTD_ML_LOG_MAX,
+          state, ZSTD_STATE_ML_LOG, ZSTD_STATE_ML_TABLE);
+      if (used < 0 || !initBackwardBitStream(&stream, &data[used],
+                                             size - (memSizeType) used)) {
+        return FALSE;
+      } /* if */
+      llTable = &state[ZSTD_STATE_LL_TABLE];
+      ofTable = &state[ZSTD_STATE_OF_TABLE];
+      mlTable = &state[ZSTD_STATE_ML_TABLE];
+      rep = &state[ZSTD_STATE_REP];
+      llState = readBitsBackward(&stream, state[ZSTD_STATE_LL_LOG] - 1);
+      ofState = readBitsBackward(&stream, state[ZSTD_STATE_OF_LOG] - 1);
+      mlState = readBitsBackward(&stream, state[ZSTD_STATE_ML_LOG] - 1);
+      for (sequence = 0; sequence < numSequences; sequence++) {
+        llEntry = llTable[llState];
+        ofEntry = ofTable[ofState];
+        mlEntry = mlTable[mlState];
+        llCode = FSE_SYMBOL(llEntry);
+        ofCode = FSE_SYMBOL(ofEntry);
+        mlCode = FSE_SYMBOL(mlEntry);
+        if (ofCode > ZSTD_READ_BITS_MAX) {
+          offsetValue = readBitsBackward(&stream, ofCode - ZSTD_READ_BITS_MAX)
+                        << ZSTD_READ_BITS_MAX;
+          offsetValue += readBitsBackward(&stream, ZSTD_READ_BITS_MAX);
+        } else {
+          offsetValue = readBitsBackward(&stream, ofCode);
+        } /* if */
+        offsetValue += ((uint32Type) 1) << ofCode;
+        matchLength = zstdMatchLengthBase[mlCode] +
+                      readBitsBackward(&stream, zstdMatchLengthBits[mlCode]);
+        literalLength = zstdLiteralLengthBase[llCode] +
+                        readBitsBackward(&stream, zstdLiteralLengthBits[llCode]);
+        if (offsetValue > 3) {
+          offset = offsetValue - 3;
+          rep[2] = rep[1];
+          rep[1] = rep[0];
+          rep[0] = offset;
+        } else {
+          /* Repeat offsets are shifted by one if the literal length is zero. */
+          switch (offsetValue + (literalLength == 0)) {
+            case 1:
+              offset = rep[0];
+              break;
+            case 2:
+              offset = rep[1];
+              rep[1] = rep[0];
+              rep[0] = offset;
+              break;
+            case 3:
+              offset = rep[2];
+              rep[2] = rep[1];
+              rep[1] = rep[0];
+              rep[0] = offset;
+              break;
+            default:
+              offset = rep[0] - 1;
+              if (offset == 0) {
+                return FALSE;
+              } /* if */
+              rep[2] = rep[1];
+              rep[1] = rep[0];
+              rep[0] = offset;
+              break;
+          } /* switch */
+        } /* if */
+        if (sequence + 1 < numSequences) {
+          llState = FSE_BASELINE(llEntry) +
+                    readBitsBackward(&stream, FSE_NUM_BITS(llEntry));
+          mlState = FSE_BASELINE(mlEntry) +
+                    readBitsBackward(&stream, FSE_NUM_BITS(mlEntry));
+          ofState = FSE_BASELINE(ofEntry) +
+                    readBitsBackward(&stream, FSE_NUM_BITS(ofEntry));
+        } /* if */
+        if (literalLength > numLiterals - literalPos ||
+            literalLength + matchLength > outLimit - outPos ||
+            offset > outPos + literalLength || offset > windowSize) {
+          return FALSE;
+        } /* if */
+        memcpy_to_strelem(&out[outPos], &literals[literalPos], literalLength);
+        literalPos += literalLength;
+        outPos += literalLength;
+        /* The match may overlap with the data that is copied. */
+        for (index = 0; index < matchLength; index++) {
+          out[outPos + index] = out[outPos + index - offset];
+        } /* for */
+        outPos += matchLength;
+      } /* for */
+      if (stream.bitPos != 0 || stream.overflow) {
+        return FALSE;
+      } /* if */
+    } else if (size != 0) {
+      return FALSE;
+    } /* if */
+    if (numLiterals - literalPos > outLimit - outPos) {
+      return FALSE;
+    } /* if */
+    memcpy_to_strelem(&out[outPos], &literals[literalPos], numLiterals - literalPos);
+    *outSize = outPos + numLiterals - literalPos;
+    return TRUE;
+  } /* executeSequences */
+
+
+
+/**
+ *  Decode a compressed block of a Zstandard frame (RFC 8878).
+ *  The decoded data is appended to 'uncompressed'. Matches may
+ *  refer back at most 'windowSize' characters. An offset beyond
+ *  the window is treated as corrupt data. So 'uncompressed' needs
+ *  to contain only the last 'windowSize' characters of the frame
+ *  and the caller may discard the data before them. Raw and RLE
+ *  blocks as well as the frame header are handled by the caller.
+ *  Repeat offsets and entropy tables, which may be reused by the
+ *  next block, are kept in 'zstdState'. At the start of a frame
+ *  'zstdState' must be an empty string.
+ *  @param uncompressed Previously decoded data to which the block
+ *         is appended.
+ *  @param zstdState State that is carried from block to block.
+ *  @param block Contents of the compressed block (without block header).
+ *  @param windowSize Window size from the frame header. For a single
+ *         segment frame this is the frame content size.
+ *  @exception RANGE_ERROR If the block is corrupt, if a character
+ *             in 'block' is beyond '\255;' or if 'windowSize' is
+ *             negative.
+ *  @exception MEMORY_ERROR Not enough memory to decode the block.
+ */
+void cmpZstdDecodeBlock (striType *const uncompressed, striType *const zstdState,
+    const const_striType block, intType windowSize)
+
+  {
+    striType state;
+    ustriType data;
+    ucharType *literals = NULL;
+    const_ustriType literalsStart;
+    memSizeType numLiterals;
+    memSizeType literalsSize;
+    memSizeType outSize;
+    memSizeType window;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* cmpZstdDecodeBlock */
+    logFunction(printf("cmpZstdDecodeBlock(\"%s\", *, " FMT_U_MEM " chars, "
+                       FMT_D ")\n", striAsUnquotedCStri(*uncompressed),
+                       block->size, windowSize););
+    if (unlikely(windowSize < 0)) {
+      logError(printf("cmpZstdDecodeBlock: Negative window size.\n"););
+      raise_error(RANGE_ERROR);
+      return;
+    } else if ((*zstdState)->size != ZSTD_STATE_SIZE) {
+      if (unlikely((*zstdState)->size != 0)) {
+        logError(printf("cmpZstdDecodeBlock: Illegal state.\n"););
+        raise_error(RANGE_ERROR);
+        return;
+      } else if (unlikely(!ALLOC_STRI_SIZE_OK(state, ZSTD_STATE_SIZE))) {
+        raise_error(MEMORY_ERROR);
+        return;
+      } /* if */
+      state->size = ZSTD_STATE_SIZE;
+      memset(state->mem, 0, ZSTD_STATE_SIZE * sizeof(strElemType));
+      state->mem[ZSTD_STATE_REP] = 1;
+      state->mem[ZSTD_STATE_REP + 1] = 4;
+      state->mem[ZSTD_STATE_REP + 2] = 8;
+      FREE_STRI(*zstdState);
+      *zstdState = state;
+    } /* if */
+    if ((uintType) windowSize > MAX_MEMSIZETYPE) {
+      window = MAX_MEMSIZETYPE;
+    } else {
+      window = (memSizeType) windowSize;
+    } /* if */
+    outSize = (*uncompressed)->size;
+    if (unlikely(!ALLOC_UBYTES(data, block->size + 1))) {
+      err_info = MEMORY_ERROR;
+    } else {
+      if (unlikely(memcpy_from_strelem(data, block->mem, block->size))) {
+        logError(printf("cmpZstdDecodeBlock: Character beyond '\\255;' in block.\n"););
+        err_info = RANGE_ERROR;
+      } else if (unlikely(outSize > MAX_STRI_LEN - ZSTD_BLOCK_SIZE_MAX ||
+                          !ALLOC_TABLE(literals, ucharType, ZSTD_BLOCK_SIZE_MAX) ||
+                          !reserveOutput(uncompressed,
+                                         outSize + ZSTD_BLOCK_SIZE_MAX))) {
+        err_info = MEMORY_ERROR;
+      } else {
+        literalsSize = decodeLiterals(data, block->size, (*zstdState)->mem,
+                                      literals, &literalsStart, &numLiterals);
+        if (unlikely(literalsSize == 0 ||
+                     !executeSequences(&data[literalsSize],
+                                       block->size - literalsSize,
+                                       (*zstdState)->mem, literalsStart,
+                                       numLiterals, (*uncompressed)->mem,
+                                       &outSize, outSize + ZSTD_BLOCK_SIZE_MAX,
+                                       window))) {
+          logError(printf("cmpZstdDecodeBlock: Corrupt block.\n"););
+          err_info = RANGE_ERROR;
+        } /* if */
+        setReservedSize(uncompressed, outSize);
+      } /* if */
+      if (literals != NULL) {
+        FREE_TABLE(literals, ucharType, ZSTD_BLOCK_SIZE_MAX);
+      } /* if */
+      FREE_BYTES(data, block->size + 1);
+    } /* if */
+    if (unlikely(err_info != OKAY_NO_ERROR)) {
+      raise_error(err_info);
+    } /* if */
+    logFunction(printf("cmpZstdDecodeBlock --> " FMT_U_MEM " chars\n",
+                       (*uncompressed)->size););
+  } /* cmpZstdDecodeBlock */
+
+
+
+#define LZMA_FORMAT_LZMA        1
+#define LZMA_FORMAT_LZMA2       2
+#define LZMA_PHASE_HEADER       0
+#define LZMA_PHASE_COMPRESSED   1
+#define LZMA_PHASE_STORED       2
+#define LZMA_PHASE_FINISHED     3
+#define LZMA_NEED_DICT_RESET    1
+#define LZMA_NEED_PROPERTIES    2
+
+#define LZMA_NUM_STATES         12
+#define LZMA_POS_BITS_MAX       4
+#define LZMA_LC_LP_MAX_LZMA2    4
+#define LZMA_MATCH_LEN_MIN      2
+#define LZMA_END_POS_MODEL      14
+#define LZMA_FULL_DISTANCES     128
+#define LZMA_TOP_VALUE          ((uint32Type) 1 << 24)
+#define LZMA_MODEL_TOTAL_BITS   11
+#define LZMA_MODEL_TOTAL        (1 << LZMA_MODEL_TOTAL_BITS)
+#define LZMA_MOVE_BITS          5
+#define LZMA_REQUIRED_INPUT     20
+#define LZMA_DICT_SIZE_MIN      4096
+#define LZMA_DICT_SIZE_MAX      0xfffffe00
+#define LZMA_OUTPUT_STEP        1048576
+
+/* Offsets of the probabilities. */
+#define LZMA_IS_MATCH           0
+#define LZMA_IS_REP             (LZMA_IS_MATCH + (LZMA_NUM_STATES << LZMA_POS_BITS_MAX))
+#define LZMA_IS_REP_G0          (LZMA_IS_REP + LZMA_NUM_STATES)
+#define LZMA_IS_REP_G1          (LZMA_IS_REP_G0 + LZMA_NUM_STATES)
+#define LZMA_IS_REP_G2          (LZMA_IS_REP_G1 + LZMA_NUM_STATES)
+#define LZMA_IS_REP0_LONG       (LZMA_IS_REP_G2 + LZMA_NUM_STATES)
+#define LZMA_POS_SLOT           (LZMA_IS_REP0_LONG + (LZMA_NUM_STATES << LZMA_POS_BITS_MAX))
+#define LZMA_SPEC_POS           (LZMA_POS_SLOT + (4 << 6))
+#define LZMA_ALIGN              (LZMA_SPEC_POS + 1 + LZMA_FULL_DISTANCES - LZMA_END_POS_MODEL)
+#define LZMA_LEN_CODER          (LZMA_ALIGN + 16)
+#define LZMA_LEN_PROBS          (2 + (2 << (LZMA_POS_BITS_MAX + 3)) + 256)
+#define LZMA_REP_LEN_CODER      (LZMA_LEN_CODER + LZMA_LEN_PROBS)
+#define LZMA_LITERAL            (LZMA_REP_LEN_CODER + LZMA_LEN_PROBS)
+#define LZMA_NUM_PROBS(lcLp)    (LZMA_LITERAL + (0x300U << (lcLp)))
+
+/* Layout of the state string used by cmpLzmaDecode(). */
+#define LZMA_STATE_FORMAT       0
+#define LZMA_STATE_PHASE        1
+#define LZMA_STATE_LC           2
+#define LZMA_STATE_LP           3
+#define LZMA_STATE_PB           4
+#define LZMA_STATE_STATE        5
+#define LZMA_STATE_REP          6
+#define LZMA_STATE_RANGE        10
+#define LZMA_STATE_CODE         11
+#define LZMA_STATE_REMAIN_LEN   12
+#define LZMA_STATE_UNPACKED     13
+#define LZMA_STATE_PACKED       14
+#define LZMA_STATE_DICT_FILL    15
+#define LZMA_STATE_POS          16
+#define LZMA_STATE_FLAGS        17
+#define LZMA_STATE_NUM_PROBS    18
+/* The probabilities are stored as 16-bit values, two per character. */
+#define LZMA_STATE_PROBS        19
+
+typedef enum {
+    LZMA_OKAY,
+    LZMA_END_MARKER,
+    LZMA_CORRUPT
+  } lzmaResultType;
+
+typedef struct {
+    uint32Type range;
+    uint32Type code;
+    const_ustriType in;
+  } rangeDecoderType;
+
+typedef struct {
+    unsigned int format;
+    unsigned int phase;
+    unsigned int lc;
+    unsigned int lp;
+    unsigned int pb;
+    uint32Type state;
+    uint32Type rep[4];
+    uint32Type range;
+    uint32Type code;
+    uint32Type remainLen;
+    uint32Type unpacked;
+    uint32Type packed;
+    uint32Type dictFill;
+    uint32Type dictSize;
+    uint32Type pos;
+    uint32Type flags;
+    uint16Type *probs;
+    const_ustriType in;
+    strElemType *out;
+    memSizeType outPos;
+  } lzmaDecoderType;
+
+
+
+static inline unsigned int decodeBit (rangeDecoderType *rc, uint16Type *prob)
+
+  {
+    uint32Type bound;
+    unsigned int bit;
+
+  /* decodeBit */
+    bound = (rc->range >> LZMA_MODEL_TOTAL_BITS) * *prob;
+    if (rc->code < bound) {
+      rc->range = bound;
+      *prob = (uint16Type) (*prob + ((LZMA_MODEL_TOTAL - *prob) >> LZMA_MOVE_BITS));
+      bit = 0;
+    } else {
+      rc->range -= bound;
+      rc->code -= bound;
+      *prob = (uint16Type) (*prob - (*prob >> LZMA_MOVE_BITS));
+      bit = 1;
+    } /* if */
+    if (rc->range < LZMA_TOP_VALUE) {
+      rc->range <<= 8;
+      rc->code = (rc->code << 8) | *rc->in++;
+    } /* if */
+    return bit;
+  } /* decodeBit */
+
+
+
+static inline uint32Type decodeDirectBits (rangeDecoderType *rc,
+    unsigned int numBits)
+
+  {
+    uint32Type mask;
+    uint32Type result = 0;
+
+  /* decodeDirectBits */
+    do {
+      rc->range >>= 1;
+      rc->code -= rc->range;
+      mask = 0 - (rc->code >> 31);
+      rc->code += rc->range & mask;
+      if (rc->range < LZMA_TOP_VALUE) {
+        rc->range <<= 8;
+        rc->code = (rc->code << 8) | *rc->in++;
+      } /* if */
+      result = (result << 1) + (mask + 1);
+    } while (--numBits != 0);
+    return result;
+  } /* decodeDirectBits */
+
+
+
+static inline unsigned int decodeBitTree (rangeDecoderType *rc,
+    uint16Type *probs, unsigned int numBits)
+
+  {
+    unsigned int index;
+    unsigned int symbol = 1;
+
+  /* decodeBitTree */
+    for (index = 0; index < numBits; index++) {
+      symbol = (symbol << 1) + decodeBit(rc, &probs[symbol]);
+    } /* for */
+    return symbol - (1U << numBits);
+  } /* decodeBitTree */
+
+
+
+static inline unsigned int decodeReverseBitTree (rangeDecoderType *rc,
+    uint16Type *probs, unsigned int numBits)
+
+  {
+    unsigned int index;
+    unsigned int bit;
+    unsigned int node = 1;
+    unsigned int symbol = 0;
+
+  /* decodeReverseBitTree */
+    for (index = 0; index < numBits; index++) {
+      bit = decodeBit(rc, &probs[node]);
+      node = (node << 1) + bit;
+      symbol |= bit << index;
+    } /* for */
+    return symbol;
+  } /* decodeReverseBitTree */
+
+
+
+/**
+ *  Decode a match length. The result is relative to LZMA_MATCH_LEN_MIN.
+ */
+static inline unsigned int decodeMatchLength (rangeDecoderType *rc,
+    uint16Type *probs, unsigned int posState)
+
+  {
+    unsigned int length;
+
+  /* decodeMatchLength */
+    if (decodeBit(rc, &probs[0]) == 0) {
+      length = decodeBitTree(rc, &probs[2 + (posState << 3)], 3);
+    } else if (decodeBit(rc, &probs[1]) == 0) {
+      length = 8 + decodeBitTree(rc,
+          &probs[2 + (1 << (LZMA_POS_BITS_MAX + 3)) + (posState << 3)], 3);
+    } else {
+      length = 16 + decodeBitTree(rc,
+          &probs[2 + (2 << (LZMA_POS_BITS_MAX + 3))], 8);
+    } /* if */
+    return length;
+  } /* decodeMatchLength */
+
+
+
+static inline uint32Type decodeDistance (rangeDecoderType *rc,
+    uint16Type *probs, unsigned int length)
+
+  {
+    unsigned int posSlot;
+    unsigned int numDirectBits;
+    uint32Type distance;
+
+  /* decodeDistance */
+    posSlot = decodeBitTree(rc,
+        &probs[LZMA_POS_SLOT + ((length < 3 ? length : 3) << 6)], 6);
+    if (posSlot < 4) {
+      distance = posSlot;
+    } else {
+      numDirectBits = (posSlot >> 1) - 1;
+      distance = (2 | (posSlot & 1)) << numDirectBits;
+      if (posSlot < LZMA_END_POS_MODEL) {
+        distance += decodeReverseBitTree(rc,
+            &probs[LZMA_SPEC_POS + distance - posSlot], numDirectBits);
+      } else {
+        distance += decodeDirectBits(rc, numDirectBits - 4) << 4;
+        distance += decodeReverseBitTree(rc, &probs[LZMA_ALIGN], 4);
+      } /* if */
+    } /* if */
+    return distance;
+  } /* decodeDistance */
+
+
+
+/**
+ *  Decode LZMA symbols until 'outLimit' is reached.
+ *  A new symbol is only started if the input position is not
+ *  beyond 'inLimit'. The caller guarantees that decoding a symbol
+ *  started at 'inLimit' does not read beyond the input buffer.
+ */
+static lzmaResultType decodeSymbols (lzmaDecoderType *dec, memSizeType outLimit,
+    const_ustriType inLimit)
+
+  {
+    rangeDecoderType rc;
+    uint16Type *probs;
+    uint16Type *litProbs;
+    strElemType *out;
+    memSizeType outPos;
+    uint32Type state;
+    uint32Type rep0;
+    uint32Type dictFill;
+    uint32Type dictSize;
+    uint32Type pos;
+    uint32Type pbMask;
+    uint32Type lpMask;
+    unsigned int lc;
+    unsigned int posState;
+    unsigned int symbol;
+    unsigned int matchByte;
+    unsigned int matchBit;
+    unsigned int bit;
+    unsigned int length;
+    uint32Type distance;
+    lzmaResultType result = LZMA_OKAY;
+
+  /* decodeSymbols */
+    rc.range = dec->range;
+    rc.code = dec->code;
+    rc.in = dec->in;
+    probs = dec->probs;
+    out = dec->out;
+    outPos = dec->outPos;
+    state = dec->state;
+    rep0 = dec->rep[0];
+    dictFill = dec->dictFill;
+    dictSize = dec->dictSize;
+    pos = dec->pos;
+    pbMask = (1U << dec->pb) - 1;
+    lpMask = (1U << dec->lp) - 1;
+    lc = dec->lc;
+    /* Continue a match that did not fit into the previous output. */
+    length = dec->remainLen;
+    if (length > outLimit - outPos) {
+      length = (unsigned int) (outLimit - outPos);
+    } /* if */
+    dec->remainLen -= length;
+    pos += length;
+    dictFill = length >= dictSize - dictFill ? dictSize : dictFill + length;
+    for (; length != 0; length--) {
+      out[outPos] = out[outPos - rep0 - 1];
+      outPos++;
+    } /* for */
+    while (outPos < outLimit && rc.in <= inLimit) {
+      posState = pos & pbMask;
+      if (decodeBit(&rc, &probs[LZMA_IS_MATCH + (state << LZMA_POS_BITS_MAX) + posState]) == 0) {
+        litProbs = &probs[LZMA_LITERAL + 0x300 *
+            (((pos & lpMask) << lc) +
+             ((dictFill != 0 && outPos != 0 ? out[outPos - 1] & 0xff : 0) >> (8 - lc)))];
+        symbol = 1;
+        if (state >= 7) {
+          if (unlikely(rep0 >= outPos)) {
+            result = LZMA_CORRUPT;
+            break;
+          } /* if */
+          matchByte = out[outPos - rep0 - 1] & 0xff;
+          do {
+            matchBit = (matchByte >> 7) & 1;
+            matchByte <<= 1;
+            bit = decodeBit(&rc, &litProbs[((1 + matchBit) << 8) + symbol]);
+            symbol = (symbol << 1) | bit;
+          } while (matchBit == bit && symbol < 0x100);
+        } /* if */
+        while (symbol < 0x100) {
+          symbol = (symbol << 1) | decodeBit(&rc, &litProbs[symbol]);
+        } /* while */
+        out[outPos++] = (strElemType) (symbol & 0xff);
+        state = state < 4 ? 0 : (state < 10 ? state - 3 : state - 6);
+        length = 1;
+      } else {
+        if (decodeBit(&rc, &probs[LZMA_IS_REP + state]) != 0) {
+          if (unlikely(dictFill == 0)) {
+            result = LZMA_CORRUPT;
+            break;
+          } /* if */
+          if (decodeBit(&rc, &probs[LZMA_IS_REP_G0 + state]) == 0) {
+            if (decodeBit(&rc, &probs[LZMA_IS_REP0_LONG +
+                                      (state << LZMA_POS_BITS_MAX) + posState]) == 0) {
+              /* Short rep: A single byte at distance rep0. */
+              if (unlikely(rep0 >= dictFill || rep0 >= outPos)) {
+                result = LZMA_CORRUPT;
+                break;
+              } /* if */
+              state = state < 7 ? 9 : 11;
+              out[outPos] = out[outPos - rep0 - 1];
+              outPos++;
+              pos++;
+              if (dictFill < dictSize) {
+                dictFill++;
+              } /* if */
+              continue;
+            } /* if */
+          } else {
+            if (decodeBit(&rc, &probs[LZMA_IS_REP_G1 + state]) == 0) {
+              distance = dec->rep[1];
+            } else {
+              if (decodeBit(&rc, &probs[LZMA_IS_REP_G2 + state]) == 0) {
+                distance = dec->rep[2];
+              } else {
+                distance = dec->rep[3];
+                dec->rep[3] = dec->rep[2];
+              } /* if */
+              dec->rep[2] = dec->rep[1];
+            } /* if */
+            dec->rep[1] = rep0;
+            rep0 = distance;
+          } /* if */
+          length = decodeMatchLength(&rc, &probs[LZMA_REP_LEN_CODER], posState);
+          state = state < 7 ? 8 : 11;
+        } else {
+          dec->rep[3] = dec->rep[2];
+          dec->rep[2] = dec->rep[1];
+          dec->rep[1] = rep0;
+          length = decodeMatchLength(&rc, &probs[LZMA_LEN_CODER], posState);
+          state = state < 7 ? 7 : 10;
+          rep0 = decodeDistance(&rc, probs, length);
+          if (rep0 == 0xffffffff) {
+            result = LZMA_END_MARKER;
+            break;
+          } /* if */
+        } /* if */
+        if (unlikely(rep0 >= dictFill || rep0 >= outPos)) {
+          result = LZMA_CORRUPT;
+          break;
+        } /* if */
+        length += LZMA_MATCH_LEN_MIN;
+        if (length > outLimit - outPos) {
+          dec->remainLen = length - (unsigned int) (outLimit - outPos);
+          length = (unsigned int) (outLimit - outPos);
+        } /* if */
+        for (symbol = 0; symbol < length; symbol++) {
+          out[outPos + symbol] = out[outPos + symbol - rep0 - 1];
+        } /* for */
+        outPos += length;
+      } /* if */
+      pos += length;
+      dictFill = length >= dictSize - dictFill ? dictSize : dictFill + length;
+    } /* while */
+    dec->range = rc.range;
+    dec->code = rc.code;
+    dec->in = rc.in;
+    dec->outPos = outPos;
+    dec->state = state;
+    dec->rep[0] = rep0;
+    dec->dictFill = dictFill;
+    dec->pos = pos;
+    return result;
+  } /* decodeSymbols */
+
+
+
+/**
+ *  Decode symbols from 'available' bytes of input.
+ *  If 'final' is TRUE the input ends after 'available' bytes.
+ *  Otherwise decoding stops when less than LZMA_REQUIRED_INPUT
+ *  bytes are left, such that the decoding can be continued when
+ *  more input is available.
+ */
+static lzmaResultType decodeRange (lzmaDecoderType *dec, memSizeType available,
+    boolType final, memSizeType outLimit)
+
+  {
+    const_ustriType inEnd;
+    ucharType tail[2 * LZMA_REQUIRED_INPUT + 8];
+    memSizeType rest;
+    memSizeType used;
+    lzmaResultType result = LZMA_OKAY;
+
+  /* decodeRange */
+    inEnd = &dec->in[available];
+    if (available >= LZMA_REQUIRED_INPUT) {
+      result = decodeSymbols(dec, outLimit, inEnd - LZMA_REQUIRED_INPUT);
+    } /* if */
+    if (result == LZMA_OKAY && final && dec->outPos < outLimit) {
+      /* Decode the last bytes from a zero padded buffer. */
+      rest = (memSizeType) (inEnd - dec->in);
+      memcpy(tail, dec->in, rest);
+      memset(&tail[rest], 0, sizeof(tail) - rest);
+      dec->in = tail;
+      result = decodeSymbols(dec, outLimit, &tail[rest]);
+      used = (memSizeType) (dec->in - tail);
+      if (used > rest) {
+        result = LZMA_CORRUPT;
+        used = rest;
+      } /* if */
+      dec->in = &inEnd[used - rest];
+    } /* if */
+    return result;
+  } /* decodeRange */
+
+
+
+static void resetLzmaState (lzmaDecoderType *dec)
+
+  {
+    unsigned int index;
+    unsigned int numProbs;
+
+  /* resetLzmaState */
+    numProbs = LZMA_NUM_PROBS(dec->lc + dec->lp);
+    for (index = 0; index < numProbs; index++) {
+      dec->probs[index] = LZMA_MODEL_TOTAL >> 1;
+    } /* for */
+    dec->state = 0;
+    dec->rep[0] = 0;
+    dec->rep[1] = 0;
+    dec->rep[2] = 0;
+    dec->rep[3] = 0;
+    dec->pos = 0;
+    dec->remainLen = 0;
+  } /* resetLzmaState */
+
+
+
+static boolType setLzmaProperties (lzmaDecoderType *dec, unsigned int properties)
+
+  { /* setLzmaProperties */
+    if (properties >= 9 * 5 * 5) {
+      return FALSE;
+    } /* if */
+    dec->lc = properties % 9;
+    properties /= 9;
+    dec->lp = properties % 5;
+    dec->pb = properties / 5;
+    return TRUE;
+  } /* setLzmaProperties */
+
+
+
+/**
+ *  Initialize the range decoder from five bytes of input.
+ */
+static boolType initRangeDecoder (lzmaDecoderType *dec)
+
+  { /* initRangeDecoder */
+    if (dec->in[0] != 0) {
+      return FALSE;
+    } /* if */
+    dec->code = (uint32Type) dec->in[1] << 24 | (uint32Type) dec->in[2] << 16 |
+                (uint32Type) dec->in[3] << 8 | (uint32Type) dec->in[4];
+    dec->range = 0xffffffff;
+    dec->in += 5;
+    return dec->code != dec->range;
+  } /* initRangeDecoder */
+
+
+
+/**
+ *  Decode a raw LZMA stream (as used by .lzma files and zip archives).
+ */
+static lzmaResultType decodeLzmaStream (lzmaDecoderType *dec,
+    memSizeType available, boolType inputFinished, memSizeType outLimit)
+
+  {
+    lzmaResultType result = LZMA_OKAY;
+
+  /* decodeLzmaStream */
+    if (dec->phase == LZMA_PHASE_HEADER) {
+      if (available >= 5) {
+        if (!initRangeDecoder(dec)) {
+          result = LZMA_CORRUPT;
+        } else {
+          dec->phase = LZMA_PHASE_COMPRESSED;
+          available -= 5;
+        } /* if */
+      } else if (inputFinished) {
+        result = LZMA_CORRUPT;
+      } /* if */
+    } /* if */
+    if (result == LZMA_OKAY && dec->phase == LZMA_PHASE_COMPRESSED) {
+      result = decodeRange(dec, available, inputFinished, outLimit);
+      if (result == LZMA_END_MARKER) {
+        if (dec->code != 0) {
+          result = LZMA_CORRUPT;
+        } else {
+          dec->phase = LZMA_PHASE_FINISHED;
+          result = LZMA_OKAY;
+        } /* if */
+      } /* if */
+    } /* if */
+    return result;
+  } /* decodeLzmaStream */
+
+
+
+/**
+ *  Decode an LZMA2 stream (as used by .xz files). LZMA2 consists
+ *  of chunks which are either LZMA compressed or stored.
+ */
+static lzmaResultType decodeLzma2Stream (lzmaDecoderType *dec,
+    memSizeType available, boolType inputFinished, memSizeType outLimit)
+
+  {
+    const_ustriType inEnd;
+    const_ustriType chunkStart;
+    memSizeType outStart;
+    memSizeType length;
+    unsigned int control;
+    unsigned int reset;
+    memSizeType headerSize;
+    boolType progress = TRUE;
+    lzmaResultType result = LZMA_OKAY;
+
+  /* decodeLzma2Stream */
+    inEnd = &dec->in[available];
+    while (result == LZMA_OKAY && progress && dec->phase != LZMA_PHASE_FINISHED) {
+      progress = FALSE;
+      available = (memSizeType) (inEnd - dec->in);
+      switch (dec->phase) {
+        case LZMA_PHASE_HEADER:
+          if (available == 0) {
+            break;
+          } /* if */
+          control = dec->in[0];
+          if (control == 0) {
+            dec->in++;
+            dec->phase = LZMA_PHASE_FINISHED;
+          } else if (control <= 2) {
+            if (available >= 3) {
+              if (control == 1) {
+                dec->dictFill = 0;
+                dec->flags &= ~(uint32Type) LZMA_NEED_DICT_RESET;
+              } else if (dec->flags & LZMA_NEED_DICT_RESET) {
+                result = LZMA_CORRUPT;
+              } /* if */
+              dec->unpacked = ((uint32Type) dec->in[1] << 8 | dec->in[2]) + 1;
+              dec->in += 3;
+              dec->phase = LZMA_PHASE_STORED;
+              progress = TRUE;
+            } /* if */
+          } else if (control >= 0x80) {
+            headerSize = control >= 0xc0 ? 6 : 5;
+            if (available >= headerSize + 5) {
+              reset = (control >> 5) & 3;
+              if (((dec->flags & LZMA_NEED_DICT_RESET) && reset != 3) ||
+                  ((dec->flags & LZMA_NEED_PROPERTIES) && reset < 2)) {
+                result = LZMA_CORRUPT;
+              } else {
+                if (reset == 3) {
+                  dec->dictFill = 0;
+                  dec->flags &= ~(uint32Type) LZMA_NEED_DICT_RESET;
+                } /* if */
+                if (reset >= 2) {
+                  if (!setLzmaProperties(dec, dec->in[5]) ||
+                      dec->lc + dec->lp > LZMA_LC_LP_MAX_LZMA2) {
+                    result = LZMA_CORRUPT;
+                  } /* if */
+                  dec->flags &= ~(uint32Type) LZMA_NEED_PROPERTIES;
+                } /* if */
+                if (reset >= 1 && result == LZMA_OKAY) {
+                  resetLzmaState(dec);
+                } /* if */
+                dec->unpacked = ((uint32Type) (control & 0x1f) << 16 |
+                                 (uint32Type) dec->in[1] << 8 | dec->in[2]) + 1;
+                dec->packed = ((uint32Type) dec->in[3] << 8 | dec->in[4]) + 1;
+                dec->in += headerSize;
+                if (result == LZMA_OKAY &&
+                    (dec->packed < 5 || !initRangeDecoder(dec))) {
+                  result = LZMA_CORRUPT;
+                } /* if */
+                dec->packed -= 5;
+                dec->phase = LZMA_PHASE_COMPRESSED;
+                progress = TRUE;
+              } /* if */
+            } /* if */
+          } else {
+            result = LZMA_CORRUPT;
+          } /* if */
+          break;
+        case LZMA_PHASE_STORED:
+          length = dec->unpacked;
+          if (length > available) {
+            length = available;
+          } /* if */
+          if (length > outLimit - dec->outPos) {
+            length = outLimit - dec->outPos;
+          } /* if */
+          memcpy_to_strelem(&dec->out[dec->outPos], dec->in, length);
+          dec->in += length;
+          dec->outPos += length;
+          dec->unpacked -= (uint32Type) length;
+          dec->pos += (uint32Type) length;
+          dec->dictFill = length >= dec->dictSize - dec->dictFill ?
+                          dec->dictSize : dec->dictFill + (uint32Type) length;
+          if (dec->unpacked == 0) {
+            dec->phase = LZMA_PHASE_HEADER;
+            progress = TRUE;
+          } /* if */
+          break;
+        case LZMA_PHASE_COMPRESSED:
+          if (dec->unpacked != 0) {
+            chunkStart = dec->in;
+            outStart = dec->outPos;
+            length = dec->unpacked;
+            if (length > outLimit - dec->outPos) {
+              length = outLimit - dec->outPos;
+            } /* if */
+            result = decodeRange(dec, dec->packed < available ? dec->packed : available,
+                                 dec->packed <= available, dec->outPos + length);
+            if (result == LZMA_END_MARKER) {
+              result = LZMA_CORRUPT;
+            } /* if */
+            dec->packed -= (uint32Type) (dec->in - chunkStart);
+            dec->unpacked -= (uint32Type) (dec->outPos - outStart);
+          } /* if */
+          if (result == LZMA_OKAY && dec->unpacked == 0) {
+            if (dec->packed != 0 || dec->code != 0 || dec->remainLen != 0) {
+              result = LZMA_CORRUPT;
+            } else {
+              dec->phase = LZMA_PHASE_HEADER;
+              progress = TRUE;
+            } /* if */
+          } /* if */
+          break;
+      } /* switch */
+    } /* while */
+    if (result == LZMA_OKAY && inputFinished && dec->phase != LZMA_PHASE_FINISHED &&
+        dec->outPos < outLimit) {
+      /* The input ended before the end of the stream. */
+      result = LZMA_CORRUPT;
+    } /* if */
+    return result;
+  } /* decodeLzma2Stream */
+
+
+
+/**
+ *  Create the state of an LZMA or LZMA2 decoder.
+ *  @return the new state or NULL if the allocation failed or if
+ *          the properties are invalid.
+ */
+static striType createLzmaState (const const_striType initial,
+    errInfoType *err_info)
+
+  {
+    lzmaDecoderType dec;
+    memSizeType numProbs;
+    striType state;
+
+  /* createLzmaState */
+    memset(&dec, 0, sizeof(lzmaDecoderType));
+    if (initial->size == 0) {
+      dec.format = LZMA_FORMAT_LZMA2;
+      dec.flags = LZMA_NEED_DICT_RESET | LZMA_NEED_PROPERTIES;
+      numProbs = LZMA_NUM_PROBS(LZMA_LC_LP_MAX_LZMA2);
+    } else if (initial->size != 1 || initial->mem[0] > 255 ||
+               !setLzmaProperties(&dec, initial->mem[0])) {
+      *err_info = RANGE_ERROR;
+      return NULL;
+    } else {
+      dec.format = LZMA_FORMAT_LZMA;
+      numProbs = LZMA_NUM_PROBS(dec.lc + dec.lp);
+    } /* if */
+    if (unlikely(!ALLOC_STRI_SIZE_OK(state, LZMA_STATE_PROBS + (numProbs + 1) / 2))) {
+      *err_info = MEMORY_ERROR;
+    } else {
+      state->size = LZMA_STATE_PROBS + (numProbs + 1) / 2;
+      memset(state->mem, 0, state->size * sizeof(strElemType));
+      state->mem[LZMA_STATE_FORMAT] = dec.format;
+      state->mem[LZMA_STATE_PHASE] = LZMA_PHASE_HEADER;
+      state->mem[LZMA_STATE_LC] = dec.lc;
+      state->mem[LZMA_STATE_LP] = dec.lp;
+      state->mem[LZMA_STATE_PB] = dec.pb;
+      state->mem[LZMA_STATE_FLAGS] = dec.flags;
+      state->mem[LZMA_STATE_NUM_PROBS] = (strElemType) numProbs;
+      if (dec.format == LZMA_FORMAT_LZMA) {
+        dec.probs = (uint16Type *) &state->mem[LZMA_STATE_PROBS];
+        resetLzmaState(&dec);
+      } /* if */
+    } /* if */
+    return state;
+  } /* createLzmaState */
+
+
+
+static void loadLzmaState (lzmaDecoderType *dec, const const_striType state)
+
+  {
+    const strElemType *mem;
+
+  /* loadLzmaState */
+    mem = state->mem;
+    dec->format = mem[LZMA_STATE_FORMAT];
+    dec->phase = mem[LZMA_STATE_PHASE];
+    dec->lc = mem[LZMA_STATE_LC];
+    dec->lp = mem[LZMA_STATE_LP];
+    dec->pb = mem[LZMA_STATE_PB];
+    dec->state = mem[LZMA_STATE_STATE];
+    memcpy(dec->rep, &mem[LZMA_STATE_REP], sizeof(dec->rep));
+    dec->range = mem[LZMA_STATE_RANGE];
+    dec->code = mem[LZMA_STATE_CODE];
+    dec->remainLen = mem[LZMA_STATE_REMAIN_LEN];
+    dec->unpacked = mem[LZMA_STATE_UNPACKED];
+    dec->packed = mem[LZMA_STATE_PACKED];
+    dec->dictFill = mem[LZMA_STATE_DICT_FILL];
+    dec->pos = mem[LZMA_STATE_POS];
+    dec->flags = mem[LZMA_STATE_FLAGS];
+    dec->probs = (uint16Type *) &state->mem[LZMA_STATE_PROBS];
+  } /* loadLzmaState */
+
+
+
+static void storeLzmaState (const lzmaDecoderType *dec, const striType state)
+
+  {
+    strElemType *mem;
+
+  /* storeLzmaState */
+    mem = state->mem;
+    mem[LZMA_STATE_PHASE] = dec->phase;
+    mem[LZMA_STATE_LC] = dec->lc;
+    mem[LZMA_STATE_LP] = dec->lp;
+    mem[LZMA_STATE_PB] = dec->pb;
+    mem[LZMA_STATE_STATE] = dec->state;
+    memcpy(&mem[LZMA_STATE_REP], dec->rep, sizeof(dec->rep));
+    mem[LZMA_STATE_RANGE] = dec->range;
+    mem[LZMA_STATE_CODE] = dec->code;
+    mem[LZMA_STATE_REMAIN_LEN] = dec->remainLen;
+    mem[LZMA_STATE_UNPACKED] = dec->unpacked;
+    mem[LZMA_STATE_PACKED] = dec->packed;
+    mem[LZMA_STATE_DICT_FILL] = dec->dictFill;
+    mem[LZMA_STATE_POS] = dec->pos;
+    mem[LZMA_STATE_FLAGS] = dec->flags;
+  } /* storeLzmaState */
+
+
+
+/**
+ *  Decode LZMA or LZMA2 compressed data incrementally.
+ *  The decoder consumes bytes from the front of 'compressed' and
+ *  appends at most 'maxLength' characters to 'uncompressed'. Bytes
+ *  that could not be processed yet remain in 'compressed'. Matches
+ *  refer to the end of 'uncompressed' and may reach back at most
+ *  'dictionarySize' characters. A match beyond the dictionary is
+ *  treated as corrupt data. So 'uncompressed' needs to contain only
+ *  the last 'dictionarySize' characters of the previous output and
+ *  the caller may discard the data before them. The decoder state
+ *  is kept in 'lzmaState'. At the start it must be an empty string
+ *  for LZMA2 or a string with the LZMA properties byte (lc, lp and
+ *  pb) as only character for LZMA.
+ *  @param lzmaState State of the decoder.
+ *  @param compressed Compressed input. Processed bytes are removed.
+ *  @param inputFinished TRUE if no more input follows 'compressed'.
+ *  @param uncompressed Decoded data to which the output is appended.
+ *  @param maxLength Maximum number of characters to be appended.
+ *  @param dictionarySize Dictionary size from the LZMA header or
+ *         the LZMA2 filter properties. Sizes below 4096 are treated
+ *         as 4096, like other decoders do.
+ *  @return TRUE if the end of the stream has been reached (LZMA
+ *          end marker or LZMA2 end of stream), FALSE otherwise.
+ *  @exception RANGE_ERROR If the data is corrupt or truncated, or
+ *             if 'maxLength' or 'dictionarySize' is negative.
+ *  @exception MEMORY_ERROR Not enough memory to decode the data.
+ */
+boolType cmpLzmaDecode (striType *const lzmaState, striType *const compressed,
+    boolType inputFinished, striType *const uncompressed, intType maxLength,
+    intType dictionarySize)
+
+  {
+    striType state;
+    ustriType data;
+    memSizeType available;
+    memSizeType consumed;
+    memSizeType outTarget;
+    memSizeType outLimit;
+    lzmaDecoderType dec;
+    lzmaResultType result = LZMA_OKAY;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* cmpLzmaDecode */
+    logFunction(printf("cmpLzmaDecode(*, " FMT_U_MEM " chars, %d, "
+                       FMT_U_MEM " chars, " FMT_D ", " FMT_D ")\n",
+                       (*compressed)->size, inputFinished,
+                       (*uncompressed)->size, maxLength, dictionarySize););
+    if (unlikely(maxLength < 0 || dictionarySize < 0)) {
+      logError(printf("cmpLzmaDecode: Negative maximum length or dictionary size.\n"););
+      raise_error(RANGE_ERROR);
+      return FALSE;
+    } else if ((*lzmaState)->size <= 1) {
+      state = createLzmaState(*lzmaState, &err_info);
+      if (unlikely(state == NULL)) {
+        logError(printf("cmpLzmaDecode: Illegal initial state.\n"););
+        raise_error(err_info);
+        return FALSE;
+      } /* if */
+      FREE_STRI(*lzmaState);
+      *lzmaState = state;
+    } else if (unlikely((*lzmaState)->size < LZMA_STATE_PROBS ||
+                        (*lzmaState)->size != LZMA_STATE_PROBS +
+                        ((*lzmaState)->mem[LZMA_STATE_NUM_PROBS] + 1) / 2)) {
+      logError(printf("cmpLzmaDecode: Illegal state.\n"););
+      raise_error(RANGE_ERROR);
+      return FALSE;
+    } /* if */
+    loadLzmaState(&dec, *lzmaState);
+    if (dec.phase == LZMA_PHASE_FINISHED) {
+      return TRUE;
+    } /* if */
+    if (dictionarySize < LZMA_DICT_SIZE_MIN) {
+      dec.dictSize = LZMA_DICT_SIZE_MIN;
+    } else if ((uintType) dictionarySize > LZMA_DICT_SIZE_MAX) {
+      dec.dictSize = LZMA_DICT_SIZE_MAX;
+    } else {
+      dec.dictSize = (uint32Type) dictionarySize;
+    } /* if */
+    if (dec.dictFill > dec.dictSize) {
+      dec.dictFill = dec.dictSize;
+    } /* if */
+    available = (*compressed)->size;
+    if (unlikely(!ALLOC_UBYTES(data, available + 1))) {
+      raise_error(MEMORY_ERROR);
+      return FALSE;
+    } else if (unlikely(memcpy_from_strelem(data, (*compressed)->mem, available))) {
+      FREE_BYTES(data, available + 1);
+      logError(printf("cmpLzmaDecode: Character beyond '\\255;' in data.\n"););
+      raise_error(RANGE_ERROR);
+      return FALSE;
+    } /* if */
+    dec.in = data;
+    dec.outPos = (*uncompressed)->size;
+    if ((uintType) maxLength > MAX_STRI_LEN - dec.outPos) {
+      outTarget = MAX_STRI_LEN;
+    } else {
+      outTarget = dec.outPos + (memSizeType) maxLength;
+    } /* if */
+    do {
+      /* The output string is enlarged step by step. */
+      outLimit = outTarget - dec.outPos > LZMA_OUTPUT_STEP ?
+                 dec.outPos + LZMA_OUTPUT_STEP : outTarget;
+      if (unlikely(!reserveOutput(uncompressed, outLimit))) {
+        err_info = MEMORY_ERROR;
+      } else {
+        dec.out = (*uncompressed)->mem;
+        consumed = (memSizeType) (dec.in - data);
+        if (dec.format == LZMA_FORMAT_LZMA) {
+          result = decodeLzmaStream(&dec, available - consumed,
+                                    inputFinished, outLimit);
+        } else {
+          result = decodeLzma2Stream(&dec, available - consumed,
+                                     inputFinished, outLimit);
+        } /* if */
+        if (unlikely(result == LZMA_CORRUPT)) {
+          logError(printf("cmpLzmaDecode: Corrupt data.\n"););
+          err_info = RANGE_ERROR;
+        } /* if */
+      } /* if */
+    } while (err_info == OKAY_NO_ERROR && dec.phase != LZMA_PHASE_FINISHED &&
+             dec.outPos == outLimit && outLimit < outTarget);
+    setReservedSize(uncompressed, dec.outPos);
+    consumed = (memSizeType) (dec.in - data);
+    memmove((*compressed)->mem, &(*compressed)->mem[consumed],
+            (available - consumed) * sizeof(strElemType));
+    setReservedSize(compressed, available - consumed);
+    storeLzmaState(&dec, *lzmaState);
+    FREE_BYTES(data, available + 1);
+    if (unlikely(err_info != OKAY_NO_ERROR)) {
+      raise_error(err_info);
+    } /* if */
+    logFunction(printf("cmpLzmaDecode --> %d\n",
+                       dec.phase == LZMA_PHASE_FINISHED););
+    return dec.phase == LZMA_PHASE_FINISHED;
+  } /* cmpLzmaDecode */
+
+
+
+#define CRC32_POLYNOMIAL        0xedb88320  /* CRC-32 (gzip, zip, png), reflected */
+#define CRC32C_POLYNOMIAL       0x82f63b78  /* CRC-32C (Castagnoli), reflected */
+#define BZIP2_CRC32_POLYNOMIAL  0x04c11db7  /* CRC-32 of bzip2, not reflected */
+#define CRC_BUFFER_SIZE         4096
+#define CRC_CLMUL_MINIMUM       64
+
+static uint32Type crc32Table[8][256];
+static uint32Type crc32cTable[8][256];
+static uint32Type bzip2Crc32Table[8][256];
+static boolType crcTablesInitialized = FALSE;
+
+
+
+/**
+ *  Compute the tables used by the slicing-by-8 algorithm.
+ *  Table 0 is the classic byte-wise table. Table k is the effect
+ *  of a byte followed by k zero bytes.
+ */
+static void initCrcTables (void)
+
+  {
+    unsigned int index;
+    unsigned int bit;
+    unsigned int slice;
+    uint32Type crc;
+    uint32Type crcC;
+    uint32Type bzip2Crc;
+
+  /* initCrcTables */
+    for (index = 0; index < 256; index++) {
+      crc = (uint32Type) index;
+      crcC = (uint32Type) index;
+      bzip2Crc = (uint32Type) index << 24;
+      for (bit = 0; bit < 8; bit++) {
+        crc = (crc >> 1) ^ ((crc & 1) != 0 ? CRC32_POLYNOMIAL : 0);
+        crcC = (crcC >> 1) ^ ((crcC & 1) != 0 ? CRC32C_POLYNOMIAL : 0);
+        bzip2Crc = (bzip2Crc << 1) ^
+                   ((bzip2Crc & 0x80000000) != 0 ? BZIP2_CRC32_POLYNOMIAL : 0);
+      } /* for */
+      crc32Table[0][index] = crc;
+      crc32cTable[0][index] = crcC;
+      bzip2Crc32Table[0][index] = bzip2Crc;
+    } /* for */
+    for (slice = 1; slice < 8; slice++) {
+      for (index = 0; index < 256; index++) {
+        crc = crc32Table[slice - 1][index];
+        crc32Table[slice][index] = (crc >> 8) ^ crc32Table[0][crc & 0xff];
+        crc = crc32cTable[slice - 1][index];
+        crc32cTable[slice][index] = (crc >> 8) ^ crc32cTable[0][crc & 0xff];
+        crc = bzip2Crc32Table[slice - 1][index];
+        bzip2Crc32Table[slice][index] = (crc << 8) ^
+            bzip2Crc32Table[0][crc >> 24];
+      } /* for */
+    } /* for */
+    crcTablesInitialized = TRUE;
+  } /* initCrcTables */
+
+
+
+/**
+ *  Update a reflected CRC with the slicing-by-8 algorithm.
+ *  Eight bytes are processed with eight independent table lookups.
+ *  @param table Slicing tables of CRC-32 or CRC-32C.
+ *  @param crc Inverted CRC of the previous bytes.
+ */
+static uint32Type reflectedCrcSlicing8 (const uint32Type table[8][256],
+    uint32Type crc, const uint8Type *buffer, memSizeType length)
+
+  {
+    uint32Type low;
+    uint32Type high;
+
+  /* reflectedCrcSlicing8 */
+    for (; length >= 8; length -= 8) {
+      low = crc ^ ((uint32Type) buffer[0] |
+                   (uint32Type) buffer[1] << 8 |
+                   (uint32Type) buffer[2] << 16 |
+                   (uint32Type) buffer[3] << 24);
+      high = (uint32Type) buffer[4] |
+             (uint32Type) buffer[5] << 8 |
+             (uint32Type) buffer[6] << 16 |
+             (uint32Type) buffer[7] << 24;
+      crc = table[7][low & 0xff] ^
+            table[6][(low >> 8) & 0xff] ^
+            table[5][(low >> 16) & 0xff] ^
+            table[4][low >> 24] ^
+            table[3][high & 0xff] ^
+            table[2][(high >> 8) & 0xff] ^
+            table[1][(high >> 16) & 0xff] ^
+            table[0][high >> 24];
+      buffer += 8;
+    } /* for */
+    for (; length != 0; length--) {
+      crc = (crc >> 8) ^ table[0][(crc ^ *buffer) & 0xff];
+      buffer++;
+    } /* for */
+    return crc;
+  } /* reflectedCrcSlicing8 */
+
+
+
+/**
+ *  Update the CRC of bzip2 with the slicing-by-8 algorithm.
+ *  The bzip2 CRC shifts the bits to the left (it is not reflected).
+ *  @param crc Inverted CRC of the previous bytes.
+ */
+static uint32Type bzip2CrcSlicing8 (uint32Type crc, const uint8Type *buffer,
+    memSizeType length)
+
+  {
+    uint32Type low;
+    uint32Type high;
+
+  /* bzip2CrcSlicing8 */
+    for (; length >= 8; length -= 8) {
+      high = crc ^ ((uint32Type) buffer[0] << 24 |
+                    (uint32Type) buffer[1] << 16 |
+                    (uint32Type) buffer[2] << 8 |
+                    (uint32Type) buffer[3]);
+      low = (uint32Type) buffer[4] << 24 |
+            (uint32Type) buffer[5] << 16 |
+            (uint32Type) buffer[6] << 8 |
+            (uint32Type) buffer[7];
+      crc = bzip2Crc32Table[7][high >> 24] ^
+            bzip2Crc32Table[6][(high >> 16) & 0xff] ^
+            bzip2Crc32Table[5][(high >> 8) & 0xff] ^
+            bzip2Crc32Table[4][high & 0xff] ^
+            bzip2Crc32Table[3][low >> 24] ^
+            bzip2Crc32Table[2][(low >> 16) & 0xff] ^
+            bzip2Crc32Table[1][(low >> 8) & 0xff] ^
+            bzip2Crc32Table[0][low & 0xff];
+      buffer += 8;
+    } /* for */
+    for (; length != 0; length--) {
+      crc = (crc << 8) ^ bzip2Crc32Table[0][(crc >> 24) ^ *buffer];
+      buffer++;
+    } /* for */
+    return crc;
+  } /* bzip2CrcSlicing8 */
+
+
+
+#if HAS_PCLMUL_TARGET_ATTRIBUTE
+/**
+ *  Update a CRC-32 by folding 64 bytes per step with carry-less
+ *  multiplication (PCLMULQDQ). The remaining 128 bits are reduced
+ *  to 32 bits with a Barrett reduction. The constants are powers of
+ *  x modulo the CRC-32 polynomial (see the Intel paper "Fast CRC
+ *  Computation for Generic Polynomials Using PCLMULQDQ Instruction").
+ *  The function must only be called if __builtin_cpu_supports("pclmul")
+ *  and __builtin_cpu_supports("sse4.1") are TRUE.
+ *  @param crc Inverted CRC of the previous bytes.
+ *  @param length Number of bytes, at least CRC_CLMUL_MINIMUM.
+ *  @return the inverted CRC of the processed bytes. A remainder of
+ *          less than 16 bytes is not processed.
+ */
+__attribute__((target("pclmul,sse4.1")))
+static uint32Type crc32Clmul (uint32Type crc, const uint8Type *buffer,
+    memSizeType length)
+
+  {
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+
+  /* crc32Clmul */
+    x1 = _mm_loadu_si128((const __m128i *) &buffer[0x00]);
+    x2 = _mm_loadu_si128((const __m128i *) &buffer[0x10]);
+    x3 = _mm_loadu_si128((const __m128i *) &buffer[0x20]);
+    x4 = _mm_loadu_si128((const __m128i *) &buffer[0x30]);
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int) crc));
+    x0 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+    buffer += 64;
+    length -= 64;
+    /* Fold four 128-bit lanes in parallel. */
+    for (; length >= 64; length -= 64) {
+      x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+      x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+      x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+      x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+      x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+      x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+      x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+      x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+      x1 = _mm_xor_si128(_mm_xor_si128(x1, x5),
+          _mm_loadu_si128((const __m128i *) &buffer[0x00]));
+      x2 = _mm_xor_si128(_mm_xor_si128(x2, x6),
+          _mm_loadu_si128((const __m128i *) &buffer[0x10]));
+      x3 = _mm_xor_si128(_mm_xor_si128(x3, x7),
+          _mm_loadu_si128((const __m128i *) &buffer[0x20]));
+      x4 = _mm_xor_si128(_mm_xor_si128(x4, x8),
+          _mm_loadu_si128((const __m128i *) &buffer[0x30]));
+      buffer += 64;
+    } /* for */
+    /* Fold the four lanes into one. */
+    x0 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+    for (; length >= 16; length -= 16) {
+      x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+      x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+      x1 = _mm_xor_si128(_mm_xor_si128(x1, x5),
+          _mm_loadu_si128((const __m128i *) buffer));
+      buffer += 16;
+    } /* for */
+    /* Fold 128 bits to 64 bits. */
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x0 = _mm_set_epi64x(0, 0x0163cd6124);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, x3);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    /* Barrett reduction to 32 bits. */
+    x0 = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+    x2 = _mm_and_si128(x1, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    return (uint32Type) _mm_extract_epi32(x1, 1);
+  } /* crc32Clmul */
+#endif
+
+
+
+#if HAS_SSE42_TARGET_ATTRIBUTE
+/**
+ *  Update a CRC-32C with the crc32 instruction of SSE 4.2.
+ *  The function must only be called if
+ *  __builtin_cpu_supports("sse4.2") is TRUE.
+ *  @param crc Inverted CRC of the previous bytes.
+ */
+__attribute__((target("sse4.2")))
+static uint32Type crc32cSse42 (uint32Type crc, const uint8Type *buffer,
+    memSizeType length)
+
+  {
+    uint64Type crc64;
+    uint64Type word;
+
+  /* crc32cSse42 */
+    crc64 = crc;
+    for (; length >= 8; length -= 8) {
+      memcpy(&word, buffer, sizeof(uint64Type));
+      crc64 = _mm_crc32_u64(crc64, word);
+      buffer += 8;
+    } /* for */
+    crc = (uint32Type) crc64;
+    for (; length != 0; length--) {
+      crc = _mm_crc32_u8(crc, *buffer);
+      buffer++;
+    } /* for */
+    return crc;
+  } /* crc32cSse42 */
+#endif
+
+
+
+/**
+ *  Copy the lowest 8 bits of 'length' characters to 'buffer'.
+ */
+static void crcBytes (uint8Type *buffer, const strElemType *stri,
+    memSizeType length)
+
+  { /* crcBytes */
+    for (; length != 0; length--) {
+      *buffer = (uint8Type) *stri;
+      buffer++;
+      stri++;
+    } /* for */
+  } /* crcBytes */
+
+
+
+/**
+ *  Compute the CRC-32 of bzip2 of 'stri' continuing from 'oldCrc'.
+ *  The polynomial is 16#04c11db7 and the bits are shifted to the
+ *  left. Only the lowest 8 bits of every character are used.
+ *  @param oldCrc CRC of the preceding data or 0 at the start.
+ *  @return the CRC of the preceding data followed by 'stri'.
+ */
+uintType cmpBzip2Crc32 (const const_striType stri, uintType oldCrc)
+
+  {
+    uint8Type buffer[CRC_BUFFER_SIZE];
+    const strElemType *mem;
+    memSizeType remaining;
+    memSizeType chunkSize;
+    uint32Type crc;
+
+  /* cmpBzip2Crc32 */
+    logFunction(printf("cmpBzip2Crc32(\"%s\", " FMT_X32 ")\n",
+                       striAsUnquotedCStri(stri), (uint32Type) oldCrc););
+    if (unlikely(!crcTablesInitialized)) {
+      initCrcTables();
+    } /* if */
+    crc = ~(uint32Type) oldCrc;
+    mem = stri->mem;
+    for (remaining = stri->size; remaining != 0; remaining -= chunkSize) {
+      chunkSize = remaining > CRC_BUFFER_SIZE ? CRC_BUFFER_SIZE : remaining;
+      crcBytes(buffer, mem, chunkSize);
+      crc = bzip2CrcSlicing8(crc, buffer, chunkSize);
+      mem += chunkSize;
+    } /* for */
+    crc = ~crc;
+    logFunction(printf("cmpBzip2Crc32 --> " FMT_X32 "\n", crc););
+    return (uintType) crc;
+  } /* cmpBzip2Crc32 */
+
+
+
+/**
+ *  Compute the CRC-32 of 'stri' continuing from 'oldCrc'.
+ *  This is the CRC used by gzip, zip and PNG (polynomial
+ *  16#edb88320, reflected). If the CPU supports it the data is
+ *  folded with the PCLMULQDQ instruction. Otherwise the
+ *  slicing-by-8 algorithm is used. Only the lowest 8 bits of every
+ *  character are used.
+ *  @param oldCrc CRC of the preceding data or 0 at the start.
+ *  @return the CRC of the preceding data followed by 'stri'.
+ */
+uintType cmpCrc32 (const const_striType stri, uintType oldCrc)
+
+  {
+    uint8Type buffer[CRC_BUFFER_SIZE];
+    const strElemType *mem;
+    memSizeType remaining;
+    memSizeType chunkSize;
+    memSizeType folded;
+    uint32Type crc;
+
+  /* cmpCrc32 */
+    logFunction(printf("cmpCrc32(\"%s\", " FMT_X32 ")\n",
+                       striAsUnquotedCStri(stri), (uint32Type) oldCrc););
+    if (unlikely(!crcTablesInitialized)) {
+      initCrcTables();
+    } /* if */
+    crc = ~(uint32Type) oldCrc;
+    mem = stri->mem;
+    for (remaining = stri->size; remaining != 0; remaining -= chunkSize) {
+      chunkSize = remaining > CRC_BUFFER_SIZE ? CRC_BUFFER_SIZE : remaining;
+      crcBytes(buffer, mem, chunkSize);
+      folded = 0;
+#if HAS_PCLMUL_TARGET_ATTRIBUTE
+      if (chunkSize >= CRC_CLMUL_MINIMUM &&
+          __builtin_cpu_supports("pclmul") &&
+          __builtin_cpu_supports("sse4.1")) {
+        folded = chunkSize & ~(memSizeType) 15;
+        crc = crc32Clmul(crc, buffer, folded);
+      } /* if */
+#endif
+      crc = reflectedCrcSlicing8((const uint32Type (*)[256]) crc32Table,
+                                 crc, &buffer[folded], chunkSize - folded);
+      mem += chunkSize;
+    } /* for */
+    crc = ~crc;
+    logFunction(printf("cmpCrc32 --> " FMT_X32 "\n", crc););
+    return (uintType) crc;
+  } /* cmpCrc32 */
+
+
+
+/**
+ *  Compute the CRC-32C (Castagnoli) of 'stri' continuing from 'oldCrc'.
+ *  CRC-32C (polynomial 16#82f63b78, reflected) is used by iSCSI,
+ *  SCTP, ext4 and Btrfs. If the CPU supports SSE 4.2 its crc32
+ *  instruction is used. Otherwise the slicing-by-8 algorithm is
+ *  used. Only the lowest 8 bits of every character are used.
+ *  @param oldCrc CRC of the preceding data or 0 at the start.
+ *  @return the CRC of the preceding data followed by 'stri'.
+ */
+uintType cmpCrc32c (const const_striType stri, uintType oldCrc)
+
+  {
+    uint8Type buffer[CRC_BUFFER_SIZE];
+    const strElemType *mem;
+    memSizeType remaining;
+    memSizeType chunkSize;
+    uint32Type crc;
+
+  /* cmpCrc32c */
+    logFunction(printf("cmpCrc32c(\"%s\", " FMT_X32 ")\n",
+                       striAsUnquotedCStri(stri), (uint32Type) oldCrc););
+    if (unlikely(!crcTablesInitialized)) {
+      initCrcTables();
+    } /* if */
+    crc = ~(uint32Type) oldCrc;
+    mem = stri->mem;
+    for (remaining = stri->size; remaining != 0; remaining -= chunkSize) {
+      chunkSize = remaining > CRC_BUFFER_SIZE ? CRC_BUFFER_SIZE : remaining;
+      crcBytes(buffer, mem, chunkSize);
+#if HAS_SSE42_TARGET_ATTRIBUTE
+      if (__builtin_cpu_supports("sse4.2")) {
+        crc = crc32cSse42(crc, buffer, chunkSize);
+      } else {
+        crc = reflectedCrcSlicing8((const uint32Type (*)[256]) crc32cTable,
+                                   crc, buffer, chunkSize);
+      } /* if */
+#else
+      crc = reflectedCrcSlicing8((const uint32Type (*)[256]) crc32cTable,
+                                 crc, buffer, chunkSize);
+#endif
+      mem += chunkSize;
+    } /* for */
+    crc = ~crc;
+    logFunction(printf("cmpCrc32c --> " FMT_X32 "\n", crc););
+    return (uintType) crc;
+  } /* cmpCrc32c */
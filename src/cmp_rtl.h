@@ -0,0 +1,41 @@
+/********************************************************************/
+/*                                                                  */
+/*  cmp_rtl.h     Primitive actions for compression.                */
+/*  Copyright (C) 2026  agent                                       */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/cmp_rtl.h                                       */
+/*  Changes: 2026  agent                                            */
+/*  Content: Primitive actions for compression.                     */
+/*                                                                  */
+/********************************************************************/
+
+uintType cmpBzip2Crc32 (const const_striType stri, uintType oldCrc);
+uintType cmpCrc32 (const const_striType stri, uintType oldCrc);
+uintType cmpCrc32c (const const_striType stri, uintType oldCrc);
+striType cmpDeflate (const const_striType window, const const_striType uncompressed,
+    intType level, boolType bfinal);
+boolType cmpLzmaDecode (striType *const lzmaState, striType *const compressed,
+    boolType inputFinished, striType *const uncompressed, intType maxLength,
+    intType dictionarySize);
+void cmpZstdDecodeBlock (striType *const uncompressed, striType *const zstdState,
+    const const_striType block, intType windowSize);
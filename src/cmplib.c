@@ -0,0 +1,185 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  agent                                       */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/cmplib.c                                        */
+/*  Changes: 2026  agent                                            */
+/*  Content: All primitive actions for compression.                 */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+
+#include "common.h"
+#include "data.h"
+#include "heaputl.h"
+#include "syvarutl.h"
+#include "objutl.h"
+#include "runerr.h"
+#include "cmp_rtl.h"
+
+#undef EXTERN
+#define EXTERN
+#include "cmplib.h"
+
+
+
+/**
+ *  Compute the CRC-32 of bzip2 of 'stri' (arg_1) continuing from
+ *  'oldCrc' (arg_2). Only the lowest 8 bits of every character are used.
+ *  @return the CRC of the preceding data followed by 'stri'.
+ */
+objectType cmp_bzip2_crc32 (listType arguments)
+
+  { /* cmp_bzip2_crc32 */
+    isit_stri(arg_1(arguments));
+    isit_binary(arg_2(arguments));
+    return bld_binary_temp(
+        cmpBzip2Crc32(take_stri(arg_1(arguments)),
+                      take_binary(arg_2(arguments))));
+  } /* cmp_bzip2_crc32 */
+
+
+
+/**
+ *  Compute the CRC-32 of 'stri' (arg_1) continuing from 'oldCrc' (arg_2).
+ *  This is the CRC used by gzip, zip and PNG. Only the lowest 8 bits
+ *  of every character are used.
+ *  @return the CRC of the preceding data followed by 'stri'.
+ */
+objectType cmp_crc32 (listType arguments)
+
+  { /* cmp_crc32 */
+    isit_stri(arg_1(arguments));
+    isit_binary(arg_2(arguments));
+    return bld_binary_temp(
+        cmpCrc32(take_stri(arg_1(arguments)),
+                 take_binary(arg_2(arguments))));
+  } /* cmp_crc32 */
+
+
+
+/**
+ *  Compute the CRC-32C (Castagnoli) of 'stri' (arg_1) continuing from
+ *  'oldCrc' (arg_2). Only the lowest 8 bits of every character are used.
+ *  @return the CRC of the preceding data followed by 'stri'.
+ */
+objectType cmp_crc32c (listType arguments)
+
+  { /* cmp_crc32c */
+    isit_stri(arg_1(arguments));
+    isit_binary(arg_2(arguments));
+    return bld_binary_temp(
+        cmpCrc32c(take_stri(arg_1(arguments)),
+                  take_binary(arg_2(arguments))));
+  } /* cmp_crc32c */
+
+
+
+/**
+ *  Compress a string with the DEFLATE algorithm (RFC 1951).
+ *  Matches may refer to the last 32768 characters of 'window'.
+ *  @return the compressed data as string of bytes.
+ *  @exception RANGE_ERROR If 'level' is not in the range 0 to 9 or
+ *             if a character in 'window' or 'uncompressed' is
+ *             beyond '\255;'.
+ *  @exception MEMORY_ERROR Not enough memory to compress the data.
+ */
+objectType cmp_deflate (listType arguments)
+
+  { /* cmp_deflate */
+    isit_stri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    isit_bool(arg_4(arguments));
+    return bld_stri_temp(
+        cmpDeflate(take_stri(arg_1(arguments)), take_stri(arg_2(arguments)),
+                   take_int(arg_3(arguments)),
+                   take_bool(arg_4(arguments)) == SYS_TRUE_OBJECT));
+  } /* cmp_deflate */
+
+
+
+/**
+ *  Decode LZMA or LZMA2 compressed data incrementally.
+ *  Bytes are consumed from the front of 'compressed' (arg_2) and at
+ *  most 'maxLength' (arg_5) characters are appended to 'uncompressed'
+ *  (arg_4). Matches reach back at most 'dictionarySize' (arg_6)
+ *  characters.
+ *  @return TRUE if the end of the stream has been reached,
+ *          FALSE otherwise.
+ *  @exception RANGE_ERROR If the data is corrupt or truncated.
+ *  @exception MEMORY_ERROR Not enough memory to decode the data.
+ */
+objectType cmp_lzma_decode (listType arguments)
+
+  { /* cmp_lzma_decode */
+    isit_stri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    isit_bool(arg_3(arguments));
+    isit_stri(arg_4(arguments));
+    isit_int(arg_5(arguments));
+    isit_int(arg_6(arguments));
+    is_variable(arg_1(arguments));
+    is_variable(arg_2(arguments));
+    is_variable(arg_4(arguments));
+    if (cmpLzmaDecode(&arg_1(arguments)->value.striValue,
+                      &arg_2(arguments)->value.striValue,
+                      take_bool(arg_3(arguments)) == SYS_TRUE_OBJECT,
+                      &arg_4(arguments)->value.striValue,
+                      take_int(arg_5(arguments)),
+                      take_int(arg_6(arguments)))) {
+      return SYS_TRUE_OBJECT;
+    } else {
+      return SYS_FALSE_OBJECT;
+    } /* if */
+  } /* cmp_lzma_decode */
+
+
+
+/**
+ *  Decode a compressed block of a Zstandard frame (RFC 8878).
+ *  The decoded data is appended to 'uncompressed' (arg_1). The state
+ *  'zstdState' (arg_2) is carried from block to block. Matches reach
+ *  back at most 'windowSize' (arg_4) characters.
+ *  @exception RANGE_ERROR If the block is corrupt.
+ *  @exception MEMORY_ERROR Not enough memory to decode the block.
+ */
+objectType cmp_zstd_decode_block (listType arguments)
+
+  { /* cmp_zstd_decode_block */
+    isit_stri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    isit_stri(arg_3(arguments));
+    isit_int(arg_4(arguments));
+    is_variable(arg_1(arguments));
+    is_variable(arg_2(arguments));
+    cmpZstdDecodeBlock(&arg_1(arguments)->value.striValue,
+                       &arg_2(arguments)->value.striValue,
+                       take_stri(arg_3(arguments)),
+                       take_int(arg_4(arguments)));
+    return SYS_EMPTY_OBJECT;
+  } /* cmp_zstd_decode_block */
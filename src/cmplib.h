@@ -0,0 +1,33 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  agent                                       */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/cmplib.h                                        */
+/*  Changes: 2026  agent                                            */
+/*  Content: All primitive actions for compression.                 */
+/*                                                                  */
+/********************************************************************/
+
+objectType cmp_bzip2_crc32 (listType arguments);
+objectType cmp_crc32 (listType arguments);
+objectType cmp_crc32c (listType arguments);
+objectType cmp_deflate (listType arguments);
+objectType cmp_lzma_decode (listType arguments);
+objectType cmp_zstd_decode_block (listType arguments);
@@ -148,6 +148,31 @@ typedef struct {
 
 static consoleType con = NULL;
 
+/* In frame mode the functions that change the console only    */
+/* update con. The escape sequences necessary to change the    */
+/* terminal from shown (what it currently displays) to con are */
+/* computed by conFlush() and written with one write() call.   */
+static boolType frame_mode = FALSE;
+static consoleType shown = NULL;
+static boolType repaint_screen = FALSE;
+static int shown_line = -1;
+static int shown_column = -1;
+static char *frame_buffer = NULL;
+static memSizeType frame_size = 0;
+static memSizeType frame_capacity = 0;
+static boolType frame_buffer_failed = FALSE;
+
+#define FRAME_BUFFER_INCREMENT 4096
+/* Unchanged gaps shorter than this are rewritten instead of */
+/* moving the cursor, since a cursor motion is not cheaper. */
+#define FRAME_MAX_GAP 8
+#define FRAME_MIN_CLEAR 4
+#define isInverse(attr) ((attr) == TEXT_INVERSE)
+#define sameCell(pos) (new_line[pos] == old_line[pos] && \
+                       isInverse(new_attr[pos]) == isInverse(old_attr[pos]))
+#define frameCtl(s) ((s) != NULL ? tputs((s), 1, frame_outch) : 0)
+#define frameGoto(s,x,y) ((s) != NULL ? tputs(tgoto((s), (x), (y)), 1, frame_outch) : 0)
+
 
 
 static void strelem_fwrite (const strElemType *stri, memSizeType length,
@@ -293,6 +318,19 @@ static void resize_console (void)
       con->width = width;
     } /* if */
     con->size_changed = FALSE;
+    if (frame_mode) {
+      /* The content of the resized terminal is unknown. */
+      free_console(shown);
+      shown = create_console(con->line_capacity, con->column_capacity);
+      if (shown == NULL) {
+        frame_mode = FALSE;
+      } else {
+        shown->height = con->height;
+        shown->width = con->width;
+      } /* if */
+      frame_size = 0;
+      repaint_screen = TRUE;
+    } /* if */
   } /* resize_console */
 
 
@@ -337,6 +375,378 @@ static void setattr (unsigned char attribute)
 
 
 
+static boolType frame_reserve (memSizeType length)
+
+  {
+    memSizeType new_capacity;
+    char *new_buffer;
+    boolType okay = TRUE;
+
+  /* frame_reserve */
+    if (frame_capacity - frame_size < length) {
+      new_capacity = frame_size + length + FRAME_BUFFER_INCREMENT;
+      new_buffer = (char *) realloc(frame_buffer, (size_t) new_capacity);
+      if (unlikely(new_buffer == NULL)) {
+        frame_buffer_failed = TRUE;
+        okay = FALSE;
+      } else {
+        frame_buffer = new_buffer;
+        frame_capacity = new_capacity;
+      } /* if */
+    } /* if */
+    return okay;
+  } /* frame_reserve */
+
+
+
+#ifdef USE_TERMCAP
+static int frame_outch (char ch)
+#else
+static int frame_outch (int ch)
+#endif
+
+  { /* frame_outch */
+    if (frame_size < frame_capacity || frame_reserve(1)) {
+      frame_buffer[frame_size] = (char) ch;
+      frame_size++;
+    } /* if */
+    return ch;
+  } /* frame_outch */
+
+
+
+static void frame_chars (const strElemType *stri, memSizeType length)
+
+  { /* frame_chars */
+    if (frame_reserve(max_utf8_size(length))) {
+      frame_size += stri_to_utf8((ustriType) &frame_buffer[frame_size],
+                                 stri, length);
+    } /* if */
+  } /* frame_chars */
+
+
+
+static void frame_setattr (boolType inverse)
+
+  { /* frame_setattr */
+    if (inverse) {
+      if (enter_reverse_mode != NULL) {
+        frameCtl(enter_reverse_mode);
+      } else {
+        frameCtl(enter_standout_mode);
+      } /* if */
+    } else {
+      frameCtl(exit_standout_mode);
+    } /* if */
+  } /* frame_setattr */
+
+
+
+/**
+ *  Moves the terminal cursor to line and column (both zero based).
+ *  Nothing is written if the terminal cursor is already there.
+ */
+static void frame_move (int line, int column)
+
+  { /* frame_move */
+    if (shown_line != line || shown_column != column) {
+      if (column == 0 && shown_line != -1 && carriage_return != NULL &&
+          (line == shown_line ||
+          (line == shown_line + 1 && cursor_down != NULL))) {
+        frameCtl(carriage_return); /* cursor return */
+        if (line != shown_line) {
+          frameCtl(cursor_down); /* cursor down */
+        } /* if */
+      } else {
+        frameGoto(cursor_address, column, line); /* cursor motion */
+      } /* if */
+      shown_line = line;
+      shown_column = column;
+    } /* if */
+  } /* frame_move */
+
+
+
+/**
+ *  Sets the area described by startlin, stoplin, startcol and stopcol
+ *  of area_con to spaces with the given attribute.
+ */
+static void clear_area (consoleType area_con, int startlin, int startcol,
+    int stoplin, int stopcol, unsigned char attribute)
+
+  {
+    int line;
+
+  /* clear_area */
+    for (line = startlin - 1; line < stoplin; line++) {
+      memset_to_strelem(&area_con->chars[line][startcol - 1], ' ',
+          (memSizeType) (stopcol - startcol + 1));
+      memset(&area_con->attributes[line][startcol - 1], attribute,
+          (unsigned int) (stopcol - startcol + 1));
+    } /* for */
+  } /* clear_area */
+
+
+
+/**
+ *  Scrolls the full width lines from startlin to stoplin of the
+ *  terminal by numLines lines. A scroll region is used if the
+ *  terminal supports it. Otherwise lines are deleted and inserted.
+ *  The escape sequences are added to the frame buffer and the
+ *  same scrolling is done with shown. If the terminal cannot
+ *  scroll nothing is done and conFlush() redraws the lines.
+ */
+static void frame_scroll (int startlin, int stoplin, int numLines,
+    boolType upward)
+
+  {
+    char *scroll_cap;
+    boolType scrolled = FALSE;
+    int number;
+    int line;
+
+  /* frame_scroll */
+    if (upward) {
+      scroll_cap = scroll_forward;
+    } else {
+      scroll_cap = scroll_reverse;
+    } /* if */
+    if (!repaint_screen && numLines <= stoplin - startlin) {
+      if (change_scroll_region != NULL && scroll_cap != NULL) {
+        frameGoto(change_scroll_region, stoplin - 1, startlin - 1);
+        if (upward) {
+          frameGoto(cursor_address, 0, stoplin - 1); /* cursor motion */
+        } else {
+          frameGoto(cursor_address, 0, startlin - 1); /* cursor motion */
+        } /* if */
+        for (number = 1; number <= numLines; number++) {
+          frameCtl(scroll_cap);
+        } /* for */
+        frameGoto(change_scroll_region, shown->height - 1, 0);
+        scrolled = TRUE;
+      } else if (insert_line != NULL && delete_line != NULL) {
+        if (upward) {
+          frameGoto(cursor_address, 0, startlin - 1); /* cursor motion */
+        } else {
+          frameGoto(cursor_address, 0, stoplin - numLines); /* cursor motion */
+        } /* if */
+        for (number = 1; number <= numLines; number++) {
+          frameCtl(delete_line); /* delete line */
+        } /* for */
+        if (upward) {
+          frameGoto(cursor_address, 0, stoplin - numLines); /* cursor motion */
+        } else {
+          frameGoto(cursor_address, 0, startlin - 1); /* cursor motion */
+        } /* if */
+        for (number = 1; number <= numLines; number++) {
+          frameCtl(insert_line); /* insert line */
+        } /* for */
+        scrolled = TRUE;
+      } /* if */
+    } /* if */
+    if (scrolled) {
+      shown_line = -1;
+      if (upward) {
+        for (line = startlin - 1; line < stoplin - numLines; line++) {
+          memcpy(shown->chars[line], shown->chars[line + numLines],
+              sizeof(strElemType) * (unsigned int) shown->width);
+          memcpy(shown->attributes[line], shown->attributes[line + numLines],
+              (unsigned int) shown->width);
+        } /* for */
+        clear_area(shown, stoplin - numLines + 1, 1,
+                   stoplin, shown->width, TEXT_NORMAL);
+      } else {
+        for (line = stoplin - 1; line >= startlin + numLines - 1; line--) {
+          memcpy(shown->chars[line], shown->chars[line - numLines],
+              sizeof(strElemType) * (unsigned int) shown->width);
+          memcpy(shown->attributes[line], shown->attributes[line - numLines],
+              (unsigned int) shown->width);
+        } /* for */
+        clear_area(shown, startlin, 1,
+                   startlin + numLines - 1, shown->width, TEXT_NORMAL);
+      } /* if */
+    } /* if */
+  } /* frame_scroll */
+
+
+
+/**
+ *  Adds the escape sequences, which change a line of the terminal
+ *  from shown to con, to the frame buffer. Short unchanged gaps are
+ *  rewritten instead of moving the cursor. A blank end of the line
+ *  is cleared with clr_eol. Attribute changes are only written at
+ *  the start and end of a run of inverse characters.
+ */
+static void frame_line (int line)
+
+  {
+    strElemType *new_line;
+    unsigned char *new_attr;
+    strElemType *old_line;
+    unsigned char *old_attr;
+    int start_pos;
+    int end_pos;
+    int clear_pos;
+    int stop_pos;
+    int seg_end;
+    int run_end;
+    int scan;
+    int gap_start;
+    boolType inverse;
+
+  /* frame_line */
+    new_line = con->chars[line];
+    new_attr = con->attributes[line];
+    old_line = shown->chars[line];
+    old_attr = shown->attributes[line];
+    end_pos = con->width - 1;
+    while (end_pos >= 0 && sameCell(end_pos)) {
+      end_pos--;
+    } /* while */
+    if (end_pos >= 0) {
+      start_pos = 0;
+      while (sameCell(start_pos)) {
+        start_pos++;
+      } /* while */
+      clear_pos = con->width;
+      if (clr_eol != NULL) {
+        while (clear_pos > start_pos && new_line[clear_pos - 1] == ' ' &&
+            !isInverse(new_attr[clear_pos - 1])) {
+          clear_pos--;
+        } /* while */
+        if (end_pos - clear_pos + 1 < FRAME_MIN_CLEAR) {
+          clear_pos = con->width;
+        } /* if */
+      } /* if */
+      if (clear_pos <= end_pos) {
+        stop_pos = clear_pos - 1;
+      } else {
+        stop_pos = end_pos;
+      } /* if */
+      scan = start_pos;
+      while (scan <= stop_pos) {
+        start_pos = scan;
+        seg_end = start_pos;
+        scan++;
+        while (scan <= stop_pos) {
+          if (!sameCell(scan)) {
+            seg_end = scan;
+            scan++;
+          } else {
+            gap_start = scan;
+            while (scan <= stop_pos && sameCell(scan)) {
+              scan++;
+            } /* while */
+            if (scan > stop_pos || scan - gap_start >= FRAME_MAX_GAP) {
+              break;
+            } /* if */
+          } /* if */
+        } /* while */
+        frame_move(line, start_pos);
+        run_end = start_pos;
+        while (run_end <= seg_end) {
+          inverse = isInverse(new_attr[run_end]);
+          if (inverse) {
+            frame_setattr(TRUE);
+          } /* if */
+          start_pos = run_end;
+          do {
+            run_end++;
+          } while (run_end <= seg_end &&
+                   isInverse(new_attr[run_end]) == inverse);
+          frame_chars(&new_line[start_pos],
+              (memSizeType) (run_end - start_pos));
+          if (inverse) {
+            frame_setattr(FALSE);
+          } /* if */
+        } /* while */
+        shown_column = seg_end + 1;
+        if (shown_column >= con->width) {
+          /* The position after the last column is unreliable. */
+          shown_line = -1;
+        } /* if */
+      } /* while */
+      if (clear_pos <= end_pos) {
+        frame_move(line, clear_pos);
+        frameCtl(clr_eol); /* clear to end of line */
+      } /* if */
+      memcpy(old_line, new_line,
+          sizeof(strElemType) * (unsigned int) con->width);
+      memcpy(old_attr, new_attr, (unsigned int) con->width);
+    } /* if */
+  } /* frame_line */
+
+
+
+static void frame_write (void)
+
+  {
+    memSizeType position = 0;
+    ssize_t bytes_written;
+
+  /* frame_write */
+    fflush(stdout);
+    while (position < frame_size) {
+      bytes_written = write(fileno(stdout), &frame_buffer[position],
+                            (size_t) (frame_size - position));
+      if (bytes_written >= 0) {
+        position += (memSizeType) bytes_written;
+      } else if (errno != EINTR) {
+        logError(printf("frame_write: write(%d, *, " FMT_U_MEM ") failed:\n"
+                        "errno=%d\nerror: %s\n",
+                        fileno(stdout), frame_size - position,
+                        errno, strerror(errno)););
+        repaint_screen = TRUE;
+        raise_error(FILE_ERROR);
+        position = frame_size;
+      } /* if */
+    } /* while */
+    frame_size = 0;
+  } /* frame_write */
+
+
+
+/**
+ *  Writes the differences between con and shown to the terminal.
+ *  All escape sequences, including the ones of the scrolling done
+ *  since the last flush, are written with one write() call.
+ */
+static void frame_flush (void)
+
+  {
+    int line;
+
+  /* frame_flush */
+    if (repaint_screen) {
+      frame_size = 0;
+      frameCtl(clear_screen); /* clear screen */
+      clear_area(shown, 1, 1, shown->height, shown->width, TEXT_NORMAL);
+      shown_line = 0;
+      shown_column = 0;
+      repaint_screen = FALSE;
+    } /* if */
+    for (line = 0; line < con->height; line++) {
+      frame_line(line);
+    } /* for */
+    if (!cursor_on) {
+      if (cursor_invisible == NULL) {
+        frame_move(0, 0);
+      } /* if */
+    } else {
+      frame_move(cursor_line - 1, cursor_column - 1);
+    } /* if */
+    if (unlikely(frame_buffer_failed)) {
+      frame_buffer_failed = FALSE;
+      frame_size = 0;
+      repaint_screen = TRUE;
+      raise_error(MEMORY_ERROR);
+    } else {
+      frame_write();
+    } /* if */
+  } /* frame_flush */
+
+
+
 static void inf_setcolor (intType foreground, intType background)
 
   { /* inf_setcolor */
@@ -433,7 +843,9 @@ void conFlush (void)
       if (con->size_changed) {
         resize_console();
       } /* if */
-      if (!cursor_on) {
+      if (frame_mode) {
+        frame_flush();
+      } else if (!cursor_on) {
         if (cursor_invisible == NULL) {
           putgoto(cursor_address, 0, 0); /* cursor motion */
           cursor_position_okay = FALSE;
@@ -556,31 +968,33 @@ static void doWrite (const strElemType *stri, memSizeType length)
           if (start_pos <= end_pos) {
             memcpy(&new_line[start_pos], &stri[start_pos],
                    sizeof(strElemType) * (unsigned int) (end_pos - start_pos + 1));
-            if (cursor_position_okay) {
-              start_pos = 0;
-            } else {
-              /* cursor motion */
-              putgoto(cursor_address, cursor_column + start_pos - 1, cursor_line - 1);
-            } /* if */
-            if (ceol_standout_glitch) {
-              for (position = 0; position <= end_pos - start_pos; position++) {
-                if (new_attr[start_pos + position] != curr_attr) {
+            if (!frame_mode) {
+              if (cursor_position_okay) {
+                start_pos = 0;
+              } else {
+                /* cursor motion */
+                putgoto(cursor_address, cursor_column + start_pos - 1, cursor_line - 1);
+              } /* if */
+              if (ceol_standout_glitch) {
+                for (position = 0; position <= end_pos - start_pos; position++) {
+                  if (new_attr[start_pos + position] != curr_attr) {
+                    setattr(curr_attr);
+                  } /* if */
+                  strelem_fwrite(&new_line[start_pos + position], 1, stdout);
+                } /* for */
+                if (cursor_column + end_pos < con->width &&
+                    new_attr[end_pos + 1] != curr_attr) {
+                  setattr(new_attr[end_pos + 1]);
+                } /* if */
+              } else {
+                if (curr_attr != TEXT_NORMAL) {
                   setattr(curr_attr);
                 } /* if */
-                strelem_fwrite(&new_line[start_pos + position], 1, stdout);
-              } /* for */
-              if (cursor_column + end_pos < con->width &&
-                  new_attr[end_pos + 1] != curr_attr) {
-                setattr(new_attr[end_pos + 1]);
-              } /* if */
-            } else {
-              if (curr_attr != TEXT_NORMAL) {
-                setattr(curr_attr);
-              } /* if */
-              strelem_fwrite(&new_line[start_pos],
-                  (unsigned int) (end_pos - start_pos + 1), stdout);
-              if (curr_attr != TEXT_NORMAL) {
-                setattr(TEXT_NORMAL);
+                strelem_fwrite(&new_line[start_pos],
+                    (unsigned int) (end_pos - start_pos + 1), stdout);
+                if (curr_attr != TEXT_NORMAL) {
+                  setattr(TEXT_NORMAL);
+                } /* if */
               } /* if */
             } /* if */
             memset(&new_attr[start_pos], curr_attr,
@@ -684,7 +1098,10 @@ static void doClear (int startlin, int startcol,
   /* doClear */
     log2Function(fprintf(stderr, "doClear(%d, %d, %d, %d)\n",
                          startlin, startcol, stoplin, stopcol););
-    if (startlin == 1 && stoplin == con->height &&
+    if (frame_mode) {
+      /* Cleared lines are written with clr_eol by conFlush(). */
+      clear_area(con, startlin, startcol, stoplin, stopcol, curr_attr);
+    } else if (startlin == 1 && stoplin == con->height &&
         startcol == 1 && stopcol == con->width && clear_screen != NULL) {
       putctl(clear_screen); /* clear screen */
       for (line = 0; line < stoplin; line++) {
@@ -800,7 +1217,21 @@ static void doUpScroll (int startlin, int startcol,
     if (numLines > stoplin - startlin + 1) {
       numLines = stoplin - startlin + 1;
     } /* if */
-    if ((insert_line == NULL && parm_insert_line == NULL) ||
+    if (frame_mode) {
+      if (startcol == 1 && stopcol == con->width) {
+        frame_scroll(startlin, stoplin, numLines, TRUE);
+      } /* if */
+      for (line = startlin - 1; line < stoplin - numLines; line++) {
+        memcpy(&con->chars[line][startcol - 1],
+            &con->chars[line + numLines][startcol - 1],
+            sizeof(strElemType) * (unsigned int) (stopcol - startcol + 1));
+        memcpy(&con->attributes[line][startcol - 1],
+            &con->attributes[line + numLines][startcol - 1],
+            (unsigned int) (stopcol - startcol + 1));
+      } /* for */
+      clear_area(con, stoplin - numLines + 1, startcol,
+                 stoplin, stopcol, curr_attr);
+    } else if ((insert_line == NULL && parm_insert_line == NULL) ||
         (delete_line == NULL && parm_delete_line == NULL) ||
         startcol != 1 || stopcol != con->width) {
       for (line = startlin - 1; line < stoplin - numLines; line++) {
@@ -959,7 +1390,21 @@ static void doDownScroll (int startlin, int startcol,
     if (numLines > stoplin - startlin + 1) {
       numLines = stoplin - startlin + 1;
     } /* if */
-    if ((insert_line == NULL && parm_insert_line == NULL) ||
+    if (frame_mode) {
+      if (startcol == 1 && stopcol == con->width) {
+        frame_scroll(startlin, stoplin, numLines, FALSE);
+      } /* if */
+      for (line = stoplin - 1; line >= startlin + numLines - 1; line--) {
+        memcpy(&con->chars[line][startcol - 1],
+            &con->chars[line - numLines][startcol - 1],
+            sizeof(strElemType) * (unsigned int) (stopcol - startcol + 1));
+        memcpy(&con->attributes[line][startcol - 1],
+            &con->attributes[line - numLines][startcol - 1],
+            (unsigned int) (stopcol - startcol + 1));
+      } /* for */
+      clear_area(con, startlin, startcol,
+                 startlin + numLines - 1, stopcol, curr_attr);
+    } else if ((insert_line == NULL && parm_insert_line == NULL) ||
         (delete_line == NULL && parm_delete_line == NULL) ||
         startcol != 1 || stopcol != con->width) {
       for (line = stoplin - 1; line >= startlin + numLines - 1; line--) {
@@ -1112,7 +1557,18 @@ static void doLeftScroll (int startlin, int startcol,
     strElemType *old_line;
 
   /* doLeftScroll */
-    if (0 && delete_character != NULL && (insert_character != NULL ||
+    if (frame_mode) {
+      if (numCols > stopcol - startcol + 1) {
+        numCols = stopcol - startcol + 1;
+      } /* if */
+      for (line = startlin - 1; line < stoplin; line++) {
+        memmove(&con->chars[line][startcol - 1],
+            &con->chars[line][startcol + numCols - 1],
+            sizeof(strElemType) * (unsigned int) (stopcol - startcol - numCols + 1));
+        memset_to_strelem(&con->chars[line][stopcol - numCols], ' ',
+            (memSizeType) numCols);
+      } /* for */
+    } else if (0 && delete_character != NULL && (insert_character != NULL ||
         (enter_insert_mode != NULL && exit_insert_mode != NULL))) {
       putgoto(cursor_address, startcol - 1, startlin - 1); /* cursor motion */
       for (line = startlin - 1; line < stoplin; line++) {
@@ -1261,7 +1717,18 @@ static void doRightScroll (int startlin, int startcol,
     strElemType *old_line;
 
   /* doRightScroll */
-    if (0 && delete_character != NULL && (insert_character != NULL ||
+    if (frame_mode) {
+      if (numCols > stopcol - startcol + 1) {
+        numCols = stopcol - startcol + 1;
+      } /* if */
+      for (line = startlin - 1; line < stoplin; line++) {
+        memmove(&con->chars[line][startcol + numCols - 1],
+            &con->chars[line][startcol - 1],
+            sizeof(strElemType) * (unsigned int) (stopcol - startcol - numCols + 1));
+        memset_to_strelem(&con->chars[line][startcol - 1], ' ',
+            (memSizeType) numCols);
+      } /* for */
+    } else if (0 && delete_character != NULL && (insert_character != NULL ||
         (enter_insert_mode != NULL && exit_insert_mode != NULL))) {
       putgoto(cursor_address, stopcol - numCols, startlin - 1); /* cursor motion */
       for (line = startlin - 1; line < stoplin; line++) {
@@ -1402,10 +1869,18 @@ void conShut (void)
 
   { /* conShut */
     if (console_initialized) {
+      frame_size = 0;
       putgoto(cursor_address, 0, con->height - 1); /* cursor motion */
       putctl(cursor_normal); /* cursor normal */
       putctl(clear_screen); /* clear screen */
       putctl(exit_ca_mode); /* end cursor addressing mode */
+      free_console(shown);
+      shown = NULL;
+      frame_mode = FALSE;
+      free(frame_buffer);
+      frame_buffer = NULL;
+      frame_capacity = 0;
+      frame_buffer_failed = FALSE;
       console_initialized = FALSE;
     } /* if */
   } /* conShut */
@@ -1425,6 +1900,23 @@ static void handle_winch_signal (int sig_num)
 
 
 
+/**
+ *  Determine if the console should be used in frame mode.
+ *  Frame mode is used if the environment variable
+ *  SEED7_CONSOLE_FRAMES is set to a value other than 0.
+ */
+static boolType use_frame_mode (void)
+
+  {
+    const char *frames;
+
+  /* use_frame_mode */
+    frames = getenv("SEED7_CONSOLE_FRAMES");
+    return frames != NULL && frames[0] != '\0' && strcmp(frames, "0") != 0;
+  } /* use_frame_mode */
+
+
+
 /**
  *  Initializes and clears the console.
  */
@@ -1452,6 +1944,13 @@ int conOpen (void)
           putctl(enter_ca_mode); /* enter cursor addressing mode */
           putctl(cursor_invisible); /* makes cursor invisible */
           putctl(clear_screen); /* clear screen */
+          frame_mode = use_frame_mode();
+          if (frame_mode) {
+            shown = create_console(lines, columns);
+            frame_mode = shown != NULL;
+            shown_line = -1;
+            repaint_screen = FALSE;
+          } /* if */
           cursor_on = FALSE;
           inf_normalcolour();
           cursor_position_okay = FALSE;
@@ -0,0 +1,1195 @@
+/********************************************************************/
+/*                                                                  */
+/*  cry_rtl.c     Primitive actions for cryptography.               */
+/*  Copyright (C) 2026  agent                                       */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/cry_rtl.c                                       */
+/*  Changes: 2026  agent                                            */
+/*  Content: Primitive actions for cryptography.                    */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#if HAS_AES_TARGET_ATTRIBUTE || HAS_PCLMUL_TARGET_ATTRIBUTE
+#include "immintrin.h"
+#endif
+
+#include "common.h"
+#include "heaputl.h"
+#include "striutl.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#include "cry_rtl.h"
+
+
+#define AES_BLOCK_SIZE   16
+#define AES_MAX_ROUNDS   14
+#define CRY_BUFFER_SIZE  4096  /* Must be a multiple of AES_BLOCK_SIZE */
+
+typedef struct {
+    unsigned int rounds;
+    /* Round keys as little endian words (AES-NI byte order). */
+    uint32Type roundKey[4 * (AES_MAX_ROUNDS + 1)];
+    /* Round keys in the bitsliced representation of aesCtEncrypt(). */
+    uint32Type slicedKey[8 * (AES_MAX_ROUNDS + 1)];
+  } aesKeyType;
+
+typedef enum {AES_CBC_ENCRYPT, AES_CBC_DECRYPT, AES_CTR} aesModeType;
+
+/* If FALSE the portable implementations are used, even if the CPU */
+/* supports AES-NI and PCLMULQDQ. See crySetAcceleration().         */
+static boolType accelerationAllowed = TRUE;
+
+
+
+static inline uint32Type getUint32Le (const uint8Type *bytes)
+
+  { /* getUint32Le */
+    return (uint32Type) bytes[0] |
+           (uint32Type) bytes[1] << 8 |
+           (uint32Type) bytes[2] << 16 |
+           (uint32Type) bytes[3] << 24;
+  } /* getUint32Le */
+
+
+
+static inline void putUint32Le (uint8Type *bytes, uint32Type word)
+
+  { /* putUint32Le */
+    bytes[0] = (uint8Type) word;
+    bytes[1] = (uint8Type) (word >> 8);
+    bytes[2] = (uint8Type) (word >> 16);
+    bytes[3] = (uint8Type) (word >> 24);
+  } /* putUint32Le */
+
+
+
+static inline uint64Type getUint64Be (const uint8Type *bytes)
+
+  { /* getUint64Be */
+    return (uint64Type) bytes[0] << 56 | (uint64Type) bytes[1] << 48 |
+           (uint64Type) bytes[2] << 40 | (uint64Type) bytes[3] << 32 |
+           (uint64Type) bytes[4] << 24 | (uint64Type) bytes[5] << 16 |
+           (uint64Type) bytes[6] <<  8 | (uint64Type) bytes[7];
+  } /* getUint64Be */
+
+
+
+static inline void putUint64Be (uint8Type *bytes, uint64Type word)
+
+  {
+    int index;
+
+  /* putUint64Be */
+    for (index = 7; index >= 0; index--) {
+      bytes[index] = (uint8Type) word;
+      word >>= 8;
+    } /* for */
+  } /* putUint64Be */
+
+
+
+/**
+ *  Transpose between the byte and the bitsliced representation.
+ *  In the bitsliced representation q[n] contains bit n of all 32
+ *  bytes of two AES blocks. The transformation is its own inverse.
+ */
+static void aesCtOrtho (uint32Type *q)
+
+  {
+    int index;
+    uint32Type a;
+    uint32Type b;
+
+  /* aesCtOrtho */
+#define SWAP_BITS(x, y, mask, shift) \
+    a = (x); b = (y); \
+    (x) = (a & (mask)) | ((b & (mask)) << (shift)); \
+    (y) = ((a >> (shift)) & (mask)) | (b & ~(uint32Type) (mask));
+    for (index = 0; index < 8; index += 2) {
+      SWAP_BITS(q[index], q[index + 1], 0x55555555, 1);
+    } /* for */
+    for (index = 0; index < 8; index += 4) {
+      SWAP_BITS(q[index],     q[index + 2], 0x33333333, 2);
+      SWAP_BITS(q[index + 1], q[index + 3], 0x33333333, 2);
+    } /* for */
+    for (index = 0; index < 4; index++) {
+      SWAP_BITS(q[index], q[index + 4], 0x0f0f0f0f, 4);
+    } /* for */
+#undef SWAP_BITS
+  } /* aesCtOrtho */
+
+
+
+/**
+ *  Apply the AES S-box to all bytes of the bitsliced state.
+ *  The S-box is computed with the circuit of Boyar and Peralta
+ *  (113 gates) instead of a table lookup. This way the time does
+ *  not depend on the data (no cache timing side channel).
+ */
+static void aesCtSbox (uint32Type *q)
+
+  {
+    uint32Type x0, x1, x2, x3, x4, x5, x6, x7;
+    uint32Type y1, y2, y3, y4, y5, y6, y7, y8, y9, y10, y11;
+    uint32Type y12, y13, y14, y15, y16, y17, y18, y19, y20, y21;
+    uint32Type z0, z1, z2, z3, z4, z5, z6, z7, z8, z9, z10, z11;
+    uint32Type z12, z13, z14, z15, z16, z17;
+    uint32Type t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11;
+    uint32Type t12, t13, t14, t15, t16, t17, t18, t19, t20, t21;
+    uint32Type t22, t23, t24, t25, t26, t27, t28, t29, t30, t31;
+    uint32Type t32, t33, t34, t35, t36, t37, t38, t39, t40, t41;
+    uint32Type t42, t43, t44, t45, t46, t47, t48, t49, t50, t51;
+    uint32Type t52, t53, t54, t55, t56, t57, t58, t59, t60, t61;
+    uint32Type t62, t63, t64, t65, t66, t67;
+
+  /* aesCtSbox */
+    x0 = q[7]; x1 = q[6]; x2 = q[5]; x3 = q[4];
+    x4 = q[3]; x5 = q[2]; x6 = q[1]; x7 = q[0];
+
+    /* Top linear transformation. */
+    y14 = x3 ^ x5;   y13 = x0 ^ x6;   y9 = x0 ^ x3;    y8 = x0 ^ x5;
+    t0 = x1 ^ x2;    y1 = t0 ^ x7;    y4 = y1 ^ x3;    y12 = y13 ^ y14;
+    y2 = y1 ^ x0;    y5 = y1 ^ x6;    y3 = y5 ^ y8;    t1 = x4 ^ y12;
+    y15 = t1 ^ x5;   y20 = t1 ^ x1;   y6 = y15 ^ x7;   y10 = y15 ^ t0;
+    y11 = y20 ^ y9;  y7 = x7 ^ y11;   y17 = y10 ^ y11; y19 = y10 ^ y8;
+    y16 = t0 ^ y11;  y21 = y13 ^ y16; y18 = x0 ^ y16;
+
+    /* Non-linear section. */
+    t2 = y12 & y15;  t3 = y3 & y6;    t4 = t3 ^ t2;    t5 = y4 & x7;
+    t6 = t5 ^ t2;    t7 = y13 & y16;  t8 = y5 & y1;    t9 = t8 ^ t7;
+    t10 = y2 & y7;   t11 = t10 ^ t7;  t12 = y9 & y11;  t13 = y14 & y17;
+    t14 = t13 ^ t12; t15 = y8 & y10;  t16 = t15 ^ t12; t17 = t4 ^ t14;
+    t18 = t6 ^ t16;  t19 = t9 ^ t14;  t20 = t11 ^ t16; t21 = t17 ^ y20;
+    t22 = t18 ^ y19; t23 = t19 ^ y21; t24 = t20 ^ y18;
+
+    t25 = t21 ^ t22; t26 = t21 & t23; t27 = t24 ^ t26; t28 = t25 & t27;
+    t29 = t28 ^ t22; t30 = t23 ^ t24; t31 = t22 ^ t26; t32 = t31 & t30;
+    t33 = t32 ^ t24; t34 = t23 ^ t33; t35 = t27 ^ t33; t36 = t24 & t35;
+    t37 = t36 ^ t34; t38 = t27 ^ t36; t39 = t29 & t38; t40 = t25 ^ t39;
+
+    t41 = t40 ^ t37; t42 = t29 ^ t33; t43 = t29 ^ t40; t44 = t33 ^ t37;
+    t45 = t42 ^ t41;
+    z0 = t44 & y15;  z1 = t37 & y6;   z2 = t33 & x7;   z3 = t43 & y16;
+    z4 = t40 & y1;   z5 = t29 & y7;   z6 = t42 & y11;  z7 = t45 & y17;
+    z8 = t41 & y10;  z9 = t44 & y12;  z10 = t37 & y3;  z11 = t33 & y4;
+    z12 = t43 & y13; z13 = t40 & y5;  z14 = t29 & y2;  z15 = t42 & y9;
+    z16 = t45 & y14; z17 = t41 & y8;
+
+    /* Bottom linear transformation. */
+    t46 = z15 ^ z16; t47 = z10 ^ z11; t48 = z5 ^ z13;  t49 = z9 ^ z10;
+    t50 = z2 ^ z12;  t51 = z2 ^ z5;   t52 = z7 ^ z8;   t53 = z0 ^ z3;
+    t54 = z6 ^ z7;   t55 = z16 ^ z17; t56 = z12 ^ t48; t57 = t50 ^ t53;
+    t58 = z4 ^ t46;  t59 = z3 ^ t54;  t60 = t46 ^ t57; t61 = z14 ^ t57;
+    t62 = t52 ^ t58; t63 = t49 ^ t58; t64 = z4 ^ t59;  t65 = t61 ^ t62;
+    t66 = z1 ^ t63;  t67 = t64 ^ t65;
+
+    q[7] = t59 ^ t63;
+    q[1] = t56 ^ ~t62;
+    q[0] = t48 ^ ~t60;
+    q[4] = t53 ^ t66;
+    q[3] = t51 ^ t66;
+    q[2] = t47 ^ t65;
+    q[6] = t64 ^ ~q[4];
+    q[5] = t55 ^ ~t67;
+  } /* aesCtSbox */
+
+
+
+/**
+ *  Apply the inverse affine transformation of the S-box to the
+ *  bitsliced state: Bit n becomes bit n+2 xor bit n+5 xor bit n+7
+ *  (modulo 8) xor bit n of 16#05.
+ */
+static void aesCtInvAffine (uint32Type *q)
+
+  {
+    uint32Type q0, q1, q2, q3, q4, q5, q6, q7;
+
+  /* aesCtInvAffine */
+    q0 = q[0]; q1 = q[1]; q2 = q[2]; q3 = q[3];
+    q4 = q[4]; q5 = q[5]; q6 = q[6]; q7 = q[7];
+    q[0] = ~(q2 ^ q5 ^ q7);
+    q[1] = q3 ^ q6 ^ q0;
+    q[2] = ~(q4 ^ q7 ^ q1);
+    q[3] = q5 ^ q0 ^ q2;
+    q[4] = q6 ^ q1 ^ q3;
+    q[5] = q7 ^ q2 ^ q4;
+    q[6] = q0 ^ q3 ^ q5;
+    q[7] = q1 ^ q4 ^ q6;
+  } /* aesCtInvAffine */
+
+
+
+/**
+ *  Apply the inverse AES S-box to all bytes of the bitsliced state.
+ *  The S-box is S(x) = A(I(x)), with the inversion I in GF(2**8)
+ *  and the affine transformation A. With the inverse affine
+ *  transformation T this gives I(x) = T(S(x)) and the inverse
+ *  S-box is I(T(x)) = T(S(T(x))).
+ */
+static void aesCtInvSbox (uint32Type *q)
+
+  { /* aesCtInvSbox */
+    aesCtInvAffine(q);
+    aesCtSbox(q);
+    aesCtInvAffine(q);
+  } /* aesCtInvSbox */
+
+
+
+static void aesCtShiftRows (uint32Type *q)
+
+  {
+    int index;
+    uint32Type x;
+
+  /* aesCtShiftRows */
+    for (index = 0; index < 8; index++) {
+      x = q[index];
+      q[index] = (x & 0x000000ff) |
+                 ((x & 0x0000fc00) >> 2) | ((x & 0x00000300) << 6) |
+                 ((x & 0x00f00000) >> 4) | ((x & 0x000f0000) << 4) |
+                 ((x & 0xc0000000) >> 6) | ((x & 0x3f000000) << 2);
+    } /* for */
+  } /* aesCtShiftRows */
+
+
+
+static void aesCtInvShiftRows (uint32Type *q)
+
+  {
+    int index;
+    uint32Type x;
+
+  /* aesCtInvShiftRows */
+    for (index = 0; index < 8; index++) {
+      x = q[index];
+      q[index] = (x & 0x000000ff) |
+                 ((x & 0x00003f00) << 2) | ((x & 0x0000c000) >> 6) |
+                 ((x & 0x000f0000) << 4) | ((x & 0x00f00000) >> 4) |
+                 ((x & 0x03000000) << 6) | ((x & 0xfc000000) >> 2);
+    } /* for */
+  } /* aesCtInvShiftRows */
+
+
+
+#define ROTR8(x)   ((x) << 24 | (x) >> 8)
+#define ROTR16(x)  ((x) << 16 | (x) >> 16)
+
+static void aesCtMixColumns (uint32Type *q)
+
+  {
+    uint32Type q0, q1, q2, q3, q4, q5, q6, q7;
+    uint32Type r0, r1, r2, r3, r4, r5, r6, r7;
+
+  /* aesCtMixColumns */
+    q0 = q[0]; q1 = q[1]; q2 = q[2]; q3 = q[3];
+    q4 = q[4]; q5 = q[5]; q6 = q[6]; q7 = q[7];
+    r0 = ROTR8(q0); r1 = ROTR8(q1); r2 = ROTR8(q2); r3 = ROTR8(q3);
+    r4 = ROTR8(q4); r5 = ROTR8(q5); r6 = ROTR8(q6); r7 = ROTR8(q7);
+    q[0] = q7 ^ r7 ^ r0 ^ ROTR16(q0 ^ r0);
+    q[1] = q0 ^ r0 ^ q7 ^ r7 ^ r1 ^ ROTR16(q1 ^ r1);
+    q[2] = q1 ^ r1 ^ r2 ^ ROTR16(q2 ^ r2);
+    q[3] = q2 ^ r2 ^ q7 ^ r7 ^ r3 ^ ROTR16(q3 ^ r3);
+    q[4] = q3 ^ r3 ^ q7 ^ r7 ^ r4 ^ ROTR16(q4 ^ r4);
+    q[5] = q4 ^ r4 ^ r5 ^ ROTR16(q5 ^ r5);
+    q[6] = q5 ^ r5 ^ r6 ^ ROTR16(q6 ^ r6);
+    q[7] = q6 ^ r6 ^ r7 ^ ROTR16(q7 ^ r7);
+  } /* aesCtMixColumns */
+
+
+
+/**
+ *  The MixColumns matrix M of AES satisfies M**4 = 1.
+ *  Therefore InvMixColumns is MixColumns applied three times.
+ */
+static void aesCtInvMixColumns (uint32Type *q)
+
+  { /* aesCtInvMixColumns */
+    aesCtMixColumns(q);
+    aesCtMixColumns(q);
+    aesCtMixColumns(q);
+  } /* aesCtInvMixColumns */
+
+
+
+static inline void aesCtAddRoundKey (uint32Type *q, const uint32Type *key)
+
+  {
+    int index;
+
+  /* aesCtAddRoundKey */
+    for (index = 0; index < 8; index++) {
+      q[index] ^= key[index];
+    } /* for */
+  } /* aesCtAddRoundKey */
+
+
+
+static void aesCtEncrypt (const aesKeyType *key, uint32Type *q)
+
+  {
+    unsigned int round;
+
+  /* aesCtEncrypt */
+    aesCtAddRoundKey(q, key->slicedKey);
+    for (round = 1; round < key->rounds; round++) {
+      aesCtSbox(q);
+      aesCtShiftRows(q);
+      aesCtMixColumns(q);
+      aesCtAddRoundKey(q, &key->slicedKey[8 * round]);
+    } /* for */
+    aesCtSbox(q);
+    aesCtShiftRows(q);
+    aesCtAddRoundKey(q, &key->slicedKey[8 * key->rounds]);
+  } /* aesCtEncrypt */
+
+
+
+static void aesCtDecrypt (const aesKeyType *key, uint32Type *q)
+
+  {
+    unsigned int round;
+
+  /* aesCtDecrypt */
+    aesCtAddRoundKey(q, &key->slicedKey[8 * key->rounds]);
+    for (round = key->rounds - 1; round > 0; round--) {
+      aesCtInvShiftRows(q);
+      aesCtInvSbox(q);
+      aesCtAddRoundKey(q, &key->slicedKey[8 * round]);
+      aesCtInvMixColumns(q);
+    } /* for */
+    aesCtInvShiftRows(q);
+    aesCtInvSbox(q);
+    aesCtAddRoundKey(q, key->slicedKey);
+  } /* aesCtDecrypt */
+
+
+
+/**
+ *  Load one or two blocks into the bitsliced state.
+ *  If 'block2' is NULL the second lane is zero.
+ */
+static void aesCtLoad (uint32Type *q, const uint8Type *block1,
+    const uint8Type *block2)
+
+  {
+    int index;
+
+  /* aesCtLoad */
+    for (index = 0; index < 4; index++) {
+      q[2 * index] = getUint32Le(&block1[4 * index]);
+      q[2 * index + 1] = block2 != NULL ? getUint32Le(&block2[4 * index]) : 0;
+    } /* for */
+    aesCtOrtho(q);
+  } /* aesCtLoad */
+
+
+
+static void aesCtStore (uint32Type *q, uint8Type *block1, uint8Type *block2)
+
+  {
+    int index;
+
+  /* aesCtStore */
+    aesCtOrtho(q);
+    for (index = 0; index < 4; index++) {
+      putUint32Le(&block1[4 * index], q[2 * index]);
+      if (block2 != NULL) {
+        putUint32Le(&block2[4 * index], q[2 * index + 1]);
+      } /* if */
+    } /* for */
+  } /* aesCtStore */
+
+
+
+static uint32Type aesSubWord (uint32Type word)
+
+  {
+    uint32Type q[8];
+
+  /* aesSubWord */
+    memset(q, 0, sizeof(q));
+    q[0] = word;
+    aesCtOrtho(q);
+    aesCtSbox(q);
+    aesCtOrtho(q);
+    return q[0];
+  } /* aesSubWord */
+
+
+
+/**
+ *  Compute the round keys of AES from 'keyBytes'.
+ *  The S-box of the key expansion is computed with the bitsliced
+ *  circuit as well, such that no table is indexed with key bytes.
+ *  @return FALSE if the key length is not 16, 24 or 32.
+ */
+static boolType aesExpandKey (aesKeyType *key, const uint8Type *keyBytes,
+    memSizeType keyLength)
+
+  {
+    static const uint8Type rcon[] = {
+        0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36
+      };
+    unsigned int keyWords;
+    unsigned int numWords;
+    unsigned int index;
+    unsigned int rconIndex = 0;
+    unsigned int column = 0;
+    uint32Type temp = 0;
+    uint32Type q[8];
+
+  /* aesExpandKey */
+    if (keyLength != 16 && keyLength != 24 && keyLength != 32) {
+      return FALSE;
+    } /* if */
+    keyWords = (unsigned int) keyLength / 4;
+    key->rounds = keyWords + 6;
+    numWords = 4 * (key->rounds + 1);
+    for (index = 0; index < keyWords; index++) {
+      temp = getUint32Le(&keyBytes[4 * index]);
+      key->roundKey[index] = temp;
+    } /* for */
+    for (index = keyWords; index < numWords; index++) {
+      if (column == 0) {
+        temp = aesSubWord(temp << 24 | temp >> 8) ^ rcon[rconIndex];
+        rconIndex++;
+      } else if (keyWords > 6 && column == 4) {
+        temp = aesSubWord(temp);
+      } /* if */
+      temp ^= key->roundKey[index - keyWords];
+      key->roundKey[index] = temp;
+      column++;
+      if (column == keyWords) {
+        column = 0;
+      } /* if */
+    } /* for */
+    for (index = 0; index <= key->rounds; index++) {
+      q[0] = q[1] = key->roundKey[4 * index];
+      q[2] = q[3] = key->roundKey[4 * index + 1];
+      q[4] = q[5] = key->roundKey[4 * index + 2];
+      q[6] = q[7] = key->roundKey[4 * index + 3];
+      aesCtOrtho(q);
+      memcpy(&key->slicedKey[8 * index], q, sizeof(q));
+    } /* for */
+    return TRUE;
+  } /* aesExpandKey */
+
+
+
+/**
+ *  Increment the last 32 bits of a counter block (big endian).
+ *  This is the inc32 function of GCM.
+ */
+static inline void incrementCounter (uint8Type *counter)
+
+  {
+    int index = AES_BLOCK_SIZE - 1;
+
+  /* incrementCounter */
+    while (index >= AES_BLOCK_SIZE - 4 && ++counter[index] == 0) {
+      index--;
+    } /* while */
+  } /* incrementCounter */
+
+
+
+/**
+ *  Process 'length' bytes of 'buffer' in place with the bitsliced
+ *  implementation. For CBC 'length' is a multiple of AES_BLOCK_SIZE.
+ *  'chain' is the CBC chaining value or the counter block. It is
+ *  updated for the next call.
+ */
+static void aesCtProcess (const aesKeyType *key, aesModeType mode,
+    uint8Type *chain, uint8Type *buffer, memSizeType length)
+
+  {
+    uint32Type q[8];
+    uint8Type stream[2 * AES_BLOCK_SIZE];
+    uint8Type savedBlock[2 * AES_BLOCK_SIZE];
+    memSizeType pos;
+    memSizeType index;
+    memSizeType blockBytes;
+
+  /* aesCtProcess */
+    if (mode == AES_CBC_ENCRYPT) {
+      /* Each block depends on the previous one: Use only one lane. */
+      for (pos = 0; pos < length; pos += AES_BLOCK_SIZE) {
+        for (index = 0; index < AES_BLOCK_SIZE; index++) {
+          buffer[pos + index] ^= chain[index];
+        } /* for */
+        aesCtLoad(q, &buffer[pos], NULL);
+        aesCtEncrypt(key, q);
+        aesCtStore(q, &buffer[pos], NULL);
+        memcpy(chain, &buffer[pos], AES_BLOCK_SIZE);
+      } /* for */
+    } else if (mode == AES_CBC_DECRYPT) {
+      for (pos = 0; pos < length; pos += 2 * AES_BLOCK_SIZE) {
+        blockBytes = length - pos >= 2 * AES_BLOCK_SIZE ?
+                     2 * AES_BLOCK_SIZE : AES_BLOCK_SIZE;
+        memcpy(savedBlock, &buffer[pos], blockBytes);
+        aesCtLoad(q, &buffer[pos], blockBytes == AES_BLOCK_SIZE ?
+                                   NULL : &buffer[pos + AES_BLOCK_SIZE]);
+        aesCtDecrypt(key, q);
+        aesCtStore(q, &buffer[pos], blockBytes == AES_BLOCK_SIZE ?
+                                    NULL : &buffer[pos + AES_BLOCK_SIZE]);
+        for (index = 0; index < AES_BLOCK_SIZE; index++) {
+          buffer[pos + index] ^= chain[index];
+        } /* for */
+        for (index = AES_BLOCK_SIZE; index < blockBytes; index++) {
+          buffer[pos + index] ^= savedBlock[index - AES_BLOCK_SIZE];
+        } /* for */
+        memcpy(chain, &savedBlock[blockBytes - AES_BLOCK_SIZE], AES_BLOCK_SIZE);
+      } /* for */
+    } else {
+      for (pos = 0; pos < length; pos += 2 * AES_BLOCK_SIZE) {
+        memcpy(stream, chain, AES_BLOCK_SIZE);
+        incrementCounter(chain);
+        memcpy(&stream[AES_BLOCK_SIZE], chain, AES_BLOCK_SIZE);
+        incrementCounter(chain);
+        aesCtLoad(q, stream, &stream[AES_BLOCK_SIZE]);
+        aesCtEncrypt(key, q);
+        aesCtStore(q, stream, &stream[AES_BLOCK_SIZE]);
+        blockBytes = length - pos >= 2 * AES_BLOCK_SIZE ?
+                     2 * AES_BLOCK_SIZE : length - pos;
+        for (index = 0; index < blockBytes; index++) {
+          buffer[pos + index] ^= stream[index];
+        } /* for */
+      } /* for */
+    } /* if */
+  } /* aesCtProcess */
+
+
+
+#if HAS_AES_TARGET_ATTRIBUTE
+/**
+ *  Process 'length' bytes of 'buffer' in place with the AES-NI
+ *  instructions. Independent blocks (CBC decryption and CTR) are
+ *  processed four at a time to hide the latency of aesenc/aesdec.
+ *  The function must only be called if __builtin_cpu_supports("aes")
+ *  and __builtin_cpu_supports("sse4.1") are TRUE.
+ */
+__attribute__((target("aes,sse4.1")))
+static void aesNiProcess (const aesKeyType *key, aesModeType mode,
+    uint8Type *chain, uint8Type *buffer, memSizeType length)
+
+  {
+    __m128i roundKey[AES_MAX_ROUNDS + 1];
+    __m128i state, b0, b1, b2, b3, c0, c1, c2, c3, k;
+    uint8Type counterBlocks[4 * AES_BLOCK_SIZE];
+    unsigned int rounds;
+    unsigned int round;
+    memSizeType pos = 0;
+    memSizeType index;
+
+  /* aesNiProcess */
+    rounds = key->rounds;
+    /* The round keys are little endian words: On x86 the bytes */
+    /* in memory are in the order expected by aesenc.            */
+    for (round = 0; round <= rounds; round++) {
+      roundKey[round] = _mm_loadu_si128((const __m128i *) &key->roundKey[4 * round]);
+    } /* for */
+    if (mode == AES_CBC_ENCRYPT) {
+      state = _mm_loadu_si128((const __m128i *) chain);
+      for (; pos < length; pos += AES_BLOCK_SIZE) {
+        state = _mm_xor_si128(state, _mm_loadu_si128((const __m128i *) &buffer[pos]));
+        state = _mm_xor_si128(state, roundKey[0]);
+        for (round = 1; round < rounds; round++) {
+          state = _mm_aesenc_si128(state, roundKey[round]);
+        } /* for */
+        state = _mm_aesenclast_si128(state, roundKey[rounds]);
+        _mm_storeu_si128((__m128i *) &buffer[pos], state);
+      } /* for */
+      _mm_storeu_si128((__m128i *) chain, state);
+    } else if (mode == AES_CBC_DECRYPT) {
+      /* Round keys for the equivalent inverse cipher. */
+      for (round = 1; round < rounds; round++) {
+        roundKey[round] = _mm_aesimc_si128(roundKey[round]);
+      } /* for */
+      state = _mm_loadu_si128((const __m128i *) chain);
+      for (; length - pos >= 4 * AES_BLOCK_SIZE; pos += 4 * AES_BLOCK_SIZE) {
+        c0 = _mm_loadu_si128((const __m128i *) &buffer[pos]);
+        c1 = _mm_loadu_si128((const __m128i *) &buffer[pos + 16]);
+        c2 = _mm_loadu_si128((const __m128i *) &buffer[pos + 32]);
+        c3 = _mm_loadu_si128((const __m128i *) &buffer[pos + 48]);
+        k = roundKey[rounds];
+        b0 = _mm_xor_si128(c0, k);
+        b1 = _mm_xor_si128(c1, k);
+        b2 = _mm_xor_si128(c2, k);
+        b3 = _mm_xor_si128(c3, k);
+        for (round = rounds - 1; round > 0; round--) {
+          k = roundKey[round];
+          b0 = _mm_aesdec_si128(b0, k);
+          b1 = _mm_aesdec_si128(b1, k);
+          b2 = _mm_aesdec_si128(b2, k);
+          b3 = _mm_aesdec_si128(b3, k);
+        } /* for */
+        k = roundKey[0];
+        b0 = _mm_aesdeclast_si128(b0, k);
+        b1 = _mm_aesdeclast_si128(b1, k);
+        b2 = _mm_aesdeclast_si128(b2, k);
+        b3 = _mm_aesdeclast_si128(b3, k);
+        _mm_storeu_si128((__m128i *) &buffer[pos],      _mm_xor_si128(b0, state));
+        _mm_storeu_si128((__m128i *) &buffer[pos + 16], _mm_xor_si128(b1, c0));
+        _mm_storeu_si128((__m128i *) &buffer[pos + 32], _mm_xor_si128(b2, c1));
+        _mm_storeu_si128((__m128i *) &buffer[pos + 48], _mm_xor_si128(b3, c2));
+        state = c3;
+      } /* for */
+      for (; pos < length; pos += AES_BLOCK_SIZE) {
+        c0 = _mm_loadu_si128((const __m128i *) &buffer[pos]);
+        b0 = _mm_xor_si128(c0, roundKey[rounds]);
+        for (round = rounds - 1; round > 0; round--) {
+          b0 = _mm_aesdec_si128(b0, roundKey[round]);
+        } /* for */
+        b0 = _mm_aesdeclast_si128(b0, roundKey[0]);
+        _mm_storeu_si128((__m128i *) &buffer[pos], _mm_xor_si128(b0, state));
+        state = c0;
+      } /* for */
+      _mm_storeu_si128((__m128i *) chain, state);
+    } else {
+      for (; pos < length; pos += 4 * AES_BLOCK_SIZE) {
+        for (index = 0; index < 4 * AES_BLOCK_SIZE; index += AES_BLOCK_SIZE) {
+          memcpy(&counterBlocks[index], chain, AES_BLOCK_SIZE);
+          incrementCounter(chain);
+        } /* for */
+        k = roundKey[0];
+        b0 = _mm_xor_si128(_mm_loadu_si128((const __m128i *) &counterBlocks[0]), k);
+        b1 = _mm_xor_si128(_mm_loadu_si128((const __m128i *) &counterBlocks[16]), k);
+        b2 = _mm_xor_si128(_mm_loadu_si128((const __m128i *) &counterBlocks[32]), k);
+        b3 = _mm_xor_si128(_mm_loadu_si128((const __m128i *) &counterBlocks[48]), k);
+        for (round = 1; round < rounds; round++) {
+          k = roundKey[round];
+          b0 = _mm_aesenc_si128(b0, k);
+          b1 = _mm_aesenc_si128(b1, k);
+          b2 = _mm_aesenc_si128(b2, k);
+          b3 = _mm_aesenc_si128(b3, k);
+        } /* for */
+        k = roundKey[rounds];
+        b0 = _mm_aesenclast_si128(b0, k);
+        b1 = _mm_aesenclast_si128(b1, k);
+        b2 = _mm_aesenclast_si128(b2, k);
+        b3 = _mm_aesenclast_si128(b3, k);
+        if (length - pos >= 4 * AES_BLOCK_SIZE) {
+          _mm_storeu_si128((__m128i *) &buffer[pos], _mm_xor_si128(b0,
+              _mm_loadu_si128((const __m128i *) &buffer[pos])));
+          _mm_storeu_si128((__m128i *) &buffer[pos + 16], _mm_xor_si128(b1,
+              _mm_loadu_si128((const __m128i *) &buffer[pos + 16])));
+          _mm_storeu_si128((__m128i *) &buffer[pos + 32], _mm_xor_si128(b2,
+              _mm_loadu_si128((const __m128i *) &buffer[pos + 32])));
+          _mm_storeu_si128((__m128i *) &buffer[pos + 48], _mm_xor_si128(b3,
+              _mm_loadu_si128((const __m128i *) &buffer[pos + 48])));
+        } else {
+          _mm_storeu_si128((__m128i *) &counterBlocks[0], b0);
+          _mm_storeu_si128((__m128i *) &counterBlocks[16], b1);
+          _mm_storeu_si128((__m128i *) &counterBlocks[32], b2);
+          _mm_storeu_si128((__m128i *) &counterBlocks[48], b3);
+          for (index = 0; index < length - pos; index++) {
+            buffer[pos + index] ^= counterBlocks[index];
+          } /* for */
+        } /* if */
+      } /* for */
+      memset(counterBlocks, 0, sizeof(counterBlocks));
+    } /* if */
+  } /* aesNiProcess */
+
+#endif
+
+
+
+/**
+ *  Carry-less multiplication of two 32-bit values. The bits are
+ *  split into four groups with holes of three bits. This way the
+ *  carries of the integer multiplications do not spill into the
+ *  bits of the same group. Integer multiplication takes constant
+ *  time, such that no timing side channel is introduced.
+ */
+static inline uint64Type clmul32 (uint32Type x, uint32Type y)
+
+  {
+    uint64Type x0, x1, x2, x3;
+    uint64Type y0, y1, y2, y3;
+    uint64Type z0, z1, z2, z3;
+
+  /* clmul32 */
+    x0 = x & 0x11111111; x1 = x & 0x22222222;
+    x2 = x & 0x44444444; x3 = x & 0x88888888;
+    y0 = y & 0x11111111; y1 = y & 0x22222222;
+    y2 = y & 0x44444444; y3 = y & 0x88888888;
+    z0 = (x0 * y0) ^ (x1 * y3) ^ (x2 * y2) ^ (x3 * y1);
+    z1 = (x0 * y1) ^ (x1 * y0) ^ (x2 * y3) ^ (x3 * y2);
+    z2 = (x0 * y2) ^ (x1 * y1) ^ (x2 * y0) ^ (x3 * y3);
+    z3 = (x0 * y3) ^ (x1 * y2) ^ (x2 * y1) ^ (x3 * y0);
+    return (z0 & UINT64_SUFFIX(0x1111111111111111)) |
+           (z1 & UINT64_SUFFIX(0x2222222222222222)) |
+           (z2 & UINT64_SUFFIX(0x4444444444444444)) |
+           (z3 & UINT64_SUFFIX(0x8888888888888888));
+  } /* clmul32 */
+
+
+
+/**
+ *  Carry-less multiplication of two 64-bit values (Karatsuba).
+ */
+static inline void clmul64 (uint64Type x, uint64Type y,
+    uint64Type *high, uint64Type *low)
+
+  {
+    uint32Type x0, x1, y0, y1;
+    uint64Type a, b, c;
+
+  /* clmul64 */
+    x0 = (uint32Type) x; x1 = (uint32Type) (x >> 32);
+    y0 = (uint32Type) y; y1 = (uint32Type) (y >> 32);
+    a = clmul32(x0, y0);
+    b = clmul32(x1, y1);
+    c = clmul32(x0 ^ x1, y0 ^ y1) ^ a ^ b;
+    *low = a ^ (c << 32);
+    *high = b ^ (c >> 32);
+  } /* clmul64 */
+
+
+
+/**
+ *  Compute Y = Y * H in GF(2**128) with the bit order of GCM.
+ *  Both values are big endian 128-bit numbers: The most significant
+ *  bit is the coefficient of x**0. For this bit order the carry-less
+ *  product of the numbers is shifted left by one bit. Afterwards the
+ *  lower 128 bits are reduced modulo x**128 + x**7 + x**2 + x + 1.
+ */
+static void ghashMultiply (uint64Type *yHigh, uint64Type *yLow,
+    uint64Type hHigh, uint64Type hLow)
+
+  {
+    uint64Type l1, l0, h1, h0, m1, m0;
+    uint64Type z3, z2, z1, z0;
+    uint64Type overflow;
+
+  /* ghashMultiply */
+    clmul64(*yLow, hLow, &l1, &l0);
+    clmul64(*yHigh, hHigh, &h1, &h0);
+    clmul64(*yLow ^ *yHigh, hLow ^ hHigh, &m1, &m0);
+    m1 ^= l1 ^ h1;
+    m0 ^= l0 ^ h0;
+    z3 = h1;
+    z2 = h0 ^ m1;
+    z1 = l1 ^ m0;
+    z0 = l0;
+    z3 = z3 << 1 | z2 >> 63;
+    z2 = z2 << 1 | z1 >> 63;
+    z1 = z1 << 1 | z0 >> 63;
+    z0 <<= 1;
+    /* Bits that are shifted out below by the reduction. */
+    overflow = z0 << 63 ^ z0 << 62 ^ z0 << 57;
+    z1 ^= overflow;
+    *yHigh = z3 ^ z1 ^ z1 >> 1 ^ z1 >> 2 ^ z1 >> 7;
+    *yLow = z2 ^ z0 ^ (z0 >> 1 | z1 << 63) ^ (z0 >> 2 | z1 << 62) ^
+            (z0 >> 7 | z1 << 57);
+  } /* ghashMultiply */
+
+
+
+static void ghashPortable (uint8Type *hash, const uint8Type *hashKey,
+    const uint8Type *data, memSizeType length)
+
+  {
+    uint64Type hHigh, hLow;
+    uint64Type yHigh, yLow;
+    memSizeType pos;
+
+  /* ghashPortable */
+    hHigh = getUint64Be(hashKey);
+    hLow = getUint64Be(&hashKey[8]);
+    yHigh = getUint64Be(hash);
+    yLow = getUint64Be(&hash[8]);
+    for (pos = 0; pos < length; pos += AES_BLOCK_SIZE) {
+      yHigh ^= getUint64Be(&data[pos]);
+      yLow ^= getUint64Be(&data[pos + 8]);
+      ghashMultiply(&yHigh, &yLow, hHigh, hLow);
+    } /* for */
+    putUint64Be(hash, yHigh);
+    putUint64Be(&hash[8], yLow);
+  } /* ghashPortable */
+
+
+
+#if HAS_PCLMUL_TARGET_ATTRIBUTE
+/**
+ *  Update the GHASH value 'hash' with the PCLMULQDQ instruction.
+ *  The multiplication and reduction follow the Intel paper "Intel
+ *  Carry-Less Multiplication Instruction and its Usage for Computing
+ *  the GCM Mode". The function must only be called if
+ *  __builtin_cpu_supports("pclmul") and __builtin_cpu_supports("sse4.1")
+ *  are TRUE.
+ *  @param length Number of bytes, a multiple of 16.
+ */
+__attribute__((target("pclmul,sse4.1")))
+static void ghashClmul (uint8Type *hash, const uint8Type *hashKey,
+    const uint8Type *data, memSizeType length)
+
+  {
+    __m128i byteSwap, h, y;
+    __m128i t2, t3, t4, t5, t6, t7, t8, t9;
+    memSizeType pos;
+
+  /* ghashClmul */
+    byteSwap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+                            8, 9, 10, 11, 12, 13, 14, 15);
+    h = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) hashKey), byteSwap);
+    y = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) hash), byteSwap);
+    for (pos = 0; pos < length; pos += AES_BLOCK_SIZE) {
+      y = _mm_xor_si128(y, _mm_shuffle_epi8(
+          _mm_loadu_si128((const __m128i *) &data[pos]), byteSwap));
+      /* 256-bit carry-less product in t6:t3. */
+      t3 = _mm_clmulepi64_si128(y, h, 0x00);
+      t4 = _mm_clmulepi64_si128(y, h, 0x10);
+      t5 = _mm_clmulepi64_si128(y, h, 0x01);
+      t6 = _mm_clmulepi64_si128(y, h, 0x11);
+      t4 = _mm_xor_si128(t4, t5);
+      t5 = _mm_slli_si128(t4, 8);
+      t4 = _mm_srli_si128(t4, 8);
+      t3 = _mm_xor_si128(t3, t5);
+      t6 = _mm_xor_si128(t6, t4);
+      /* Shift the product left by one bit. */
+      t7 = _mm_srli_epi32(t3, 31);
+      t8 = _mm_srli_epi32(t6, 31);
+      t3 = _mm_slli_epi32(t3, 1);
+      t6 = _mm_slli_epi32(t6, 1);
+      t9 = _mm_srli_si128(t7, 12);
+      t8 = _mm_slli_si128(t8, 4);
+      t7 = _mm_slli_si128(t7, 4);
+      t3 = _mm_or_si128(t3, t7);
+      t6 = _mm_or_si128(t6, t8);
+      t6 = _mm_or_si128(t6, t9);
+      /* Reduce t3 modulo x**128 + x**7 + x**2 + x + 1. */
+      t7 = _mm_slli_epi32(t3, 31);
+      t8 = _mm_slli_epi32(t3, 30);
+      t9 = _mm_slli_epi32(t3, 25);
+      t7 = _mm_xor_si128(t7, t8);
+      t7 = _mm_xor_si128(t7, t9);
+      t8 = _mm_srli_si128(t7, 4);
+      t7 = _mm_slli_si128(t7, 12);
+      t3 = _mm_xor_si128(t3, t7);
+      t2 = _mm_srli_epi32(t3, 1);
+      t4 = _mm_srli_epi32(t3, 2);
+      t5 = _mm_srli_epi32(t3, 7);
+      t2 = _mm_xor_si128(t2, t4);
+      t2 = _mm_xor_si128(t2, t5);
+      t2 = _mm_xor_si128(t2, t8);
+      t3 = _mm_xor_si128(t3, t2);
+      y = _mm_xor_si128(t6, t3);
+    } /* for */
+    _mm_storeu_si128((__m128i *) hash, _mm_shuffle_epi8(y, byteSwap));
+  } /* ghashClmul */
+
+#endif
+
+
+
+/**
+ *  Encrypt, decrypt or XOR with the key stream of AES.
+ *  The data is converted to bytes and processed in chunks of
+ *  CRY_BUFFER_SIZE.
+ */
+static striType aesProcess (const const_striType aesKey,
+    const const_striType chainBlock, const const_striType data,
+    aesModeType mode)
+
+  {
+    uint8Type keyBytes[32];
+    uint8Type chain[AES_BLOCK_SIZE];
+    uint8Type buffer[CRY_BUFFER_SIZE];
+    aesKeyType key;
+    const strElemType *mem;
+    memSizeType pos;
+    memSizeType chunkSize;
+#if HAS_AES_TARGET_ATTRIBUTE
+    boolType useAesNi;
+#endif
+    striType result;
+
+  /* aesProcess */
+    if (unlikely(aesKey->size > sizeof(keyBytes) ||
+                 memcpy_from_strelem(keyBytes, aesKey->mem, aesKey->size) ||
+                 !aesExpandKey(&key, keyBytes, aesKey->size))) {
+      logError(printf("aesProcess: Illegal AES key (length: " FMT_U_MEM ").\n",
+                      aesKey->size););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if (unlikely(chainBlock->size != AES_BLOCK_SIZE ||
+                        memcpy_from_strelem(chain, chainBlock->mem,
+                                            AES_BLOCK_SIZE))) {
+      logError(printf("aesProcess: Illegal initialization vector "
+                      "(length: " FMT_U_MEM ").\n", chainBlock->size););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if (unlikely(mode != AES_CTR &&
+                        data->size % AES_BLOCK_SIZE != 0)) {
+      logError(printf("aesProcess: Length " FMT_U_MEM
+                      " not a multiple of the block size.\n", data->size););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if (unlikely(!ALLOC_STRI_CHECK_SIZE(result, data->size))) {
+      raise_error(MEMORY_ERROR);
+      result = NULL;
+    } else {
+      result->size = data->size;
+#if HAS_AES_TARGET_ATTRIBUTE
+      useAesNi = accelerationAllowed &&
+                 __builtin_cpu_supports("aes") &&
+                 __builtin_cpu_supports("sse4.1");
+#endif
+      mem = data->mem;
+      for (pos = 0; pos < data->size; pos += chunkSize) {
+        chunkSize = data->size - pos > CRY_BUFFER_SIZE ?
+                    CRY_BUFFER_SIZE : data->size - pos;
+        if (unlikely(memcpy_from_strelem(buffer, &mem[pos], chunkSize))) {
+          logError(printf("aesProcess: Character beyond '\\255;' in data.\n"););
+          FREE_STRI(result);
+          raise_error(RANGE_ERROR);
+          result = NULL;
+          break;
+        } /* if */
+#if HAS_AES_TARGET_ATTRIBUTE
+        if (useAesNi) {
+          aesNiProcess(&key, mode, chain, buffer, chunkSize);
+        } else {
+          aesCtProcess(&key, mode, chain, buffer, chunkSize);
+        } /* if */
+#else
+        aesCtProcess(&key, mode, chain, buffer, chunkSize);
+#endif
+        memcpy_to_strelem(&result->mem[pos], buffer, chunkSize);
+      } /* for */
+      memset(buffer, 0, sizeof(buffer));
+    } /* if */
+    memset(&key, 0, sizeof(key));
+    memset(keyBytes, 0, sizeof(keyBytes));
+    return result;
+  } /* aesProcess */
+
+
+
+/**
+ *  Decrypt 'encrypted' with AES in cipher block chaining (CBC) mode.
+ *  If the CPU supports AES-NI the aesdec instruction is used.
+ *  Otherwise a constant-time bitsliced implementation is used.
+ *  @param aesKey AES key with a length of 16, 24 or 32 bytes.
+ *  @param initializationVector The previous cipher block (16 bytes).
+ *  @param encrypted Encrypted data with a multiple of 16 bytes.
+ *  @return the decrypted data.
+ *  @exception RANGE_ERROR If a length is not correct or if a
+ *             character is beyond '\255;'.
+ *  @exception MEMORY_ERROR Not enough memory to create the result.
+ */
+striType cryAesCbcDecrypt (const const_striType aesKey,
+    const const_striType initializationVector, const const_striType encrypted)
+
+  {
+    striType decrypted;
+
+  /* cryAesCbcDecrypt */
+    logFunction(printf("cryAesCbcDecrypt(*, *, \"%s\")\n",
+                       striAsUnquotedCStri(encrypted)););
+    decrypted = aesProcess(aesKey, initializationVector, encrypted,
+                           AES_CBC_DECRYPT);
+    logFunction(printf("cryAesCbcDecrypt --> \"%s\"\n",
+                       striAsUnquotedCStri(decrypted)););
+    return decrypted;
+  } /* cryAesCbcDecrypt */
+
+
+
+/**
+ *  Encrypt 'plaintext' with AES in cipher block chaining (CBC) mode.
+ *  If the CPU supports AES-NI the aesenc instruction is used.
+ *  Otherwise a constant-time bitsliced implementation is used.
+ *  @param aesKey AES key with a length of 16, 24 or 32 bytes.
+ *  @param initializationVector The previous cipher block (16 bytes).
+ *  @param plaintext Data with a multiple of 16 bytes.
+ *  @return the encrypted data.
+ *  @exception RANGE_ERROR If a length is not correct or if a
+ *             character is beyond '\255;'.
+ *  @exception MEMORY_ERROR Not enough memory to create the result.
+ */
+striType cryAesCbcEncrypt (const const_striType aesKey,
+    const const_striType initializationVector, const const_striType plaintext)
+
+  {
+    striType encrypted;
+
+  /* cryAesCbcEncrypt */
+    logFunction(printf("cryAesCbcEncrypt(*, *, \"%s\")\n",
+                       striAsUnquotedCStri(plaintext)););
+    encrypted = aesProcess(aesKey, initializationVector, plaintext,
+                           AES_CBC_ENCRYPT);
+    logFunction(printf("cryAesCbcEncrypt --> \"%s\"\n",
+                       striAsUnquotedCStri(encrypted)););
+    return encrypted;
+  } /* cryAesCbcEncrypt */
+
+
+
+/**
+ *  XOR 'data' with the AES key stream in counter (CTR) mode.
+ *  The key stream consists of the encrypted counter blocks. The
+ *  first counter block is 'counterBlock'. For every further block
+ *  the last four bytes are incremented as big endian number (like
+ *  the inc32 function of GCM). The same function is used for
+ *  encryption and decryption.
+ *  @param aesKey AES key with a length of 16, 24 or 32 bytes.
+ *  @param counterBlock The first counter block (16 bytes).
+ *  @param data Data of any length.
+ *  @return 'data' XORed with the key stream.
+ *  @exception RANGE_ERROR If a length is not correct or if a
+ *             character is beyond '\255;'.
+ *  @exception MEMORY_ERROR Not enough memory to create the result.
+ */
+striType cryAesCtr (const const_striType aesKey,
+    const const_striType counterBlock, const const_striType data)
+
+  {
+    striType result;
+
+  /* cryAesCtr */
+    logFunction(printf("cryAesCtr(*, *, \"%s\")\n",
+                       striAsUnquotedCStri(data)););
+    result = aesProcess(aesKey, counterBlock, data, AES_CTR);
+    logFunction(printf("cryAesCtr --> \"%s\"\n",
+                       striAsUnquotedCStri(result)););
+    return result;
+  } /* cryAesCtr */
+
+
+
+/**
+ *  Update the GHASH value 'hash' of GCM with 'data'.
+ *  For every 16-byte block of 'data' the hash is computed as
+ *  (hash >< block) * hashKey in GF(2**128). A last incomplete
+ *  block is padded with zero bytes. If the CPU supports it the
+ *  PCLMULQDQ instruction is used. Otherwise a constant-time
+ *  carry-less multiplication is used.
+ *  @param hashKey The hash key H (AES encryption of a zero block).
+ *  @param hash The previous hash value (16 zero bytes at the start).
+ *  @param data Data of any length.
+ *  @return the new hash value (16 bytes).
+ *  @exception RANGE_ERROR If 'hashKey' or 'hash' do not have a
+ *             length of 16 or if a character is beyond '\255;'.
+ *  @exception MEMORY_ERROR Not enough memory to create the result.
+ */
+striType cryGhash (const const_striType hashKey, const const_striType hash,
+    const const_striType data)
+
+  {
+    uint8Type keyBytes[AES_BLOCK_SIZE];
+    uint8Type hashBytes[AES_BLOCK_SIZE];
+    uint8Type buffer[CRY_BUFFER_SIZE];
+    const strElemType *mem;
+    memSizeType pos;
+    memSizeType chunkSize;
+    memSizeType paddedSize;
+#if HAS_PCLMUL_TARGET_ATTRIBUTE
+    boolType useClmul;
+#endif
+    boolType okay = TRUE;
+    striType result;
+
+  /* cryGhash */
+    logFunction(printf("cryGhash(*, *, \"%s\")\n",
+                       striAsUnquotedCStri(data)););
+    if (unlikely(hashKey->size != AES_BLOCK_SIZE ||
+                 hash->size != AES_BLOCK_SIZE ||
+                 memcpy_from_strelem(keyBytes, hashKey->mem, AES_BLOCK_SIZE) ||
+                 memcpy_from_strelem(hashBytes, hash->mem, AES_BLOCK_SIZE))) {
+      logError(printf("cryGhash: Illegal hash key or hash value.\n"););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+#if HAS_PCLMUL_TARGET_ATTRIBUTE
+      useClmul = accelerationAllowed &&
+                 __builtin_cpu_supports("pclmul") &&
+                 __builtin_cpu_supports("sse4.1");
+#endif
+      mem = data->mem;
+      for (pos = 0; okay && pos < data->size; pos += chunkSize) {
+        chunkSize = data->size - pos > CRY_BUFFER_SIZE ?
+                    CRY_BUFFER_SIZE : data->size - pos;
+        if (unlikely(memcpy_from_strelem(buffer, &mem[pos], chunkSize))) {
+          okay = FALSE;
+        } else {
+          paddedSize = (chunkSize + AES_BLOCK_SIZE - 1) &
+                       ~(memSizeType) (AES_BLOCK_SIZE - 1);
+          memset(&buffer[chunkSize], 0, paddedSize - chunkSize);
+#if HAS_PCLMUL_TARGET_ATTRIBUTE
+          if (useClmul) {
+            ghashClmul(hashBytes, keyBytes, buffer, paddedSize);
+          } else {
+            ghashPortable(hashBytes, keyBytes, buffer, paddedSize);
+          } /* if */
+#else
+          ghashPortable(hashBytes, keyBytes, buffer, paddedSize);
+#endif
+        } /* if */
+      } /* for */
+      if (unlikely(!okay)) {
+        logError(printf("cryGhash: Character beyond '\\255;' in data.\n"););
+        raise_error(RANGE_ERROR);
+        result = NULL;
+      } else if (unlikely(!ALLOC_STRI_SIZE_OK(result, AES_BLOCK_SIZE))) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        result->size = AES_BLOCK_SIZE;
+        memcpy_to_strelem(result->mem, hashBytes, AES_BLOCK_SIZE);
+      } /* if */
+    } /* if */
+    logFunction(printf("cryGhash --> \"%s\"\n",
+                       striAsUnquotedCStri(result)););
+    return result;
+  } /* cryGhash */
+
+
+
+/**
+ *  Allow or forbid the use of the AES-NI and PCLMULQDQ instructions.
+ *  If they are forbidden the bitsliced AES and the portable GHASH
+ *  are used. This way the portable implementations can be tested
+ *  on a CPU, which supports the instructions.
+ *  @param allowed TRUE if the instructions may be used (default),
+ *         or FALSE if the portable implementations must be used.
+ */
+void crySetAcceleration (boolType allowed)
+
+  { /* crySetAcceleration */
+    logFunction(printf("crySetAcceleration(%d)\n", allowed););
+    accelerationAllowed = allowed;
+  } /* crySetAcceleration */
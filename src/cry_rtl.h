@@ -0,0 +1,40 @@
+/********************************************************************/
+/*                                                                  */
+/*  cry_rtl.h     Primitive actions for cryptography.               */
+/*  Copyright (C) 2026  agent                                       */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/cry_rtl.h                                       */
+/*  Changes: 2026  agent                                            */
+/*  Content: Primitive actions for cryptography.                    */
+/*                                                                  */
+/********************************************************************/
+
+striType cryAesCbcDecrypt (const const_striType aesKey,
+    const const_striType initializationVector, const const_striType encrypted);
+striType cryAesCbcEncrypt (const const_striType aesKey,
+    const const_striType initializationVector, const const_striType plaintext);
+striType cryAesCtr (const const_striType aesKey,
+    const const_striType counterBlock, const const_striType data);
+striType cryGhash (const const_striType hashKey, const const_striType hash,
+    const const_striType data);
+void crySetAcceleration (boolType allowed);
@@ -0,0 +1,148 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  agent                                       */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/crylib.c                                        */
+/*  Changes: 2026  agent                                            */
+/*  Content: All primitive actions for cryptography.                */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+
+#include "common.h"
+#include "data.h"
+#include "heaputl.h"
+#include "syvarutl.h"
+#include "objutl.h"
+#include "runerr.h"
+#include "cry_rtl.h"
+
+#undef EXTERN
+#define EXTERN
+#include "crylib.h"
+
+
+
+/**
+ *  Decrypt 'encrypted' (arg_3) with AES in CBC mode.
+ *  The AES key is 'aesKey' (arg_1) and the initialization vector
+ *  is 'initializationVector' (arg_2).
+ *  @return the decrypted data.
+ *  @exception RANGE_ERROR If a length is not correct or if a
+ *             character is beyond '\255;'.
+ */
+objectType cry_aes_cbc_decrypt (listType arguments)
+
+  { /* cry_aes_cbc_decrypt */
+    isit_stri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    isit_stri(arg_3(arguments));
+    return bld_stri_temp(
+        cryAesCbcDecrypt(take_stri(arg_1(arguments)),
+                         take_stri(arg_2(arguments)),
+                         take_stri(arg_3(arguments))));
+  } /* cry_aes_cbc_decrypt */
+
+
+
+/**
+ *  Encrypt 'plaintext' (arg_3) with AES in CBC mode.
+ *  The AES key is 'aesKey' (arg_1) and the initialization vector
+ *  is 'initializationVector' (arg_2).
+ *  @return the encrypted data.
+ *  @exception RANGE_ERROR If a length is not correct or if a
+ *             character is beyond '\255;'.
+ */
+objectType cry_aes_cbc_encrypt (listType arguments)
+
+  { /* cry_aes_cbc_encrypt */
+    isit_stri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    isit_stri(arg_3(arguments));
+    return bld_stri_temp(
+        cryAesCbcEncrypt(take_stri(arg_1(arguments)),
+                         take_stri(arg_2(arguments)),
+                         take_stri(arg_3(arguments))));
+  } /* cry_aes_cbc_encrypt */
+
+
+
+/**
+ *  XOR 'data' (arg_3) with the AES key stream in counter mode.
+ *  The AES key is 'aesKey' (arg_1) and the first counter block
+ *  is 'counterBlock' (arg_2).
+ *  @return 'data' XORed with the key stream.
+ *  @exception RANGE_ERROR If a length is not correct or if a
+ *             character is beyond '\255;'.
+ */
+objectType cry_aes_ctr (listType arguments)
+
+  { /* cry_aes_ctr */
+    isit_stri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    isit_stri(arg_3(arguments));
+    return bld_stri_temp(
+        cryAesCtr(take_stri(arg_1(arguments)),
+                  take_stri(arg_2(arguments)),
+                  take_stri(arg_3(arguments))));
+  } /* cry_aes_ctr */
+
+
+
+/**
+ *  Update the GHASH value 'hash' (arg_2) of GCM with 'data' (arg_3).
+ *  The hash key is 'hashKey' (arg_1).
+ *  @return the new hash value.
+ *  @exception RANGE_ERROR If a length is not correct or if a
+ *             character is beyond '\255;'.
+ */
+objectType cry_ghash (listType arguments)
+
+  { /* cry_ghash */
+    isit_stri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    isit_stri(arg_3(arguments));
+    return bld_stri_temp(
+        cryGhash(take_stri(arg_1(arguments)),
+                 take_stri(arg_2(arguments)),
+                 take_stri(arg_3(arguments))));
+  } /* cry_ghash */
+
+
+
+/**
+ *  Allow or forbid the use of the AES-NI and PCLMULQDQ instructions.
+ *  If 'allowed' (arg_1) is FALSE the portable implementations
+ *  are used.
+ */
+objectType cry_set_acceleration (listType arguments)
+
+  { /* cry_set_acceleration */
+    isit_bool(arg_1(arguments));
+    crySetAcceleration(take_bool(arg_1(arguments)) == SYS_TRUE_OBJECT);
+    return SYS_EMPTY_OBJECT;
+  } /* cry_set_acceleration */
@@ -118,6 +118,7 @@ typedef struct structStruct     *structType;
 typedef struct parseErrorStruct *parseErrorType;
 typedef struct progStruct       *progType;
 typedef struct inFileStruct     *inFileType;
+typedef struct tcInstrStruct    *tcodeType;
 
 typedef const struct identStruct      *const_identType;
 typedef const struct tokenStruct      *const_tokenType;
@@ -139,14 +140,15 @@ typedef const struct structStruct     *const_structType;
 typedef const struct parseErrorStruct *const_parseErrorType;
 typedef const struct progStruct       *const_progType;
 typedef const struct inFileStruct     *const_inFileType;
+typedef const struct tcInstrStruct    *const_tcodeType;
 
 typedef objectType (*actType) (listType);
 
 typedef struct identStruct {
     ustriType name;
     sySizeType length;
-    identType next1;
-    identType next2;
+    uint32Type hash;
+    identType next;
     entityType entity;
     tokenType prefix_token;
     tokenType infix_token;
@@ -313,6 +315,7 @@ typedef struct blockStruct {
     locListType local_vars;
     listType local_consts;
     objectType body;
+    tcodeType tcode;
   } blockRecord;
 
 typedef struct arrayStruct {
@@ -366,10 +369,13 @@ typedef struct emptyStructStruct {
 
 typedef objectType sysType[NUMBER_OF_SYSVARS];
 
-#define ID_TABLE_SIZE     1024
+#define ID_TABLE_START_SIZE 1024
 
 typedef struct {
-    identType table[ID_TABLE_SIZE];
+    identType *table;
+    memSizeType table_size;
+    memSizeType number_of_idents;
+    memSizeType grow_limit;
     identType table1[127];
     identType literal;
     identType end_of_file;
@@ -404,6 +404,33 @@ void drwPut (const_winType destWindow, intType xDest, intType yDest,
 
 
 
+void drwPutGlyphs (const_winType destWindow, const_winType atlas,
+    const const_rtlArrayType glyphs)
+
+  {
+    memSizeType numValues;
+    memSizeType pos;
+    const rtlObjectType *glyph;
+
+  /* drwPutGlyphs */
+    numValues = arraySize(glyphs);
+    if (unlikely(numValues % GLYPH_ENTRY_SIZE != 0)) {
+      raise_error(RANGE_ERROR);
+    } else {
+      /* There is no batched copy, so every glyph is copied */
+      /* separately, like it is done by put() for a glyph.   */
+      for (pos = 0; pos < numValues; pos += GLYPH_ENTRY_SIZE) {
+        glyph = &glyphs->arr[pos];
+        drwCopyArea(atlas, destWindow,
+                    glyph[0].value.intValue, glyph[1].value.intValue,
+                    glyph[2].value.intValue, glyph[3].value.intValue,
+                    glyph[4].value.intValue, glyph[5].value.intValue);
+      } /* for */
+    } /* if */
+  } /* drwPutGlyphs */
+
+
+
 void drwPutScaled (const_winType destWindow, intType xDest, intType yDest,
     intType width, intType height, const_winType pixmap)
 
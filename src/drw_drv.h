@@ -29,6 +29,10 @@
 /*                                                                  */
 /********************************************************************/
 
+/* Number of integers used by drwPutGlyphs() to describe a glyph: */
+/* xSrc, ySrc, width, height, xDest and yDest.                    */
+#define GLYPH_ENTRY_SIZE 6
+
 void drawInit (void);
 void drawClose (void);
 boolType gkbButtonPressed (charType button);
@@ -94,6 +98,8 @@ void drwFPolyLine (const_winType actual_window,
     intType x, intType y, bstriType point_list, intType col);
 void drwPut (const_winType destWindow, intType xDest, intType yDest,
     const_winType pixmap);
+void drwPutGlyphs (const_winType destWindow, const_winType atlas,
+    const const_rtlArrayType glyphs);
 void drwPutScaled (const_winType destWindow, intType xDest, intType yDest,
     intType width, intType height, const_winType pixmap);
 void drwPRect (const_winType actual_window,
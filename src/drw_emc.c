@@ -2518,6 +2518,100 @@ void drwPut (const_winType destWindow, intType xDest, intType yDest,
 
 
 
+/**
+ *  Copy several areas (glyphs) of the pixmap 'atlas' to 'destWindow'.
+ *  The array 'glyphs' contains GLYPH_ENTRY_SIZE integers per glyph:
+ *  xSrc, ySrc, width, height, xDest and yDest.
+ */
+void drwPutGlyphs (const_winType destWindow, const_winType atlas,
+    const const_rtlArrayType glyphs)
+
+  {
+    memSizeType numValues;
+    memSizeType pos;
+    const rtlObjectType *glyph;
+    int successInfo = 0;
+
+  /* drwPutGlyphs */
+    logFunction(printf("drwPutGlyphs(" FMT_U_MEM " (window=%d), "
+                       FMT_U_MEM " (window=%d), " FMT_D " .. " FMT_D ")\n",
+                       (memSizeType) destWindow,
+                       destWindow != NULL ? to_window(destWindow) : 0,
+                       (memSizeType) atlas,
+                       atlas != NULL ? to_window(atlas) : 0,
+                       glyphs->min_position, glyphs->max_position););
+    numValues = arraySize(glyphs);
+    if (unlikely(numValues % GLYPH_ENTRY_SIZE != 0)) {
+      logError(printf("drwPutGlyphs(" FMT_U_MEM ", " FMT_U_MEM
+                      ", " FMT_D " .. " FMT_D "): "
+                      "Number of elements not a multiple of %d\n",
+                      (memSizeType) destWindow, (memSizeType) atlas,
+                      glyphs->min_position, glyphs->max_position,
+                      GLYPH_ENTRY_SIZE););
+      raise_error(RANGE_ERROR);
+    } else if (atlas != NULL && to_window(atlas) != 0) {
+      /* A pixmap value of NULL or a pixmap with a window of 0 */
+      /* is used to describe an empty pixmap. In this case     */
+      /* nothing should be done.                               */
+      for (pos = 0; successInfo == 0 && pos < numValues;
+           pos += GLYPH_ENTRY_SIZE) {
+        glyph = &glyphs->arr[pos];
+        if (unlikely(!inIntRange(glyph[0].value.intValue) ||
+                     !inIntRange(glyph[1].value.intValue) ||
+                     glyph[2].value.intValue < 0 ||
+                     glyph[2].value.intValue > INT_MAX ||
+                     glyph[3].value.intValue < 0 ||
+                     glyph[3].value.intValue > INT_MAX ||
+                     !inIntRange(glyph[4].value.intValue) ||
+                     !inIntRange(glyph[5].value.intValue))) {
+          logError(printf("drwPutGlyphs(" FMT_U_MEM ", " FMT_U_MEM
+                          ", " FMT_D " .. " FMT_D "): "
+                          "Glyph " FMT_U_MEM " not in allowed range\n",
+                          (memSizeType) destWindow, (memSizeType) atlas,
+                          glyphs->min_position, glyphs->max_position,
+                          pos / GLYPH_ENTRY_SIZE + 1););
+          raise_error(RANGE_ERROR);
+          successInfo = -1;
+        } else if (glyph[2].value.intValue != 0 &&
+                   glyph[3].value.intValue != 0) {
+          successInfo = EM_ASM_INT({
+            if (typeof window !== "undefined") {
+              if (typeof mapIdToContext[$0] === "undefined") {
+                return 2;
+              } else if (typeof mapIdToCanvas[$1] === "undefined") {
+                return 3;
+              } else {
+                mapIdToContext[$0].drawImage(mapIdToCanvas[$1],
+                    $2, $3, $4, $5, $6, $7, $4, $5);
+                return 0;
+              }
+            } else {
+              return 1;
+            }
+          }, to_window(destWindow), to_window(atlas),
+             (int) glyph[0].value.intValue, (int) glyph[1].value.intValue,
+             (int) glyph[2].value.intValue, (int) glyph[3].value.intValue,
+             (int) glyph[4].value.intValue, (int) glyph[5].value.intValue);
+          if (unlikely(successInfo != 0)) {
+            logError(printf("drwPutGlyphs(" FMT_U_MEM " (window=%d), "
+                            FMT_U_MEM " (window=%d), *): "
+                            "windowId not found: %d\n",
+                            (memSizeType) destWindow,
+                            destWindow != NULL ? to_window(destWindow) : 0,
+                            (memSizeType) atlas,
+                            atlas != NULL ? to_window(atlas) : 0,
+                            successInfo == 3 ?
+                            (atlas != NULL ? to_window(atlas) : 0) :
+                            (destWindow != NULL ? to_window(destWindow) : 0)););
+            raise_error(GRAPHIC_ERROR);
+          } /* if */
+        } /* if */
+      } /* for */
+    } /* if */
+  } /* drwPutGlyphs */
+
+
+
 void drwPutScaled (const_winType destWindow, intType xDest, intType yDest,
     intType width, intType height, const_winType pixmap)
 
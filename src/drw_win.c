@@ -2219,6 +2219,100 @@ void drwPut (const_winType destWindow, intType xDest, intType yDest,
 
 
 
+/**
+ *  Copy several areas (glyphs) of the pixmap 'atlas' to 'destWindow'.
+ *  The array 'glyphs' contains GLYPH_ENTRY_SIZE integers per glyph:
+ *  xSrc, ySrc, width, height, xDest and yDest.
+ */
+void drwPutGlyphs (const_winType destWindow, const_winType atlas,
+    const const_rtlArrayType glyphs)
+
+  {
+    memSizeType numValues;
+    memSizeType pos;
+    const rtlObjectType *glyph;
+    int xSrc;
+    int ySrc;
+    int width;
+    int height;
+    int xDest;
+    int yDest;
+    HDC hdcMem = 0;
+    boolType okay = TRUE;
+
+  /* drwPutGlyphs */
+    logFunction(printf("drwPutGlyphs(" FMT_U_MEM ", " FMT_U_MEM
+                       ", " FMT_D " .. " FMT_D ")\n",
+                       (memSizeType) destWindow, (memSizeType) atlas,
+                       glyphs->min_position, glyphs->max_position););
+    numValues = arraySize(glyphs);
+    if (unlikely(numValues % GLYPH_ENTRY_SIZE != 0)) {
+      logError(printf("drwPutGlyphs(" FMT_U_MEM ", " FMT_U_MEM
+                      ", " FMT_D " .. " FMT_D "): "
+                      "Number of elements not a multiple of %d\n",
+                      (memSizeType) destWindow, (memSizeType) atlas,
+                      glyphs->min_position, glyphs->max_position,
+                      GLYPH_ENTRY_SIZE););
+      raise_error(RANGE_ERROR);
+    } else if (atlas != NULL) {
+      if (to_hasTransparentPixel(atlas)) {
+        hdcMem = CreateCompatibleDC(0);
+        SelectObject(hdcMem, to_maskBitmap(atlas));
+      } /* if */
+      for (pos = 0; okay && pos < numValues; pos += GLYPH_ENTRY_SIZE) {
+        glyph = &glyphs->arr[pos];
+        if (unlikely(!inIntRange(glyph[0].value.intValue) ||
+                     !inIntRange(glyph[1].value.intValue) ||
+                     glyph[2].value.intValue < 0 ||
+                     glyph[2].value.intValue > INT_MAX ||
+                     glyph[3].value.intValue < 0 ||
+                     glyph[3].value.intValue > INT_MAX ||
+                     !inIntRange(glyph[4].value.intValue) ||
+                     !inIntRange(glyph[5].value.intValue))) {
+          logError(printf("drwPutGlyphs(" FMT_U_MEM ", " FMT_U_MEM
+                          ", " FMT_D " .. " FMT_D "): "
+                          "Glyph " FMT_U_MEM " not in allowed range\n",
+                          (memSizeType) destWindow, (memSizeType) atlas,
+                          glyphs->min_position, glyphs->max_position,
+                          pos / GLYPH_ENTRY_SIZE + 1););
+          raise_error(RANGE_ERROR);
+          okay = FALSE;
+        } else {
+          xSrc   = (int) glyph[0].value.intValue;
+          ySrc   = (int) glyph[1].value.intValue;
+          width  = (int) glyph[2].value.intValue;
+          height = (int) glyph[3].value.intValue;
+          xDest  = (int) glyph[4].value.intValue;
+          yDest  = (int) glyph[5].value.intValue;
+          if (hdcMem != 0) {
+            BitBlt(to_hdc(destWindow), xDest, yDest, width, height,
+                   hdcMem, xSrc, ySrc, SRCAND);
+            BitBlt(to_hdc(destWindow), xDest, yDest, width, height,
+                   to_hdc(atlas), xSrc, ySrc, SRCPAINT);
+            if (to_backup_hdc(destWindow) != 0) {
+              BitBlt(to_backup_hdc(destWindow), xDest, yDest, width, height,
+                     hdcMem, xSrc, ySrc, SRCAND);
+              BitBlt(to_backup_hdc(destWindow), xDest, yDest, width, height,
+                     to_hdc(atlas), xSrc, ySrc, SRCPAINT);
+            } /* if */
+          } else {
+            BitBlt(to_hdc(destWindow), xDest, yDest, width, height,
+                   to_hdc(atlas), xSrc, ySrc, SRCCOPY);
+            if (to_backup_hdc(destWindow) != 0) {
+              BitBlt(to_backup_hdc(destWindow), xDest, yDest, width, height,
+                     to_hdc(atlas), xSrc, ySrc, SRCCOPY);
+            } /* if */
+          } /* if */
+        } /* if */
+      } /* for */
+      if (hdcMem != 0) {
+        DeleteDC(hdcMem);
+      } /* if */
+    } /* if */
+  } /* drwPutGlyphs */
+
+
+
 void drwPutScaled (const_winType destWindow, intType xDest, intType yDest,
     intType width, intType height, const_winType pixmap)
 
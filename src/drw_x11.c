@@ -2417,6 +2417,92 @@ void drwPut (const_winType destWindow, intType xDest, intType yDest,
 
 
 
+/**
+ *  Copy several areas (glyphs) of the pixmap 'atlas' to 'destWindow'.
+ *  The array 'glyphs' contains GLYPH_ENTRY_SIZE integers per glyph:
+ *  xSrc, ySrc, width, height, xDest and yDest. The glyphs are copied
+ *  with XCopyArea requests, which Xlib sends together. The X protocol
+ *  uses 16-bit coordinates, so the source areas must be inside of
+ *  'atlas'. Otherwise RANGE_ERROR is raised.
+ */
+void drwPutGlyphs (const_winType destWindow, const_winType atlas,
+    const const_rtlArrayType glyphs)
+
+  {
+    memSizeType numValues;
+    memSizeType pos;
+    const rtlObjectType *glyph;
+    boolType okay = TRUE;
+
+  /* drwPutGlyphs */
+    logFunction(printf("drwPutGlyphs(" FMT_U_MEM ", " FMT_U_MEM
+                       ", " FMT_D " .. " FMT_D ")\n",
+                       (memSizeType) destWindow, (memSizeType) atlas,
+                       glyphs->min_position, glyphs->max_position););
+    numValues = arraySize(glyphs);
+    if (unlikely(numValues % GLYPH_ENTRY_SIZE != 0)) {
+      logError(printf("drwPutGlyphs(" FMT_U_MEM ", " FMT_U_MEM
+                      ", " FMT_D " .. " FMT_D "): "
+                      "Number of elements not a multiple of %d\n",
+                      (memSizeType) destWindow, (memSizeType) atlas,
+                      glyphs->min_position, glyphs->max_position,
+                      GLYPH_ENTRY_SIZE););
+      raise_error(RANGE_ERROR);
+    } else if (atlas != NULL && to_window(atlas) != 0) {
+      /* A pixmap value of NULL or a pixmap with a window of 0 */
+      /* is used to describe an empty pixmap. In this case     */
+      /* nothing should be done.                               */
+      for (pos = 0; okay && pos < numValues; pos += GLYPH_ENTRY_SIZE) {
+        glyph = &glyphs->arr[pos];
+        if (unlikely(glyph[0].value.intValue < 0 ||
+                     glyph[0].value.intValue > to_width(atlas) ||
+                     glyph[1].value.intValue < 0 ||
+                     glyph[1].value.intValue > to_height(atlas) ||
+                     glyph[2].value.intValue < 0 ||
+                     glyph[2].value.intValue >
+                         to_width(atlas) - glyph[0].value.intValue ||
+                     glyph[3].value.intValue < 0 ||
+                     glyph[3].value.intValue >
+                         to_height(atlas) - glyph[1].value.intValue ||
+                     !inIntRange(glyph[4].value.intValue) ||
+                     !inIntRange(glyph[5].value.intValue))) {
+          logError(printf("drwPutGlyphs(" FMT_U_MEM ", " FMT_U_MEM
+                          ", " FMT_D " .. " FMT_D "): "
+                          "Glyph " FMT_U_MEM " not in allowed range\n",
+                          (memSizeType) destWindow, (memSizeType) atlas,
+                          glyphs->min_position, glyphs->max_position,
+                          pos / GLYPH_ENTRY_SIZE + 1););
+          raise_error(RANGE_ERROR);
+          okay = FALSE;
+        } else {
+          if (to_clip_mask(atlas) != 0) {
+            XSetClipMask(mydisplay, mygc, to_clip_mask(atlas));
+            XSetClipOrigin(mydisplay, mygc,
+                (int) (glyph[4].value.intValue - glyph[0].value.intValue),
+                (int) (glyph[5].value.intValue - glyph[1].value.intValue));
+          } /* if */
+          XCopyArea(mydisplay, to_window(atlas), to_window(destWindow), mygc,
+                    (int) glyph[0].value.intValue, (int) glyph[1].value.intValue,
+                    (unsigned int) glyph[2].value.intValue,
+                    (unsigned int) glyph[3].value.intValue,
+                    (int) glyph[4].value.intValue, (int) glyph[5].value.intValue);
+          if (to_backup(destWindow) != 0) {
+            XCopyArea(mydisplay, to_window(atlas), to_backup(destWindow), mygc,
+                      (int) glyph[0].value.intValue, (int) glyph[1].value.intValue,
+                      (unsigned int) glyph[2].value.intValue,
+                      (unsigned int) glyph[3].value.intValue,
+                      (int) glyph[4].value.intValue, (int) glyph[5].value.intValue);
+          } /* if */
+        } /* if */
+      } /* for */
+      if (to_clip_mask(atlas) != 0) {
+        XSetClipMask(mydisplay, mygc, None);
+      } /* if */
+    } /* if */
+  } /* drwPutGlyphs */
+
+
+
 void drwPutScaled (const_winType destWindow, intType xDest, intType yDest,
     intType width, intType height, const_winType pixmap)
 
@@ -1307,6 +1307,47 @@ objectType drw_put (listType arguments)
 
 
 
+/**
+ *  Draw glyphs from the pixmap ''atlas'' to ''destWindow''.
+ *  Every glyph is described by GLYPH_ENTRY_SIZE integers: The
+ *  area (xSrc, ySrc, width, height) of ''atlas'' is copied to
+ *  the position (xDest, yDest) of ''destWindow''.
+ */
+objectType drw_put_glyphs (listType arguments)
+
+  {
+    arrayType glyphs_array;
+    memSizeType len;
+    rtlArrayType glyphs;
+    objectType curr_number;
+    memSizeType pos;
+
+  /* drw_put_glyphs */
+    isit_win(arg_1(arguments));
+    isit_win(arg_2(arguments));
+    isit_array(arg_3(arguments));
+    glyphs_array = take_array(arg_3(arguments));
+    len = arraySize(glyphs_array);
+    if (!ALLOC_RTL_ARRAY(glyphs, len)) {
+      return raise_exception(SYS_MEM_EXCEPTION);
+    } else {
+      glyphs->min_position = 1;
+      glyphs->max_position = (intType) (len);
+      curr_number = &glyphs_array->arr[0];
+      for (pos = 0; pos < len; pos++) {
+        isit_int(curr_number);
+        glyphs->arr[pos].value.intValue = take_int(curr_number);
+        curr_number++;
+      } /* for */
+      drwPutGlyphs(take_win(arg_1(arguments)),
+                   take_win(arg_2(arguments)), glyphs);
+      FREE_RTL_ARRAY(glyphs, len);
+    } /* if */
+    return SYS_EMPTY_OBJECT;
+  } /* drw_put_glyphs */
+
+
+
 objectType drw_put_scaled (listType arguments)
 
   {
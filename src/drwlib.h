@@ -78,6 +78,7 @@ objectType drw_poly_line                 (listType arguments);
 objectType drw_ppoint                    (listType arguments);
 objectType drw_prect                     (listType arguments);
 objectType drw_put                       (listType arguments);
+objectType drw_put_glyphs                (listType arguments);
 objectType drw_put_scaled                (listType arguments);
 objectType drw_rgbcol                    (listType arguments);
 objectType drw_rot                       (listType arguments);
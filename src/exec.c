@@ -52,6 +52,8 @@
 #include "runerr.h"
 #include "match.h"
 #include "prclib.h"
+#include "profutl.h"
+#include "tcode.h"
 
 #undef EXTERN
 #define EXTERN
@@ -155,6 +157,57 @@ objectType exec_object (register objectType object)
 
 
 
+/**
+ *  Activation records of interpreted functions are kept in one
+ *  contiguous stack of object slots. A frame starts with two slots
+ *  per formal parameter (the backup of the parameter value and the
+ *  evaluated actual parameter) followed by one backup slot per
+ *  local variable. Slots are addressed by index, since calls in
+ *  the middle of a frame setup may move the stack when it grows.
+ *  Entering a function bumps frame_top and leaving it resets
+ *  frame_top to the start of its frame. This avoids allocating
+ *  and freeing list elements for every call.
+ */
+static objectType *frame_stack = NULL;
+static memSizeType frame_stack_capacity = 0;
+static memSizeType frame_top = 0;
+
+#define FRAME_STACK_INCREMENT 1024
+
+
+
+static boolType grow_frame_stack (memSizeType minCapacity)
+
+  {
+    memSizeType newCapacity;
+    objectType *resizedFrameStack;
+    boolType okay = FALSE;
+
+  /* grow_frame_stack */
+    logFunction(printf("grow_frame_stack(" FMT_U_MEM ")\n", minCapacity););
+    newCapacity = frame_stack_capacity + FRAME_STACK_INCREMENT;
+    if (newCapacity < 2 * frame_stack_capacity) {
+      newCapacity = 2 * frame_stack_capacity;
+    } /* if */
+    if (newCapacity < minCapacity) {
+      newCapacity = minCapacity;
+    } /* if */
+    if (likely(newCapacity <= MAX_MEMSIZETYPE / sizeof(objectType))) {
+      resizedFrameStack = REALLOC_TABLE(frame_stack, objectType,
+          frame_stack_capacity, newCapacity);
+      if (resizedFrameStack != NULL) {
+        COUNT3_TABLE(objectType, frame_stack_capacity, newCapacity);
+        frame_stack = resizedFrameStack;
+        frame_stack_capacity = newCapacity;
+        okay = TRUE;
+      } /* if */
+    } /* if */
+    logFunction(printf("grow_frame_stack --> %d\n", okay););
+    return okay;
+  } /* grow_frame_stack */
+
+
+
 /**
  *  When a temporary value is entered into a reference parameter
  *  the TEMP flag must be cleared. This is necessary to avoid
@@ -172,47 +225,65 @@ objectType exec_object (register objectType object)
  *  functions are defined in seed7_05.s7i and take care of this.
  *  When a TEMP2 parameter is used for a deeper function call
  *  The TEMP2 flag is cleared to avoid unwanted effects.
+ *  @param evaluated_params Already evaluated actual parameters or
+ *         NULL, if the actual parameters must be evaluated.
+ *  @param frame_base Index of the first parameter slot in frame_stack.
+ *  @return the index of the first slot after the parameter slots.
  */
-static inline void par_init (locListType form_param_list,
-    listType *backup_form_params, listType act_param_list,
-    listType *evaluated_act_params)
+static inline memSizeType par_init (locListType form_param_list,
+    listType act_param_list, const_listType evaluated_params,
+    const memSizeType frame_base)
 
   {
     locListType form_param;
-    listType *backup_insert_place;
-    listType *evaluated_insert_place;
-    listType param_list_elem;
+    memSizeType slot;
+    memSizeType frame_end;
     objectType param_value;
     errInfoType err_info = OKAY_NO_ERROR;
 
   /* par_init */
     logFunction(printf("par_init\n"););
     form_param = form_param_list;
-    *backup_form_params = NULL;
-    backup_insert_place = backup_form_params;
-    *evaluated_act_params = NULL;
-    evaluated_insert_place = evaluated_act_params;
+    slot = frame_base;
     while (form_param != NULL && !fail_flag) {
-      append_to_list(backup_insert_place,
-          form_param->local.object->value.objValue, act_param_list);
-      param_value = exec_object(act_param_list->obj);
-      append_to_list(evaluated_insert_place, param_value, act_param_list);
-      form_param = form_param->next;
-      act_param_list = act_param_list->next;
+      if (unlikely(slot + 2 > frame_stack_capacity &&
+                   !grow_frame_stack(slot + 2))) {
+        raise_with_arguments(SYS_MEM_EXCEPTION, act_param_list);
+      } else {
+        frame_stack[slot] = form_param->local.object->value.objValue;
+        frame_stack[slot + 1] = NULL;
+        /* Calls during the evaluation use the slots after frame_top. */
+        frame_top = slot + 2;
+        if (evaluated_params != NULL) {
+          param_value = evaluated_params->obj;
+          evaluated_params = evaluated_params->next;
+        } else {
+          param_value = exec_object(act_param_list->obj);
+        } /* if */
+        frame_stack[slot + 1] = param_value;
+        slot += 2;
+        form_param = form_param->next;
+        act_param_list = act_param_list->next;
+      } /* if */
     } /* while */
+    frame_end = slot;
     if (fail_flag) {
-      param_list_elem = *evaluated_act_params;
-      while (param_list_elem != NULL) {
-        if (param_list_elem->obj != NULL && TEMP_OBJECT(param_list_elem->obj)) {
-          dump_any_temp(param_list_elem->obj);
+      for (slot = frame_base + 1; slot < frame_end; slot += 2) {
+        if (frame_stack[slot] != NULL && TEMP_OBJECT(frame_stack[slot])) {
+          dump_any_temp(frame_stack[slot]);
+        } /* if */
+      } /* for */
+      while (evaluated_params != NULL) {
+        if (evaluated_params->obj != NULL && TEMP_OBJECT(evaluated_params->obj)) {
+          dump_any_temp(evaluated_params->obj);
         } /* if */
-        param_list_elem = param_list_elem->next;
+        evaluated_params = evaluated_params->next;
       } /* while */
     } else {
       form_param = form_param_list;
-      param_list_elem = *evaluated_act_params;
+      slot = frame_base + 1;
       while (form_param != NULL && err_info == OKAY_NO_ERROR) {
-        param_value = param_list_elem->obj;
+        param_value = frame_stack[slot];
         switch (CATEGORY_OF_OBJ(form_param->local.object)) {
           case VALUEPARAMOBJECT:
 /*            printf("value param formal ");
@@ -224,7 +295,7 @@ static inline void par_init (locListType form_param_list,
               CLEAR_TEMP_FLAG(param_value);
               COPY_VAR_FLAG(param_value, form_param->local.object);
               form_param->local.object->value.objValue = param_value;
-              param_list_elem->obj = NULL;
+              frame_stack[slot] = NULL;
 /*              printf("assign temp ");
               trace1(form_param->local.object);
               printf(" %lu\n", (unsigned long) form_param->local.object); */
@@ -254,7 +325,7 @@ static inline void par_init (locListType form_param_list,
                      (memSizeType) form_param->local.object); */
             } else {
               CLEAR_TEMP2_FLAG(param_value);
-              param_list_elem->obj = NULL;
+              frame_stack[slot] = NULL;
             } /* if */
             break;
           default:
@@ -262,16 +333,17 @@ static inline void par_init (locListType form_param_list,
             break;
         } /* switch */
         form_param = form_param->next;
-        param_list_elem = param_list_elem->next;
+        slot += 2;
       } /* while */
     } /* if */
     logFunction(printf("par_init -->\n"););
+    return frame_end;
   } /* par_init */
 
 
 
 static inline void par_restore (const_locListType form_param,
-    const_listType backup_form_params, const_listType evaluated_act_params)
+    memSizeType slot)
 
   {
     failStateStruct savedFailState;
@@ -286,18 +358,17 @@ static inline void par_restore (const_locListType form_param,
             destroy_local_object(&form_param->local, TRUE);
             break;
           case REFPARAMOBJECT:
-            if (evaluated_act_params->obj != NULL) {
-              dump_any_temp(evaluated_act_params->obj);
+            if (frame_stack[slot + 1] != NULL) {
+              dump_any_temp(frame_stack[slot + 1]);
             } /* if */
             break;
           default:
             /* Do nothing for SYMBOLOBJECT and TYPEOBJECT. */
             break;
         } /* switch */
-        form_param->local.object->value.objValue = backup_form_params->obj;
+        form_param->local.object->value.objValue = frame_stack[slot];
         form_param = form_param->next;
-        backup_form_params = backup_form_params->next;
-        evaluated_act_params = evaluated_act_params->next;
+        slot += 2;
       } /* while */
       restoreFailState(&savedFailState);
     } else {
@@ -308,8 +379,8 @@ static inline void par_restore (const_locListType form_param,
               destroy_local_object(&form_param->local, FALSE);
               break;
             case REFPARAMOBJECT:
-              if (evaluated_act_params->obj != NULL) {
-                dump_any_temp(evaluated_act_params->obj);
+              if (frame_stack[slot + 1] != NULL) {
+                dump_any_temp(frame_stack[slot + 1]);
               } /* if */
               break;
             default:
@@ -317,10 +388,9 @@ static inline void par_restore (const_locListType form_param,
               break;
           } /* switch */
         } /* if */
-        form_param->local.object->value.objValue = backup_form_params->obj;
+        form_param->local.object->value.objValue = frame_stack[slot];
         form_param = form_param->next;
-        backup_form_params = backup_form_params->next;
-        evaluated_act_params = evaluated_act_params->next;
+        slot += 2;
       } /* while */
     } /* if */
     logFunction(printf("par_restore -->\n"););
@@ -328,29 +398,32 @@ static inline void par_restore (const_locListType form_param,
 
 
 
-static void loc_init (const_locListType loc_var, listType *backup_loc_var,
-    listType act_param_list)
+static void loc_init (const_locListType loc_var, listType act_param_list,
+    memSizeType slot)
 
   {
-    listType *list_insert_place;
     errInfoType err_info = OKAY_NO_ERROR;
 
   /* loc_init */
     logFunction(printf("loc_init\n"););
-    *backup_loc_var = NULL;
-    list_insert_place = backup_loc_var;
     while (loc_var != NULL && !fail_flag) {
-      append_to_list(list_insert_place,
-          loc_var->local.object->value.objValue, act_param_list);
-      create_local_object(&loc_var->local, loc_var->local.init_value, &err_info);
-      loc_var = loc_var->next;
+      if (unlikely(slot >= frame_stack_capacity &&
+                   !grow_frame_stack(slot + 1))) {
+        raise_with_arguments(SYS_MEM_EXCEPTION, act_param_list);
+      } else {
+        frame_stack[slot] = loc_var->local.object->value.objValue;
+        slot++;
+        frame_top = slot;
+        create_local_object(&loc_var->local, loc_var->local.init_value, &err_info);
+        loc_var = loc_var->next;
+      } /* if */
     } /* while */
     logFunction(printf("loc_init -->\n"););
   } /* loc_init */
 
 
 
-static void loc_restore (const_locListType loc_var, const_listType backup_loc_var)
+static void loc_restore (const_locListType loc_var, memSizeType slot)
 
   {
     failStateStruct savedFailState;
@@ -361,9 +434,9 @@ static void loc_restore (const_locListType loc_var, const_listType backup_loc_va
       saveFailState(&savedFailState);
       while (loc_var != NULL) {
         destroy_local_object(&loc_var->local, TRUE);
-        loc_var->local.object->value.objValue = backup_loc_var->obj;
+        loc_var->local.object->value.objValue = frame_stack[slot];
         loc_var = loc_var->next;
-        backup_loc_var = backup_loc_var->next;
+        slot++;
       } /* while */
       restoreFailState(&savedFailState);
     } else {
@@ -371,9 +444,9 @@ static void loc_restore (const_locListType loc_var, const_listType backup_loc_va
         if (likely(!fail_flag)) {
           destroy_local_object(&loc_var->local, FALSE);
         } /* if */
-        loc_var->local.object->value.objValue = backup_loc_var->obj;
+        loc_var->local.object->value.objValue = frame_stack[slot];
         loc_var = loc_var->next;
-        backup_loc_var = backup_loc_var->next;
+        slot++;
       } /* while */
     } /* if */
     logFunction(printf("loc_restore -->\n"););
@@ -486,32 +559,37 @@ static void show_arg_list (listType act_param_list)
 
 
 
-static objectType exec_lambda (const_blockType block,
-    listType actual_parameters, objectType object)
+static objectType exec_lambda (blockType block,
+    listType actual_parameters, const_listType evaluated_params,
+    objectType object)
 
   {
     objectType result;
-    listType evaluated_act_params;
-    listType backup_form_params;
+    memSizeType frame_base;
+    memSizeType loc_frame;
     objectType backup_block_result;
-    listType backup_loc_var;
 
   /* exec_lambda */
     logFunction(printf("exec_lambda\n"););
-    par_init(block->params, &backup_form_params, actual_parameters,
-        &evaluated_act_params);
+    frame_base = frame_top;
+    loc_frame = par_init(block->params, actual_parameters,
+        evaluated_params, frame_base);
     if (fail_flag) {
-      free_list(backup_form_params);
-      free_list(evaluated_act_params);
       result = fail_value;
     } else {
-      loc_init(block->local_vars, &backup_loc_var, actual_parameters);
+      loc_init(block->local_vars, actual_parameters, loc_frame);
       if (fail_flag) {
-        free_list(backup_loc_var);
         result = fail_value;
       } else {
         if (res_init(&block->result, &backup_block_result)) {
-          result = exec_call(block->body);
+          profEnter(CATEGORY_OF_OBJ(object) == CALLOBJECT ?
+                    object->value.listValue->obj : object);
+          if (tc_active) {
+            result = tcExecBody(block);
+          } else {
+            result = exec_call(block->body);
+          } /* if */
+          profLeave();
           if (fail_flag) {
             errInfoType ignored_err_info;
 
@@ -522,14 +600,11 @@ static objectType exec_lambda (const_blockType block,
         } else {
           result = raise_with_arguments(SYS_MEM_EXCEPTION, actual_parameters);
         } /* if */
-        loc_restore(block->local_vars, backup_loc_var);
-        free_list(backup_loc_var);
+        loc_restore(block->local_vars, loc_frame);
       } /* if */
-      /* show_arg_list(evaluated_act_params); */
-      par_restore(block->params, backup_form_params, evaluated_act_params);
-      free_list(backup_form_params);
-      free_list(evaluated_act_params);
+      par_restore(block->params, frame_base);
     } /* if */
+    frame_top = frame_base;
     logFunction(printf("exec_lambda --> ");
                 trace1(result);
                 printf("\n"););
@@ -538,7 +613,36 @@ static objectType exec_lambda (const_blockType block,
 
 
 
-static listType eval_arg_list (register listType act_param_list, uint32Type *temp_bits_ptr)
+/**
+ *  Call a Seed7 function with already evaluated actual parameters.
+ *  This is used by the threaded code of tcode.c.
+ *  @param actual_parameters The unevaluated actual parameters.
+ *  @param evaluated_params The evaluated actual parameters.
+ */
+objectType exec_evaluated_call (blockType block, listType actual_parameters,
+    const_listType evaluated_params, objectType object)
+
+  { /* exec_evaluated_call */
+    return exec_lambda(block, actual_parameters, evaluated_params, object);
+  } /* exec_evaluated_call */
+
+
+
+#define ARG_ARRAY_SIZE 8
+
+
+
+/**
+ *  Evaluate the actual parameters of an action.
+ *  The first ARG_ARRAY_SIZE list elements of the result are taken
+ *  from arg_array, which is provided by the caller (usually on the
+ *  C stack). Only further parameters get list elements from the
+ *  heap. This way most primitive calls need no list allocations.
+ *  @param arg_array Array of ARG_ARRAY_SIZE list elements.
+ *  @return the list of evaluated parameters.
+ */
+static listType eval_arg_list (register listType act_param_list,
+    listRecord *arg_array, uint32Type *temp_bits_ptr)
 
   {
     listType evaluated_act_params = NULL;
@@ -548,10 +652,18 @@ static listType eval_arg_list (register listType act_param_list, uint32Type *tem
     int param_num = 0;
 
   /* eval_arg_list */
+    arg_array[ARG_ARRAY_SIZE - 1].next = NULL;
     evaluated_insert_place = &evaluated_act_params;
     while (act_param_list != NULL && !fail_flag) {
       evaluated_object = exec_object(act_param_list->obj);
-      append_to_list(evaluated_insert_place, evaluated_object, act_param_list);
+      if (likely(param_num < ARG_ARRAY_SIZE)) {
+        arg_array[param_num].next = NULL;
+        arg_array[param_num].obj = evaluated_object;
+        *evaluated_insert_place = &arg_array[param_num];
+        evaluated_insert_place = &arg_array[param_num].next;
+      } else {
+        append_to_list(evaluated_insert_place, evaluated_object, act_param_list);
+      } /* if */
       if (evaluated_object != NULL && TEMP_OBJECT(evaluated_object)) {
         temp_bits |= (uint32Type) 1 << param_num;
       } /* if */
@@ -564,25 +676,27 @@ static listType eval_arg_list (register listType act_param_list, uint32Type *tem
 
 
 
-static void dump_arg_list (listType evaluated_act_params, uint32Type temp_bits)
+/**
+ *  Free the temporary parameters of an action and the list elements
+ *  that eval_arg_list() took from the heap.
+ */
+static void dump_arg_list (listType evaluated_act_params,
+    listRecord *arg_array, uint32Type temp_bits)
 
   {
-    register listType list_end;
+    register listType list_elem;
 
   /* dump_arg_list */
-    if (evaluated_act_params != NULL) {
-      list_end = evaluated_act_params;
-      while (list_end->next != NULL) {
-        if (list_end->obj != NULL && temp_bits & 1 && TEMP_OBJECT(list_end->obj)) {
-          dump_any_temp(list_end->obj);
-        } /* if */
-        list_end = list_end->next;
-        temp_bits >>= 1;
-      } /* while */
-      if (list_end->obj != NULL && temp_bits & 1 && TEMP_OBJECT(list_end->obj)) {
-        dump_any_temp(list_end->obj);
+    list_elem = evaluated_act_params;
+    while (temp_bits != 0) {
+      if (temp_bits & 1 && list_elem->obj != NULL && TEMP_OBJECT(list_elem->obj)) {
+        dump_any_temp(list_elem->obj);
       } /* if */
-      free_list2(evaluated_act_params, list_end);
+      list_elem = list_elem->next;
+      temp_bits >>= 1;
+    } /* while */
+    if (unlikely(arg_array[ARG_ARRAY_SIZE - 1].next != NULL)) {
+      free_list(arg_array[ARG_ARRAY_SIZE - 1].next);
     } /* if */
   } /* dump_arg_list */
 
@@ -592,7 +706,9 @@ static objectType exec_action (const_objectType act_object,
     listType act_param_list, objectType object)
 
   {
+    listRecord arg_array[ARG_ARRAY_SIZE];
     listType evaluated_act_params;
+    listType backup_argument_list;
     uint32Type temp_bits;
     objectType result;
 
@@ -604,7 +720,8 @@ static objectType exec_action (const_objectType act_object,
       return raise_with_arguments(SYS_MEM_EXCEPTION, act_param_list);
     } /* if */
 #endif
-    evaluated_act_params = eval_arg_list(act_param_list, &temp_bits);
+    backup_argument_list = curr_argument_list;
+    evaluated_act_params = eval_arg_list(act_param_list, arg_array, &temp_bits);
     if (interrupt_flag) {
       if (!fail_flag) {
         curr_exec_object = object;
@@ -612,7 +729,8 @@ static objectType exec_action (const_objectType act_object,
         show_signal();
       } /* if */
       if (fail_flag) {
-        dump_arg_list(evaluated_act_params, temp_bits);
+        dump_arg_list(evaluated_act_params, arg_array, temp_bits);
+        curr_argument_list = backup_argument_list;
         result = fail_value;
         logFunction(printf("exec_action fail_flag=%d -->\n", fail_flag););
         return result;
@@ -651,7 +769,9 @@ static objectType exec_action (const_objectType act_object,
       /* curr_action_object = act_object; */
       curr_exec_object = object;
       curr_argument_list = evaluated_act_params;
+      profEnter(act_object);
       result = (*(act_object->value.actValue))(evaluated_act_params);
+      profLeave();
       if (act_object->type_of != NULL) {
         if (act_object->type_of->result_type != NULL) {
           if (result != NULL) {
@@ -693,14 +813,18 @@ static objectType exec_action (const_objectType act_object,
       /* curr_action_object = act_object; */
       curr_exec_object = object;
       curr_argument_list = evaluated_act_params;
+      profEnter(act_object);
       result = (*(act_object->value.actValue))(evaluated_act_params);
+      profLeave();
       if (result != NULL && result->type_of == NULL) {
         result->type_of = act_object->type_of->result_type;
       } /* if */
 #ifdef WITH_PROTOCOL
     } /* if */
 #endif
-    dump_arg_list(evaluated_act_params, temp_bits);
+    dump_arg_list(evaluated_act_params, arg_array, temp_bits);
+    /* The evaluated parameters do not outlive this call. */
+    curr_argument_list = backup_argument_list;
     logFunction(printf("exec_action fail_flag=%d -->\n", fail_flag););
     return result;
   } /* exec_action */
@@ -760,7 +884,7 @@ objectType exec_call (objectType object)
         prot_list(actual_parameters);
         printf("\n"); */
         result = exec_lambda(subroutine_object->value.blockValue,
-            actual_parameters, object);
+            actual_parameters, NULL, object);
         break;
       case CONSTENUMOBJECT:
 /*        printf("constenumobject ");
@@ -935,7 +1059,7 @@ objectType evaluate (objectType object)
         result = object;
         break;
       case BLOCKOBJECT:
-        result = exec_lambda(object->value.blockValue, NULL, object);
+        result = exec_lambda(object->value.blockValue, NULL, NULL, object);
         break;
       case ACTOBJECT:
         result = exec_action(object, NULL, NULL);
@@ -956,6 +1080,230 @@ objectType evaluate (objectType object)
 
 
 
+/**
+ *  Inline caches for the call sites of DYNAMIC functions.
+ *  Every call site (the object that invokes exec_dynamic) is
+ *  hashed to a bucket with up to DYN_CACHE_WAYS entries. An entry
+ *  describes the elements of an expression that has been matched
+ *  and the implementation found by the match. Elements that are
+ *  symbols, types or parameters are described by their identity.
+ *  Other elements are described by their type, their category and
+ *  their VAR flag. These are the properties that match_subexpr()
+ *  uses to select an implementation. The elements that the match
+ *  replaced by the symbol of their entity are remembered as well.
+ *  A bucket is valid as long as no declaration has been added or
+ *  removed since it has been filled (see declaration_generation).
+ */
+#define DYN_CACHE_SIZE 256
+#define DYN_CACHE_WAYS 4
+#define DYN_CACHE_MAX_ELEMENTS 8
+
+typedef struct {
+    objectType identity;
+    typeType type;
+    unsigned int kind;
+  } dynKeyRecord;
+
+typedef struct {
+    objectType implementation;
+    memSizeType length;
+    dynKeyRecord key[DYN_CACHE_MAX_ELEMENTS];
+    objectType replacement[DYN_CACHE_MAX_ELEMENTS];
+  } dynEntryRecord;
+
+typedef struct {
+    const_objectType call_site;
+    const_progType owner_prog;
+    uintType generation;
+    unsigned int num_entries;
+    unsigned int next_entry;
+    dynEntryRecord entry[DYN_CACHE_WAYS];
+  } dynBucketRecord;
+
+static dynBucketRecord dyn_cache[DYN_CACHE_SIZE];
+
+#define DYN_BUCKET(call_site) \
+    (&dyn_cache[((memSizeType) (call_site) / sizeof(objectRecord)) & \
+                (DYN_CACHE_SIZE - 1)])
+
+
+
+/**
+ *  Determine the cache key of an element of a dynamic call.
+ *  @return TRUE if the element can be cached, or
+ *          FALSE if matching the element depends on its contents.
+ */
+static boolType dyn_element_key (const objectType element, dynKeyRecord *key)
+
+  {
+    boolType cacheable = TRUE;
+
+  /* dyn_element_key */
+    switch (CATEGORY_OF_OBJ(element)) {
+      case EXPROBJECT:
+      case CALLOBJECT:
+      case MATCHOBJECT:
+      case BLOCKOBJECT:
+      case ACTOBJECT:
+        cacheable = FALSE;
+        break;
+      case TYPEOBJECT:
+      case VALUEPARAMOBJECT:
+      case REFPARAMOBJECT:
+      case RESULTOBJECT:
+      case LOCALVOBJECT:
+        key->identity = element;
+        key->type = NULL;
+        key->kind = 0;
+        break;
+      default:
+        if (HAS_ENTITY(element)) {
+          key->identity = element;
+          key->type = NULL;
+          key->kind = 0;
+        } else if (element->type_of != NULL) {
+          key->identity = NULL;
+          key->type = element->type_of;
+          key->kind = ((unsigned int) CATEGORY_OF_OBJ(element) << 1) |
+                      (VAR_OBJECT(element) ? 1 : 0);
+        } else {
+          cacheable = FALSE;
+        } /* if */
+        break;
+    } /* switch */
+    return cacheable;
+  } /* dyn_element_key */
+
+
+
+static const dynEntryRecord *dyn_cache_lookup (const_objectType call_site,
+    const dynKeyRecord *key, memSizeType length)
+
+  {
+    dynBucketRecord *bucket;
+    unsigned int entryNum;
+    const dynEntryRecord *entry;
+    memSizeType pos;
+
+  /* dyn_cache_lookup */
+    bucket = DYN_BUCKET(call_site);
+    if (bucket->call_site == call_site && bucket->owner_prog == prog &&
+        bucket->generation == declaration_generation) {
+      for (entryNum = 0; entryNum < bucket->num_entries; entryNum++) {
+        entry = &bucket->entry[entryNum];
+        if (entry->length == length) {
+          pos = 0;
+          while (pos < length &&
+                 entry->key[pos].identity == key[pos].identity &&
+                 entry->key[pos].type == key[pos].type &&
+                 entry->key[pos].kind == key[pos].kind) {
+            pos++;
+          } /* while */
+          if (pos == length) {
+            return entry;
+          } /* if */
+        } /* if */
+      } /* for */
+    } /* if */
+    return NULL;
+  } /* dyn_cache_lookup */
+
+
+
+/**
+ *  Remember the result of a successful match of a dynamic call.
+ *  The match is only cached if every element of the matched
+ *  expression is either the original element or the symbol of
+ *  its entity. Other replacements (e.g. wrapped functions) are
+ *  created anew by every match and cannot be cached.
+ */
+static void dyn_cache_store (const_objectType call_site,
+    const dynKeyRecord *key, const objectType *element,
+    memSizeType length, const_listType matched_list)
+
+  {
+    objectType implementation;
+    objectType replacement[DYN_CACHE_MAX_ELEMENTS];
+    memSizeType pos = 0;
+    dynBucketRecord *bucket;
+    dynEntryRecord *entry;
+
+  /* dyn_cache_store */
+    if (matched_list == NULL) {
+      return;
+    } /* if */
+    implementation = matched_list->obj;
+    matched_list = matched_list->next;
+    while (pos < length && matched_list != NULL) {
+      if (matched_list->obj == element[pos]) {
+        replacement[pos] = NULL;
+      } else if (HAS_ENTITY(element[pos]) &&
+                 GET_ENTITY(element[pos])->syobject == matched_list->obj) {
+        replacement[pos] = matched_list->obj;
+      } else {
+        return;
+      } /* if */
+      matched_list = matched_list->next;
+      pos++;
+    } /* while */
+    if (pos == length && matched_list == NULL) {
+      bucket = DYN_BUCKET(call_site);
+      if (bucket->call_site != call_site || bucket->owner_prog != prog ||
+          bucket->generation != declaration_generation) {
+        bucket->call_site = call_site;
+        bucket->owner_prog = prog;
+        bucket->generation = declaration_generation;
+        bucket->num_entries = 0;
+        bucket->next_entry = 0;
+      } /* if */
+      if (bucket->num_entries < DYN_CACHE_WAYS) {
+        entry = &bucket->entry[bucket->num_entries];
+        bucket->num_entries++;
+      } else {
+        entry = &bucket->entry[bucket->next_entry];
+        bucket->next_entry = (bucket->next_entry + 1) % DYN_CACHE_WAYS;
+      } /* if */
+      entry->implementation = implementation;
+      entry->length = length;
+      memcpy(entry->key, key, length * sizeof(dynKeyRecord));
+      memcpy(entry->replacement, replacement, length * sizeof(objectType));
+    } /* if */
+  } /* dyn_cache_store */
+
+
+
+/**
+ *  Turn the expression of a dynamic call into the expression that
+ *  match_prog_expression() and match_object() would produce.
+ *  @return the matched expression, or NULL if a memory error occurred.
+ */
+static objectType dyn_cached_match (objectType match_expr,
+    const dynEntryRecord *cached, errInfoType *err_info)
+
+  {
+    listType matched_element;
+    memSizeType pos = 0;
+
+  /* dyn_cached_match */
+    matched_element = match_expr->value.listValue;
+    while (matched_element != NULL) {
+      if (cached->replacement[pos] != NULL) {
+        matched_element->obj = cached->replacement[pos];
+      } /* if */
+      matched_element = matched_element->next;
+      pos++;
+    } /* while */
+    incl_list(&match_expr->value.listValue, cached->implementation, err_info);
+    if (unlikely(*err_info != OKAY_NO_ERROR)) {
+      return NULL;
+    } /* if */
+    match_expr->type_of = cached->implementation->type_of;
+    SET_CATEGORY_OF_OBJ(match_expr, CALLOBJECT);
+    return match_expr;
+  } /* dyn_cached_match */
+
+
+
 objectType exec_dynamic (listType expr_list)
 
   {
@@ -968,6 +1316,11 @@ objectType exec_dynamic (listType expr_list)
     listType *temp_insert_place;
     listType temp_list_end;
     objectType match_result;
+    dynKeyRecord key[DYN_CACHE_MAX_ELEMENTS];
+    objectType element[DYN_CACHE_MAX_ELEMENTS];
+    memSizeType length = 0;
+    boolType cacheable;
+    const dynEntryRecord *cached;
     errInfoType err_info = OKAY_NO_ERROR;
     objectType result = NULL;
 
@@ -996,6 +1349,7 @@ objectType exec_dynamic (listType expr_list)
       list_insert_place = &match_expr->value.listValue;
       INIT_CATEGORY_OF_OBJ(match_expr, EXPROBJECT);
       temp_insert_place = &temp_values;
+      cacheable = !trace.match;
       actual_element = expr_list;
       while (actual_element != NULL && err_info == OKAY_NO_ERROR) {
         logMessage(printf("actual_element->obj ");
@@ -1039,6 +1393,15 @@ objectType exec_dynamic (listType expr_list)
             temp_insert_place = append_element_to_list(temp_insert_place,
                 element_value, &err_info);
           } /* if */
+          if (cacheable) {
+            if (length < DYN_CACHE_MAX_ELEMENTS &&
+                dyn_element_key(element_value, &key[length])) {
+              element[length] = element_value;
+              length++;
+            } else {
+              cacheable = FALSE;
+            } /* if */
+          } /* if */
           if (likely(err_info == OKAY_NO_ERROR)) {
             list_insert_place = append_element_to_list(list_insert_place,
                 element_value, &err_info);
@@ -1061,53 +1424,63 @@ objectType exec_dynamic (listType expr_list)
         logMessage(printf("match_expr ");
                    trace1(match_expr);
                    printf("\n"););
-        if (match_prog_expression(prog->declaration_root, match_expr) != NULL) {
-          if ((match_result = match_object(match_expr)) != NULL) {
+        if (cacheable &&
+            (cached = dyn_cache_lookup(dynamic_call_obj, key, length)) != NULL) {
+          match_result = dyn_cached_match(match_expr, cached, &err_info);
+        } else if (match_prog_expression(prog->declaration_root, match_expr) != NULL) {
+          if (cacheable) {
+            dyn_cache_store(dynamic_call_obj, key, element, length,
+                            match_expr->value.listValue);
+          } /* if */
+          match_result = match_object(match_expr);
+          if (unlikely(match_result == NULL)) {
+            logError(printf("exec_dynamic: match_object() failed.\n");
+                     trace1(match_expr);
+                     printf("\n"););
+            err_info = ACTION_ERROR;
+          } /* if */
+        } else {
+          logError(printf("exec_dynamic: match_prog_expression() failed.\n");
+                   trace1(match_expr);
+                   printf("\n"););
+          match_result = NULL;
+          err_info = ACTION_ERROR;
+        } /* if */
+        if (match_result != NULL) {
 #ifdef WITH_PROTOCOL
-            if (trace.dynamic) {
-              prot_cstri("matched ==> ");
-              trace1(match_result);
-            } /* if */
+          if (trace.dynamic) {
+            prot_cstri("matched ==> ");
+            trace1(match_result);
+          } /* if */
 #endif
-            if (match_result->value.listValue->obj != dynamic_call_obj->value.listValue->obj) {
-              result = exec_call(match_result);
-              if (fail_flag) {
-                errInfoType ignored_err_info;
-
-                if (fail_stack->obj == match_result) {
-                  pop_list(&fail_stack);
-                } /* if */
-                /* Since an exception has already been     */
-                /* raised ignored_err_info is not checked. */
-                incl_list(&fail_stack, dynamic_call_obj, &ignored_err_info);
+          if (match_result->value.listValue->obj != dynamic_call_obj->value.listValue->obj) {
+            result = exec_call(match_result);
+            if (fail_flag) {
+              errInfoType ignored_err_info;
+
+              if (fail_stack->obj == match_result) {
+                pop_list(&fail_stack);
               } /* if */
+              /* Since an exception has already been     */
+              /* raised ignored_err_info is not checked. */
+              incl_list(&fail_stack, dynamic_call_obj, &ignored_err_info);
+            } /* if */
 
 #ifdef WITH_PROTOCOL
-              if (trace.dynamic) {
-                if (trace.heapsize) {
-                  prot_cstri(" ");
-                  prot_heapsize();
-                } /* if */
-                prot_nl();
+            if (trace.dynamic) {
+              if (trace.heapsize) {
+                prot_cstri(" ");
+                prot_heapsize();
               } /* if */
-#endif
-            } else {
-              logError(printf("exec_dynamic: Endless recursion.\n");
-                       trace1(match_expr);
-                       printf("\n"););
-              err_info = ACTION_ERROR;
+              prot_nl();
             } /* if */
+#endif
           } else {
-            logError(printf("exec_dynamic: match_object() failed.\n");
+            logError(printf("exec_dynamic: Endless recursion.\n");
                      trace1(match_expr);
                      printf("\n"););
             err_info = ACTION_ERROR;
           } /* if */
-        } else {
-          logError(printf("exec_dynamic: match_prog_expression() failed.\n");
-                   trace1(match_expr);
-                   printf("\n"););
-          err_info = ACTION_ERROR;
         } /* if */
       } /* if */
       free_list(match_expr->value.listValue);
@@ -27,8 +27,10 @@
 
 #ifdef DO_INIT
 volatile boolType interrupt_flag = FALSE;
+uintType declaration_generation = 0;
 #else
 EXTERN volatile boolType interrupt_flag;
+EXTERN uintType declaration_generation;
 #endif
 EXTERN volatile int signal_number;
 
@@ -36,6 +38,8 @@ EXTERN volatile int signal_number;
 void doSuspendInterpreter (int signalNum);
 objectType exec_object (register objectType object);
 objectType exec_call (objectType object);
+objectType exec_evaluated_call (blockType block, listType actual_parameters,
+    const_listType evaluated_params, objectType object);
 objectType do_exec_call (objectType object, errInfoType *err_info);
 objectType evaluate (objectType object);
 objectType exec_dynamic (listType expr_list);
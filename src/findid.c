@@ -58,76 +58,15 @@
 
 
 
-static inline identType id_generation (ustriType name, sySizeType length)
-
-  {
-    register identType created_ident;
-
-  /* id_generation */
-    logFunction(printf("id_generation\n"););
-    if ((created_ident = new_ident(name, length)) == NULL) {
-      fatal_memory_error(SOURCE_POSITION(2041));
-    } /* if */
-    logFunction(printf("id_generation -->\n"););
-    return created_ident;
-  } /* id_generation */
-
-
-
 void find_normal_ident (sySizeType length)
 
-  {                                                             /*  0.62% */
-    register identType search_ident;
-    register int comparison;
-
-  /* find_normal_ident */
+  { /* find_normal_ident */
     logFunction(printf("find_normal_ident\n"););
-    if ((search_ident = IDENT_TABLE(prog, symbol.name, length)) != NULL) { /*  1.49% */
-      if ((comparison = strcmp((cstriType) symbol.name,
-          (cstriType) search_ident->name)) != 0) {              /*  0.73% */
-        do {
-          if (comparison < 0) {                                 /*  0.07% */
-            if (search_ident->next1 == NULL) {                  /*  0.08% */
-              search_ident->next1 = id_generation(symbol.name, length);
-              search_ident = search_ident->next1;
-              current_ident = search_ident;
-              return;
-              /* The following statement can be used instead of the       */
-              /* above two statements to avoid middle function returns.   */
-#ifdef OUT_OF_ORDER
-              comparison = 0;
-#endif
-            } else {
-              search_ident = search_ident->next1;               /*  0.02% */
-              comparison = strcmp((cstriType) symbol.name,
-                  (cstriType) search_ident->name);              /*  0.09% */
-            } /* if */
-          } else {                                              /*  0.02% */
-            if (search_ident->next2 == NULL) {                  /*  0.06% */
-              search_ident->next2 = id_generation(symbol.name, length); /*  0.01% */
-              search_ident = search_ident->next2;
-              current_ident = search_ident;
-              return;
-              /* The following statement can be used instead of the       */
-              /* above two statements to avoid middle function returns.   */
-#ifdef OUT_OF_ORDER
-              comparison = 0;
-#endif
-            } else {
-              search_ident = search_ident->next2;               /*  0.01% */
-              comparison = strcmp((cstriType) symbol.name,
-                  (cstriType) search_ident->name);              /*  0.07% */
-            } /* if */
-          } /* if */
-        } while (comparison != 0);                              /*  0.07% */
-      } /* if */
-      current_ident = search_ident;                             /*  0.12% */
-    } else {
-      current_ident = id_generation(symbol.name, length);       /*  0.01% */
-      IDENT_TABLE(prog, symbol.name, length) = current_ident;   /*  0.02% */
+    if ((current_ident = find_ident(prog, symbol.name, length)) == NULL) {
+      fatal_memory_error(SOURCE_POSITION(2041));
     } /* if */
     logFunction(printf("find_normal_ident -->\n"););
-  } /* find_normal_ident */                                     /*  0.62% */
+  } /* find_normal_ident */
 
 
 
@@ -174,34 +113,24 @@ boolType list_of_syntax_elements_okay (const_listType elem_list)
 
 
 
-static void clean_ident_tree (identType actual_ident)
-
-  { /* clean_ident_tree */
-    logFunction(printf("clean_ident_tree\n"););
-    if (actual_ident != NULL) {
-      clean_ident_tree(actual_ident->next1);
-      free_tokens(actual_ident->prefix_token);
-      actual_ident->prefix_token = NULL;
-      free_tokens(actual_ident->infix_token);
-      actual_ident->infix_token = NULL;
-      clean_ident_tree(actual_ident->next2);
-    } /* if */
-    logFunction(printf("clean_ident_tree -->\n"););
-  } /* clean_ident_tree */
-
-
-
 void clean_idents (progType aProg)
 
   {
-    int position;
+    memSizeType position;
     int character;
     identType actual_ident;
 
   /* clean_idents */
     logFunction(printf("clean_idents\n"););
-    for (position = 0; position < ID_TABLE_SIZE; position++) {
-      clean_ident_tree(aProg->ident.table[position]);
+    for (position = 0; position < aProg->ident.table_size; position++) {
+      actual_ident = aProg->ident.table[position];
+      while (actual_ident != NULL) {
+        free_tokens(actual_ident->prefix_token);
+        actual_ident->prefix_token = NULL;
+        free_tokens(actual_ident->infix_token);
+        actual_ident->infix_token = NULL;
+        actual_ident = actual_ident->next;
+      } /* while */
     } /* for */
     for (character = '!'; character <= '~'; character++) {
       if (op_character(character) ||
@@ -221,13 +150,12 @@ void clean_idents (progType aProg)
 
 
 
-static void wri_binary_ident_tree (progType aProg,
+static void wri_ident_chain (progType aProg,
     const_identType actual_ident)
 
-  { /* wri_binary_ident_tree */
-    logFunction(printf("wri_binary_ident_tree\n"););
-    if (actual_ident != NULL) {
-      wri_binary_ident_tree(aProg, actual_ident->next1);
+  { /* wri_ident_chain */
+    logFunction(printf("wri_ident_chain\n"););
+    while (actual_ident != NULL) {
       prot_cstri8(id_string(actual_ident));
       prot_cstri(" ");
       if (actual_ident->entity != NULL &&
@@ -242,27 +170,27 @@ static void wri_binary_ident_tree (progType aProg,
         } /* if */
       } /* if */
       prot_nl();
-      wri_binary_ident_tree(aProg, actual_ident->next2);
-    } /* if */
-    logFunction(printf("wri_binary_ident_tree -->\n"););
-  } /* wri_binary_ident_tree */
+      actual_ident = actual_ident->next;
+    } /* while */
+    logFunction(printf("wri_ident_chain -->\n"););
+  } /* wri_ident_chain */
 
 
 
 void write_idents (progType aProg)
 
   {
-    int position;
+    memSizeType position;
     int character;
     identType actual_ident;
 
   /* write_idents */
     logFunction(printf("write_idents\n"););
-    for (position = 0; position < ID_TABLE_SIZE; position++) {
+    for (position = 0; position < aProg->ident.table_size; position++) {
       prot_cstri(" ====== ");
       prot_int((intType) position);
       prot_cstri(" ======\n");
-      wri_binary_ident_tree(aProg, aProg->ident.table[position]);
+      wri_ident_chain(aProg, aProg->ident.table[position]);
     } /* for */
     for (character = '!'; character <= '~'; character++) {
       if (op_character(character) ||
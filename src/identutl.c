@@ -41,6 +41,7 @@
 #include "flistutl.h"
 #include "chclsutl.h"
 #include "entutl.h"
+#include "stat.h"
 
 #undef EXTERN
 #define EXTERN
@@ -64,8 +65,8 @@ identType new_ident (const_ustriType name, sySizeType length)
         memcpy(created_ident->name, name, (size_t) length);
         created_ident->name[length] = '\0';
         created_ident->length = length;
-        created_ident->next1 = NULL;
-        created_ident->next2 = NULL;
+        created_ident->hash = 0;
+        created_ident->next = NULL;
         created_ident->prefix_priority = 0;
         created_ident->infix_priority = 0;
         created_ident->left_token_priority = -1;
@@ -86,8 +87,6 @@ static void free_ident (const_progType currentProg, identType old_ident)
     logFunction(printf("free_ident\n"););
     if (old_ident != NULL) {
       FREE_ID_NAME(old_ident->name, old_ident->length);
-      free_ident(currentProg, old_ident->next1);
-      free_ident(currentProg, old_ident->next2);
       free_entity(currentProg, old_ident->entity);
       FREE_RECORD(old_ident, identRecord, count.ident);
     } /* if */
@@ -96,12 +95,126 @@ static void free_ident (const_progType currentProg, identType old_ident)
 
 
 
+/**
+ *  Compute the hash value of an identifier name (FNV-1a).
+ *  All characters of the name contribute to the hash value.
+ */
+static inline uint32Type hash_ident_name (const_ustriType name,
+    sySizeType length)
+
+  {
+    register uint32Type hash = 2166136261U;
+
+  /* hash_ident_name */
+    while (length != 0) {
+      hash = (hash ^ (uint32Type) *name) * 16777619U;
+      name++;
+      length--;
+    } /* while */
+    return hash;
+  } /* hash_ident_name */
+
+
+
+/**
+ *  Double the size of the identifier hash table.
+ *  If there is not enough memory the table keeps its size. In this
+ *  case the identifiers are still found, but the chains get longer.
+ *  The grow_limit is raised in both cases, such that a failed
+ *  allocation is not retried with every new identifier.
+ */
+static void grow_ident_table (progType currentProg)
+
+  {
+    memSizeType old_size;
+    memSizeType new_size;
+    identType *new_table;
+    memSizeType position;
+    identType ident;
+    identType next_ident;
+
+  /* grow_ident_table */
+    logFunction(printf("grow_ident_table\n"););
+    old_size = currentProg->ident.table_size;
+    new_size = old_size << 1;
+    if (ALLOC_TABLE(new_table, identType, new_size)) {
+      memset(new_table, 0, new_size * sizeof(identType));
+      for (position = 0; position < old_size; position++) {
+        ident = currentProg->ident.table[position];
+        while (ident != NULL) {
+          next_ident = ident->next;
+          ident->next = new_table[ident->hash & (new_size - 1)];
+          new_table[ident->hash & (new_size - 1)] = ident;
+          ident = next_ident;
+        } /* while */
+      } /* for */
+      FREE_TABLE(currentProg->ident.table, identType, old_size);
+      currentProg->ident.table = new_table;
+      currentProg->ident.table_size = new_size;
+      currentProg->ident.grow_limit = new_size;
+    } else {
+      /* Try again when the number of identifiers has doubled. */
+      currentProg->ident.grow_limit = currentProg->ident.number_of_idents << 1;
+    } /* if */
+    logFunction(printf("grow_ident_table --> " FMT_U_MEM "\n",
+                       currentProg->ident.table_size););
+  } /* grow_ident_table */
+
+
+
+/**
+ *  Search an identifier in the identifier hash table.
+ *  If the identifier is not present it is created and inserted.
+ *  The table is doubled in size as soon as it contains more
+ *  identifiers than its grow_limit (normally the number of entries).
+ *  @return the identifier or NULL if there is not enough memory.
+ */
+identType find_ident (progType currentProg, const_ustriType name,
+    sySizeType length)
+
+  {
+    register uint32Type hash;
+    register identType ident_found;
+    identType *bucket;
+
+  /* find_ident */
+    logFunction(printf("find_ident(\"%s\")\n", name););
+    hash = hash_ident_name(name, length);
+    bucket = &currentProg->ident.table[hash & (currentProg->ident.table_size - 1)];
+    ident_found = *bucket;
+#if WITH_COMPILATION_INFO
+    ident_lookups++;
+#endif
+    while (ident_found != NULL &&
+           (ident_found->hash != hash || ident_found->length != length ||
+            memcmp(ident_found->name, name, (size_t) length) != 0)) {
+#if WITH_COMPILATION_INFO
+      ident_probes++;
+#endif
+      ident_found = ident_found->next;
+    } /* while */
+    if (ident_found == NULL) {
+      if ((ident_found = new_ident(name, length)) != NULL) {
+        ident_found->hash = hash;
+        ident_found->next = *bucket;
+        *bucket = ident_found;
+        currentProg->ident.number_of_idents++;
+        if (currentProg->ident.number_of_idents >
+            currentProg->ident.grow_limit) {
+          grow_ident_table(currentProg);
+        } /* if */
+      } /* if */
+    } /* if */
+    logFunction(printf("find_ident -->\n"););
+    return ident_found;
+  } /* find_ident */
+
+
+
 identType get_ident (progType currentProg, const_ustriType name)
 
   {
     register identType ident_found;
-    register int comparison;
-    register boolType searching;
     sySizeType length;
 
   /* get_ident */
@@ -111,40 +224,10 @@ identType get_ident (progType currentProg, const_ustriType name)
         char_class(name[0]) == LEFTPARENCHAR ||
         char_class(name[0]) == PARENCHAR)) {
       ident_found = currentProg->ident.table1[(int) name[0]];
+    } else if (currentProg->ident.table == NULL) {
+      ident_found = NULL;
     } else {
-      if (IDENT_TABLE(currentProg, name, length) == NULL) {
-        ident_found = new_ident(name, length);
-        IDENT_TABLE(currentProg, name, length) = ident_found;
-      } else {
-        ident_found = IDENT_TABLE(currentProg, name, length);
-        searching = TRUE;
-        do {
-          if ((comparison = strncmp((const_cstriType) name,
-              (cstriType) ident_found->name, length)) == 0) {
-            if (ident_found->name[length] == '\0') {
-              searching = FALSE;
-            } else {
-              if (ident_found->next1 == NULL) {
-                ident_found->next1 = new_ident(name, length);
-                searching = FALSE;
-              } /* if */
-              ident_found = ident_found->next1;
-            } /* if */
-          } else if (comparison < 0) {
-            if (ident_found->next1 == NULL) {
-              ident_found->next1 = new_ident(name, length);
-              searching = FALSE;
-            } /* if */
-            ident_found = ident_found->next1;
-          } else {
-            if (ident_found->next2 == NULL) {
-              ident_found->next2 = new_ident(name, length);
-              searching = FALSE;
-            } /* if */
-            ident_found = ident_found->next2;
-          } /* if */
-        } while (searching);
-      } /* if */
+      ident_found = find_ident(currentProg, name, length);
     } /* if */
     logFunction(printf("get_ident -->\n"););
     return ident_found;
@@ -155,14 +238,25 @@ identType get_ident (progType currentProg, const_ustriType name)
 void close_idents (const_progType currentProg)
 
   {
-    int position;
+    memSizeType position;
+    identType ident;
+    identType next_ident;
     int character;
 
   /* close_idents */
     logFunction(printf("close_idents\n"););
-    for (position = 0; position < ID_TABLE_SIZE; position++) {
-      free_ident(currentProg, currentProg->ident.table[position]);
-    } /* for */
+    if (currentProg->ident.table != NULL) {
+      for (position = 0; position < currentProg->ident.table_size; position++) {
+        ident = currentProg->ident.table[position];
+        while (ident != NULL) {
+          next_ident = ident->next;
+          free_ident(currentProg, ident);
+          ident = next_ident;
+        } /* while */
+      } /* for */
+      FREE_TABLE(currentProg->ident.table, identType,
+                 currentProg->ident.table_size);
+    } /* if */
     for (character = '!'; character <= '~'; character++) {
       if (op_character(character) ||
           char_class(character) == LEFTPARENCHAR ||
@@ -180,14 +274,20 @@ void close_idents (const_progType currentProg)
 void init_idents (progType currentProg, errInfoType *err_info)
 
   {
-    int position;
     ucharType character;
 
   /* init_idents */
     logFunction(printf("init_ident\n"););
-    for (position = 0; position < ID_TABLE_SIZE; position++) {
-      currentProg->ident.table[position] = NULL;
-    } /* for */
+    if (ALLOC_TABLE(currentProg->ident.table, identType, ID_TABLE_START_SIZE)) {
+      memset(currentProg->ident.table, 0,
+             ID_TABLE_START_SIZE * sizeof(identType));
+      currentProg->ident.table_size = ID_TABLE_START_SIZE;
+    } else {
+      currentProg->ident.table_size = 0;
+      *err_info = MEMORY_ERROR;
+    } /* if */
+    currentProg->ident.number_of_idents = 0;
+    currentProg->ident.grow_limit = currentProg->ident.table_size;
     for (character = '!'; character <= '~'; character++) {
       if (op_character(character) ||
           char_class(character) == LEFTPARENCHAR ||
@@ -25,14 +25,12 @@
 /*                                                                  */
 /********************************************************************/
 
-/* #define IDENT_TABLE(PROG, STRI, LEN) (PROG)->ident.table[((STRI[0] & 63) << 4) | (LEN & 15)] */
-/* #define IDENT_TABLE(PROG, STRI, LEN) (PROG)->ident.table[((STRI[0] << 4) | LEN) & (ID_TABLE_SIZE - 1)] */
-/* #define IDENT_TABLE(PROG, STRI, LEN) (PROG)->ident.table[((STRI[0] << 4) ^ (STRI[1] << 2) ^ LEN) & (ID_TABLE_SIZE - 1)] */
-#define IDENT_TABLE(PROG, STRI, LEN) (PROG)->ident.table[((STRI[0] << 4) ^ (STRI[LEN - 1] << 2) ^ (int) LEN) & (ID_TABLE_SIZE - 1)]
 #define IS_NORMAL_IDENT(ident) ((ident) != NULL && (ident)->name != NULL && (ident)->name[0] != ' ')
 
 
 identType new_ident (const_ustriType name, sySizeType length);
+identType find_ident (progType currentProg, const_ustriType name,
+                      sySizeType length);
 identType get_ident (progType currentProg, const_ustriType name);
 void close_idents (const_progType currentProg);
 void init_idents (progType currentProg, errInfoType *err_info);
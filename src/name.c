@@ -81,6 +81,7 @@ static void push_owner (ownerType *owner, objectType obj_to_push,
       created_owner->decl_level = decl_level;
       created_owner->next = *owner;
       *owner = created_owner;
+      declaration_generation++;
     } else {
       *err_info = MEMORY_ERROR;
     } /* if */
@@ -102,6 +103,7 @@ static void pop_owner (ownerType *owner)
     old_owner = *owner;
     *owner = old_owner->next;
     FREE_RECORD(old_owner, ownerRecord, count.owner);
+    declaration_generation++;
     logFunction(printf("pop_owner -->\n"););
   } /* pop_owner */
 
@@ -423,6 +425,7 @@ static void pop_object (progType currentProg, const_objectType obj_to_pop)
       if (owner != NULL) {
         entity->data.owner = owner->next;
         FREE_RECORD(owner, ownerRecord, count.owner);
+        declaration_generation++;
         if (entity->data.owner == NULL && entity->fparam_list != NULL) {
           pop_entity(currentProg->declaration_root, entity);
           entity->data.next = currentProg->entity.inactive_list;
@@ -38,6 +38,8 @@
 #define WRITE_LINE_NUMBERS    1024
 #define SHOW_IDENT_TABLE      2048
 #define SHOW_STATISTICS       4096
+#define PROFILE_EXECUTION     8192
+#define THREADED_CODE        16384
 
 typedef struct optionStruct {
     striType          sourceFileArgument;
@@ -48,6 +48,10 @@
 #include "unistd.h"
 #endif
 
+#if HAS_POSIX_SPAWN
+#include "spawn.h"
+#endif
+
 #include "common.h"
 #include "data_rtl.h"
 #include "os_decls.h"
@@ -83,6 +87,12 @@ size_t sizeof_processRecord = sizeof(unx_processRecord);
 #define to_var_isTerminated(process) (((unx_processType) (process))->isTerminated)
 #define to_var_exitValue(process)    (((unx_processType) (process))->exitValue)
 
+#define MAX_CLOSED_FILE_NUMBERS 9
+
+#if HAS_POSIX_SPAWN
+extern char **environ;
+#endif
+
 
 
 #if ANY_LOG_ACTIVE
@@ -209,6 +219,105 @@ static os_striType *genArgVector (const const_striType command,
 
 
 
+/**
+ *  Add a file number to the file numbers that are closed in the child.
+ *  Standard file numbers and file numbers already in the list are skipped.
+ */
+static void addClosedFileNo (int closedFileNo[], int *numClosed, int fileNo)
+
+  {
+    int pos;
+
+  /* addClosedFileNo */
+    if (fileNo > 2) {
+      for (pos = 0; pos < *numClosed && closedFileNo[pos] != fileNo; pos++) ;
+      if (pos == *numClosed && *numClosed < MAX_CLOSED_FILE_NUMBERS) {
+        closedFileNo[pos] = fileNo;
+        (*numClosed)++;
+      } /* if */
+    } /* if */
+  } /* addClosedFileNo */
+
+
+
+/**
+ *  Start a child process that executes the program argv[0].
+ *  In the child stdFileNo[0], stdFileNo[1] and stdFileNo[2] become
+ *  stdin, stdout and stderr. The file numbers in stdFileNo and
+ *  unusedFileNo are closed in the child, except for the standard
+ *  file numbers 0, 1 and 2. If posix_spawn() is available it is used
+ *  instead of fork(). Fork() copies the page tables of the parent,
+ *  which is slow for a process with a large heap.
+ *  @return the process id of the child, or
+ *          -1 if the process could not be started (errno is set).
+ */
+static pid_t spawnChild (os_striType *argv, const int stdFileNo[],
+    const int unusedFileNo[], int numUnused)
+
+  {
+    int closedFileNo[MAX_CLOSED_FILE_NUMBERS];
+    int numClosed = 0;
+    int pos;
+#if HAS_POSIX_SPAWN
+    posix_spawn_file_actions_t fileActions;
+    int result;
+#endif
+    pid_t pid;
+
+  /* spawnChild */
+    for (pos = 0; pos < 3; pos++) {
+      addClosedFileNo(closedFileNo, &numClosed, stdFileNo[pos]);
+    } /* for */
+    for (pos = 0; pos < numUnused; pos++) {
+      addClosedFileNo(closedFileNo, &numClosed, unusedFileNo[pos]);
+    } /* for */
+#if HAS_POSIX_SPAWN
+    result = posix_spawn_file_actions_init(&fileActions);
+    for (pos = 0; pos < 3 && result == 0; pos++) {
+      if (stdFileNo[pos] != pos) {
+        result = posix_spawn_file_actions_adddup2(&fileActions, stdFileNo[pos], pos);
+      } /* if */
+    } /* for */
+    for (pos = 0; pos < numClosed && result == 0; pos++) {
+      result = posix_spawn_file_actions_addclose(&fileActions, closedFileNo[pos]);
+    } /* for */
+    if (likely(result == 0)) {
+      result = posix_spawn(&pid, argv[0], &fileActions, NULL, argv, environ);
+    } /* if */
+    posix_spawn_file_actions_destroy(&fileActions);
+    if (unlikely(result != 0)) {
+      logError(printf("spawnChild: posix_spawn(" FMT_S_OS ") failed:\n"
+                      "error: %s\n",
+                      argv[0], strerror(result)););
+      errno = result;
+      pid = (pid_t) -1;
+    } /* if */
+#else
+    pid = fork();
+    if (pid == 0) {
+      for (pos = 0; pos < 3; pos++) {
+        if (stdFileNo[pos] != pos) {
+          dup2(stdFileNo[pos], pos);
+        } /* if */
+      } /* for */
+      for (pos = 0; pos < numClosed; pos++) {
+        close(closedFileNo[pos]);
+      } /* for */
+      execv(argv[0], argv);
+      logError(printf("spawnChild: execv(" FMT_S_OS ") failed:\n"
+                      "errno=%d\nerror: %s\n",
+                      argv[0], errno, strerror(errno)););
+      os_exit(1);
+    } else if (unlikely(pid == (pid_t) -1)) {
+      logError(printf("spawnChild: fork failed:\nerrno=%d\nerror: %s\n",
+                      errno, strerror(errno)););
+    } /* if */
+#endif
+    return pid;
+  } /* spawnChild */
+
+
+
 /**
  *  Compare two processes.
  *  @return -1, 0 or 1 if the first argument is considered to be
@@ -434,6 +543,8 @@ void pcsPipe2 (const const_striType command, const const_rtlArrayType parameters
     fileType childStdoutFile;
     int childStdinPipes[2];
     int childStdoutPipes[2];
+    int stdFileNo[3];
+    int unusedFileNo[2];
     errInfoType err_info = OKAY_NO_ERROR;
     pid_t pid;
 
@@ -478,19 +589,14 @@ void pcsPipe2 (const const_striType command, const const_rtlArrayType parameters
       close(childStdinPipes[1]);
       raise_error(FILE_ERROR);
     } else {
-      pid = fork();
-      if (pid == 0) {
-        dup2(childStdinPipes[0], 0); /* Make the read end of childStdinPipes pipe as stdin */
-        dup2(childStdoutPipes[1], 1);  /* Make the write end of childStdoutPipes as stdout */
-        close(childStdinPipes[0]); /* Not required for the child */
-        close(childStdinPipes[1]);
-        close(childStdoutPipes[0]);
-        close(childStdoutPipes[1]);
-        execv(argv[0], argv);
-        logError(printf("pcsPipe2: execv(" FMT_S_OS ") failed:\nerrno=%d\nerror: %s\n",
-                        argv[0], errno, strerror(errno)););
-      } else if (unlikely(pid == (pid_t) -1)) {
-        logError(printf("pcsPipe2: fork failed:\nerrno=%d\nerror: %s\n",
+      stdFileNo[0] = childStdinPipes[0]; /* The read end of childStdinPipes becomes stdin */
+      stdFileNo[1] = childStdoutPipes[1]; /* The write end of childStdoutPipes becomes stdout */
+      stdFileNo[2] = 2;
+      unusedFileNo[0] = childStdinPipes[1]; /* Not required for the child */
+      unusedFileNo[1] = childStdoutPipes[0];
+      pid = spawnChild(argv, stdFileNo, unusedFileNo, 2);
+      if (unlikely(pid == (pid_t) -1)) {
+        logError(printf("pcsPipe2: spawnChild failed:\nerrno=%d\nerror: %s\n",
                         errno, strerror(errno)););
         close(childStdinPipes[0]); /* The pipes are unused */
         close(childStdoutPipes[1]);
@@ -565,8 +671,7 @@ void pcsPty (const const_striType command, const const_rtlArrayType parameters,
     int masterfd;
     int slavefd;
     char *slavedevice;
-    int savedStdin;
-    int savedStdout;
+    int stdFileNo[3];
     errInfoType err_info = OKAY_NO_ERROR;
     pid_t pid;
 
@@ -609,36 +714,20 @@ void pcsPty (const const_striType command, const const_rtlArrayType parameters,
           FREE_RECORD(childStdoutFile, fileRecord, count.files);
           raise_error(FILE_ERROR);
         } else {
-          savedStdin  = dup(0);
-          savedStdout = dup(1);
-          close(0);
-          close(1);
-          dup2(slavefd, 0); /* Make the read end of slavefd as stdin */
-          dup2(slavefd, 1);  /* Make the write end of slavefd as stdout */
-          pid = fork();
-          if (pid == 0) {
-            close(masterfd); /* Not required for the child */
-            close(slavefd);
-            execv(argv[0], argv);
-            logError(printf("pcsPty: execv(" FMT_S_OS ") failed:\nerrno=%d\nerror: %s\n",
-                            argv[0], errno, strerror(errno)););
-          } else if (unlikely(pid == (pid_t) -1)) {
-            logError(printf("pcsPty: fork failed:\nerrno=%d\nerror: %s\n",
+          stdFileNo[0] = slavefd; /* The slavefd becomes stdin and stdout */
+          stdFileNo[1] = slavefd;
+          stdFileNo[2] = 2;
+          pid = spawnChild(argv, stdFileNo, &masterfd, 1);
+          if (unlikely(pid == (pid_t) -1)) {
+            logError(printf("pcsPty: spawnChild failed:\nerrno=%d\nerror: %s\n",
                             errno, strerror(errno)););
-            close(0); /* Restore the original std fds of parent */
-            close(1);
-            dup2(savedStdin, 0);
-            dup2(savedStdout, 1);
+            close(masterfd);
             close(slavefd); /* This is unused */
             freeArgVector(argv);
             FREE_RECORD(childStdinFile, fileRecord, count.files);
             FREE_RECORD(childStdoutFile, fileRecord, count.files);
             raise_error(FILE_ERROR);
           } else {
-            close(0); /* Restore the original std fds of parent */
-            close(1);
-            dup2(savedStdin, 0);
-            dup2(savedStdout, 1);
             close(slavefd); /* This is being used by the child */
             initFileType(childStdinFile, FALSE, TRUE);
             childStdinFile->cFile = os_fdopen(masterfd, "w");
@@ -694,6 +783,7 @@ processType pcsStart (const const_striType command, const const_rtlArrayType par
     int stdinFileNo;
     int stdoutFileNo;
     int stderrFileNo;
+    int stdFileNo[3];
     errInfoType err_info = OKAY_NO_ERROR;
     pid_t pid;
     unx_processType process;
@@ -745,27 +835,12 @@ processType pcsStart (const const_striType command, const const_rtlArrayType par
         freeArgVector(argv);
         err_info = MEMORY_ERROR;
       } else {
-        pid = fork();
-        if (pid == 0) {
-          if (stdinFileNo != 0) {
-            dup2(stdinFileNo, 0);
-            close(stdinFileNo);
-          } /* if */
-          if (stdoutFileNo != 1) {
-            dup2(stdoutFileNo, 1);
-            close(stdoutFileNo);
-          } /* if */
-          if (stderrFileNo != 2) {
-            dup2(stderrFileNo, 2);
-            close(stderrFileNo);
-          } /* if */
-          execv(argv[0], argv);
-          logError(printf("pcsStart: execv(" FMT_S_OS ") failed:\n"
-                          "errno=%d\nerror: %s\n",
-                          argv[0], errno, strerror(errno)););
-          os_exit(1);
-        } else if (unlikely(pid == (pid_t) -1)) {
-          logError(printf("pcsStart: fork failed:\nerrno=%d\nerror: %s\n",
+        stdFileNo[0] = stdinFileNo;
+        stdFileNo[1] = stdoutFileNo;
+        stdFileNo[2] = stderrFileNo;
+        pid = spawnChild(argv, stdFileNo, NULL, 0);
+        if (unlikely(pid == (pid_t) -1)) {
+          logError(printf("pcsStart: spawnChild failed:\nerrno=%d\nerror: %s\n",
                           errno, strerror(errno)););
           freeArgVector(argv);
           FREE_RECORD(process, unx_processRecord, count.process);
@@ -814,6 +889,8 @@ processType pcsStartPipe (const const_striType command, const const_rtlArrayType
     int childStdinPipes[2];
     int childStdoutPipes[2];
     int childStderrPipes[2];
+    int stdFileNo[3];
+    int unusedFileNo[3];
     errInfoType err_info = OKAY_NO_ERROR;
     pid_t pid;
     unx_processType process;
@@ -889,26 +966,15 @@ processType pcsStartPipe (const const_striType command, const const_rtlArrayType
       raise_error(FILE_ERROR);
       process = NULL;
     } else {
-      pid = fork();
-      if (pid == 0) {
-        dup2(childStdinPipes[0], 0); /* Make the read end of childStdinPipes pipe as stdin */
-        dup2(childStdoutPipes[1], 1);  /* Make the write end of childStdoutPipes as stdout */
-        dup2(childStderrPipes[1], 2);  /* Make the write end of childStderrPipes as stderr */
-        close(childStdinPipes[0]); /* Not required for the child */
-        close(childStdinPipes[1]);
-        close(childStdoutPipes[0]);
-        close(childStdoutPipes[1]);
-        close(childStderrPipes[0]);
-        close(childStderrPipes[1]);
-        execv(argv[0], argv);
-        logError(printf("pcsStartPipe: execv(" FMT_S_OS ") failed:\nerrno=%d\nerror: %s\n",
-                        argv[0], errno, strerror(errno)););
-        /* printf("EACCES=%d  EBUSY=%d  EEXIST=%d  ENOTEMPTY=%d  ENOENT=%d  ENOTDIR=%d  EROFS=%d\n",
-            EACCES, EBUSY, EEXIST, ENOTEMPTY, ENOENT, ENOTDIR, EROFS);
-        printf("EFAULT=%d  EISDIR=%d  ENAMETOOLONG=%d  ENODEV=%d  EINVAL=%d\n",
-            EFAULT, EISDIR, ENAMETOOLONG, ENODEV, EINVAL); */
-      } else if (unlikely(pid == (pid_t) -1)) {
-        logError(printf("pcsStartPipe: fork failed:\nerrno=%d\nerror: %s\n",
+      stdFileNo[0] = childStdinPipes[0]; /* The read end of childStdinPipes becomes stdin */
+      stdFileNo[1] = childStdoutPipes[1]; /* The write end of childStdoutPipes becomes stdout */
+      stdFileNo[2] = childStderrPipes[1]; /* The write end of childStderrPipes becomes stderr */
+      unusedFileNo[0] = childStdinPipes[1]; /* Not required for the child */
+      unusedFileNo[1] = childStdoutPipes[0];
+      unusedFileNo[2] = childStderrPipes[0];
+      pid = spawnChild(argv, stdFileNo, unusedFileNo, 3);
+      if (unlikely(pid == (pid_t) -1)) {
+        logError(printf("pcsStartPipe: spawnChild failed:\nerrno=%d\nerror: %s\n",
                         errno, strerror(errno)););
         close(childStdinPipes[0]); /* The pipes are unused */
         close(childStdoutPipes[1]);
@@ -58,6 +58,8 @@
 #include "option.h"
 #include "match.h"
 #include "objutl.h"
+#include "profutl.h"
+#include "tcode.h"
 #include "runerr.h"
 #include "str_rtl.h"
 #include "set_rtl.h"
@@ -254,6 +256,7 @@ void interpret (const const_progType currentProg, const const_rtlArrayType argv,
   {
     progType progBackup;
     boolType backup_interpreter_exception;
+    boolType backup_tc_active;
 
   /* interpret */
     logFunction(printf("interpret(\"%s\")\n",
@@ -274,6 +277,9 @@ void interpret (const const_progType currentProg, const const_rtlArrayType argv,
                             FALSE, FALSE, doSuspendInterpreter);
         set_trace(prog->option_flags);
         set_protfile_name(protFileName);
+        if (options & PROFILE_EXECUTION) {
+          profStart(prog);
+        } /* if */
         if (prog->arg_v != NULL) {
           free_args(prog->arg_v);
         } /* if */
@@ -305,6 +311,8 @@ void interpret (const const_progType currentProg, const const_rtlArrayType argv,
           } /* if */
           backup_interpreter_exception = interpreter_exception;
           interpreter_exception = TRUE;
+          backup_tc_active = tc_active;
+          tc_active = (options & THREADED_CODE) != 0;
           curr_exec_object = NULL;
           if (likely(do_setjmp(catch_stack[catch_stack_pos])) == 0) {
             evaluate(prog->main_object);
@@ -316,6 +324,10 @@ void interpret (const const_progType currentProg, const const_rtlArrayType argv,
           } /* if */
           catch_stack_pos--;
           interpreter_exception = backup_interpreter_exception;
+          tc_active = backup_tc_active;
+          if (options & PROFILE_EXECUTION) {
+            profStop();
+          } /* if */
           free_args(prog->arg_v);
           prog->arg_v = NULL;
 #ifdef WITH_PROTOCOL
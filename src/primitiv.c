@@ -40,7 +40,9 @@
 #include "bstlib.h"
 #include "chrlib.h"
 #include "cmdlib.h"
+#include "cmplib.h"
 #include "conlib.h"
+#include "crylib.h"
 #include "dcllib.h"
 #include "drwlib.h"
 #include "enulib.h"
@@ -55,6 +57,7 @@
 #include "pollib.h"
 #include "prclib.h"
 #include "prglib.h"
+#include "pxllib.h"
 #include "reflib.h"
 #include "rfllib.h"
 #include "sctlib.h"
@@ -308,6 +311,13 @@ static const actEntryRecord actEntryTable[] = {
     { "CMD_TO_OS_PATH",               cmd_to_os_path,               },
     { "CMD_UNSETENV",                 cmd_unsetenv,                 },
 
+    { "CMP_BZIP2_CRC32",              cmp_bzip2_crc32,              },
+    { "CMP_CRC32",                    cmp_crc32,                    },
+    { "CMP_CRC32C",                   cmp_crc32c,                   },
+    { "CMP_DEFLATE",                  cmp_deflate,                  },
+    { "CMP_LZMA_DECODE",              cmp_lzma_decode,              },
+    { "CMP_ZSTD_DECODE_BLOCK",        cmp_zstd_decode_block,        },
+
     { "CON_CLEAR",                    con_clear,                    },
     { "CON_COLUMN",                   con_column,                   },
     { "CON_CURSOR",                   con_cursor,                   },
@@ -321,6 +331,12 @@ static const actEntryRecord actEntryTable[] = {
     { "CON_WIDTH",                    con_width,                    },
     { "CON_WRITE",                    con_write,                    },
 
+    { "CRY_AES_CBC_DECRYPT",          cry_aes_cbc_decrypt,          },
+    { "CRY_AES_CBC_ENCRYPT",          cry_aes_cbc_encrypt,          },
+    { "CRY_AES_CTR",                  cry_aes_ctr,                  },
+    { "CRY_GHASH",                    cry_ghash,                    },
+    { "CRY_SET_ACCELERATION",         cry_set_acceleration,         },
+
     { "DCL_ATTR",                     dcl_attr,                     },
     { "DCL_CONST",                    dcl_const,                    },
     { "DCL_ELEMENTS",                 dcl_elements,                 },
@@ -387,6 +403,7 @@ static const actEntryRecord actEntryTable[] = {
     { "DRW_PPOINT",                   drw_ppoint,                   },
     { "DRW_PRECT",                    drw_prect,                    },
     { "DRW_PUT",                      drw_put,                      },
+    { "DRW_PUT_GLYPHS",               drw_put_glyphs,               },
     { "DRW_PUT_SCALED",               drw_put_scaled,               },
     { "DRW_RGBCOL",                   drw_rgbcol,                   },
  /* { "DRW_ROT",                      drw_rot,                      }, */
@@ -785,6 +802,26 @@ static const actEntryRecord actEntryTable[] = {
     { "PRG_SYSVAR",                   prg_sysvar,                   },
     { "PRG_VALUE",                    prg_value,                    },
 
+    { "PXL_BLEND",                    pxl_blend,                    },
+    { "PXL_CROP",                     pxl_crop,                     },
+    { "PXL_FILL",                     pxl_fill,                     },
+    { "PXL_GET_AREA",                 pxl_get_area,                 },
+    { "PXL_GET_PIXEL",                pxl_get_pixel,                },
+    { "PXL_GET_PIXMAP",               pxl_get_pixmap,               },
+    { "PXL_JPEG_COEFFICIENTS",        pxl_jpeg_coefficients,        },
+    { "PXL_JPEG_DECODE_SCAN",         pxl_jpeg_decode_scan,         },
+    { "PXL_JPEG_TO_RASTER",           pxl_jpeg_to_raster,           },
+    { "PXL_JPEG_TO_RGB",              pxl_jpeg_to_rgb,              },
+    { "PXL_NEW",                      pxl_new,                      },
+    { "PXL_PIXELS_TO_RGB",            pxl_pixels_to_rgb,            },
+    { "PXL_PNG_FILTER",               pxl_png_filter,               },
+    { "PXL_PNG_UNFILTER",             pxl_png_unfilter,             },
+    { "PXL_SCALE",                    pxl_scale,                    },
+    { "PXL_SET_INDEXED_PIXELS",       pxl_set_indexed_pixels,       },
+    { "PXL_SET_PIXEL",                pxl_set_pixel,                },
+    { "PXL_SET_PIXELS",               pxl_set_pixels,               },
+    { "PXL_TRANSFORM",                pxl_transform,                },
+
 #if WITH_REFERENCE
     { "REF_ALLOC",                    ref_alloc,                    },
     { "REF_ALLOC_INT",                ref_alloc_int,                },
@@ -0,0 +1,539 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  agent                                       */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Interpreter                                             */
+/*  File: seed7/src/profutl.c                                       */
+/*  Changes: 2026  agent                                            */
+/*  Content: Sampling profiler for the interpreter.                 */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "time.h"
+#if HAS_SETITIMER
+#include "signal.h"
+#include "sys/time.h"
+#endif
+
+#include "common.h"
+#include "data.h"
+#include "os_decls.h"
+#include "heaputl.h"
+#include "striutl.h"
+#include "datautl.h"
+#include "actutl.h"
+#include "infile.h"
+
+#undef EXTERN
+#define EXTERN
+#define DO_INIT
+#include "profutl.h"
+
+
+#define PROF_SAMPLE_INTERVAL 1000  /* Requested microseconds between two samples */
+#define PROF_TABLE_SIZE     32768  /* Must be a power of two */
+#define PROF_POOL_SIZE    1048576
+#define PROF_FOLDED_FILE_NAME  "profile_folded"
+#define PROF_SUMMARY_FILE_NAME "profile_out"
+
+typedef struct {
+    memSizeType hashCode;
+    memSizeType length;
+    memSizeType poolIndex;
+    memSizeType count;
+  } sampleRecord, *sampleType;
+
+typedef struct {
+    const_objectType funcObject;
+    memSizeType self;
+    memSizeType total;
+    memSizeType lastSample;
+  } funcSummaryRecord, *funcSummaryType;
+
+static sampleType sampleTable = NULL;
+static const_objectType *framePool = NULL;
+static memSizeType poolUsed;
+static memSizeType tableUsed;
+static memSizeType sampleCount;
+static memSizeType lostSampleCount;
+static const_progType profiledProgram = NULL;
+static clock_t startClock;
+static boolType atexitRegistered = FALSE;
+
+
+
+#if HAS_SETITIMER
+/**
+ *  Record the current stack of the interpreter.
+ *  Actions in the middle of the stack (e.g. the action of a
+ *  loop whose body is executed) are omitted. Only an action at
+ *  the top of the stack is recorded. Functions of other programs
+ *  (started with PRG_EXEC or parsed at run-time) are omitted,
+ *  since they might be freed before the results are written.
+ *  This function is called as signal handler. Therefore it must
+ *  not allocate memory.
+ */
+static void profSignalHandler (int signalNum)
+
+  {
+    const_objectType frame[PROF_STACK_SIZE];
+    memSizeType depth;
+    memSizeType length = 0;
+    memSizeType pos;
+    memSizeType hashCode = 0;
+    memSizeType index;
+    sampleType sample;
+    boolType found = FALSE;
+
+  /* profSignalHandler */
+    depth = prof_depth;
+    if (depth > PROF_STACK_SIZE) {
+      depth = PROF_STACK_SIZE;
+    } /* if */
+    for (pos = 0; pos < depth; pos++) {
+      frame[length] = prof_frame[pos];
+      if (frame[length] != NULL && frame[length]->type_of != NULL &&
+          frame[length]->type_of->owningProg == profiledProgram &&
+          (pos == depth - 1 || CATEGORY_OF_OBJ(frame[length]) != ACTOBJECT)) {
+        hashCode = hashCode * 31 + ((memSizeType) frame[length] >> 4);
+        length++;
+      } /* if */
+    } /* for */
+    if (length != 0) {
+      sampleCount++;
+      index = hashCode & (PROF_TABLE_SIZE - 1);
+      sample = &sampleTable[index];
+      while (sample->length != 0 && !found) {
+        if (sample->hashCode == hashCode && sample->length == length) {
+          pos = 0;
+          while (pos < length && framePool[sample->poolIndex + pos] == frame[pos]) {
+            pos++;
+          } /* while */
+          found = pos == length;
+        } /* if */
+        if (!found) {
+          index = (index + 1) & (PROF_TABLE_SIZE - 1);
+          sample = &sampleTable[index];
+        } /* if */
+      } /* while */
+      if (found) {
+        sample->count++;
+      } else if (tableUsed < PROF_TABLE_SIZE / 4 * 3 &&
+                 poolUsed + length <= PROF_POOL_SIZE) {
+        memcpy(&framePool[poolUsed], frame, length * sizeof(const_objectType));
+        sample->hashCode = hashCode;
+        sample->poolIndex = poolUsed;
+        sample->count = 1;
+        sample->length = length;
+        poolUsed += length;
+        tableUsed++;
+      } else {
+        lostSampleCount++;
+      } /* if */
+    } /* if */
+  } /* profSignalHandler */
+#endif
+
+
+
+static void writeFuncName (FILE *outFile, const_objectType funcObject)
+
+  {
+    const_listType paramList = NULL;
+    const_listType listEnd;
+    const_objectType param;
+
+  /* writeFuncName */
+    if (CATEGORY_OF_OBJ(funcObject) == ACTOBJECT) {
+      fputs(getActEntry(funcObject->value.actValue)->name, outFile);
+    } else if (HAS_ENTITY(funcObject) && GET_ENTITY(funcObject)->ident != NULL) {
+      fputs(id_string(GET_ENTITY(funcObject)->ident), outFile);
+    } else {
+      if (HAS_PROPERTY(funcObject)) {
+        paramList = funcObject->descriptor.property->params;
+      } /* if */
+      if (paramList == NULL && HAS_ENTITY(funcObject)) {
+        paramList = GET_ENTITY(funcObject)->fparam_list;
+      } /* if */
+      if (paramList == NULL) {
+        fputs("*ANONYMOUS*", outFile);
+      } else {
+        listEnd = paramList;
+        while (listEnd->next != NULL) {
+          listEnd = listEnd->next;
+        } /* while */
+        if (CATEGORY_OF_OBJ(paramList->obj) != SYMBOLOBJECT &&
+            CATEGORY_OF_OBJ(listEnd->obj) == SYMBOLOBJECT &&
+            HAS_ENTITY(listEnd->obj) &&
+            GET_ENTITY(listEnd->obj)->ident != NULL &&
+            GET_ENTITY(listEnd->obj)->ident->infix_priority == 0) {
+          /* Function call notation: name (param1, param2) */
+          fputs(id_string(GET_ENTITY(listEnd->obj)->ident), outFile);
+        } else {
+          for (; paramList != NULL; paramList = paramList->next) {
+            param = paramList->obj;
+            if (param != NULL && CATEGORY_OF_OBJ(param) == FORMPARAMOBJECT) {
+              param = param->value.objValue;
+            } /* if */
+            if (param == NULL) {
+              fputs("?", outFile);
+            } else if (CATEGORY_OF_OBJ(param) == SYMBOLOBJECT) {
+              if (HAS_ENTITY(param) && GET_ENTITY(param)->ident != NULL) {
+                fputs(id_string(GET_ENTITY(param)->ident), outFile);
+              } else {
+                fputs("?", outFile);
+              } /* if */
+            } else if (param->type_of != NULL && param->type_of->name != NULL) {
+              fprintf(outFile, "(%s)", id_string(param->type_of->name));
+            } else {
+              fputs("()", outFile);
+            } /* if */
+            if (paramList->next != NULL) {
+              fputs(" ", outFile);
+            } /* if */
+          } /* for */
+        } /* if */
+      } /* if */
+    } /* if */
+  } /* writeFuncName */
+
+
+
+/**
+ *  Write the place where a function is defined as file(line).
+ *  @param fullPath TRUE if the file name is written with its path,
+ *                  FALSE if just the base name is written.
+ */
+static void writePlace (FILE *outFile, const_objectType funcObject,
+    boolType fullPath)
+
+  {
+    lineNumType line = 0;
+    cstriType fileName;
+    const_cstriType baseName;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* writePlace */
+    if (CATEGORY_OF_OBJ(funcObject) == ACTOBJECT) {
+      fputs("action", outFile);
+    } else {
+      if (HAS_POSINFO(funcObject)) {
+        line = POSINFO_LINE_NUM(funcObject);
+      } else if (HAS_PROPERTY(funcObject)) {
+        line = PROPERTY_LINE_NUM(funcObject);
+      } /* if */
+      fileName = stri_to_cstri8(objectFileName(funcObject), &err_info);
+      if (fileName == NULL) {
+        fprintf(outFile, "?(%u)", (unsigned int) line);
+      } else {
+        baseName = strrchr(fileName, '/');
+        if (fullPath || baseName == NULL) {
+          baseName = fileName;
+        } else {
+          baseName++;
+        } /* if */
+        fprintf(outFile, "%s(%u)", baseName, (unsigned int) line);
+        free_cstri8(fileName, objectFileName(funcObject));
+      } /* if */
+    } /* if */
+  } /* writePlace */
+
+
+
+static void writeFoldedStacks (void)
+
+  {
+    FILE *outFile;
+    memSizeType index;
+    memSizeType pos;
+    const_objectType funcObject;
+
+  /* writeFoldedStacks */
+    logFunction(printf("writeFoldedStacks\n"););
+    outFile = fopen(PROF_FOLDED_FILE_NAME, "w");
+    if (outFile == NULL) {
+      printf("*** Cannot open " PROF_FOLDED_FILE_NAME "\n");
+    } else {
+      for (index = 0; index < PROF_TABLE_SIZE; index++) {
+        if (sampleTable[index].length != 0) {
+          for (pos = 0; pos < sampleTable[index].length; pos++) {
+            funcObject = framePool[sampleTable[index].poolIndex + pos];
+            if (pos != 0) {
+              fputs(";", outFile);
+            } /* if */
+            writeFuncName(outFile, funcObject);
+            if (CATEGORY_OF_OBJ(funcObject) != ACTOBJECT) {
+              fputs(" ", outFile);
+              writePlace(outFile, funcObject, FALSE);
+            } /* if */
+          } /* for */
+          fprintf(outFile, " " FMT_U_MEM "\n", sampleTable[index].count);
+        } /* if */
+      } /* for */
+      fclose(outFile);
+    } /* if */
+    logFunction(printf("writeFoldedStacks -->\n"););
+  } /* writeFoldedStacks */
+
+
+
+static int cmpFuncSummary (const void *summary1, const void *summary2)
+
+  {
+    const_objectType func1 = ((const funcSummaryRecord *) summary1)->funcObject;
+    memSizeType self1 = ((const funcSummaryRecord *) summary1)->self;
+    memSizeType self2 = ((const funcSummaryRecord *) summary2)->self;
+    memSizeType total1 = ((const funcSummaryRecord *) summary1)->total;
+    memSizeType total2 = ((const funcSummaryRecord *) summary2)->total;
+    int signumValue;
+
+  /* cmpFuncSummary */
+    if (self1 != self2) {
+      signumValue = self1 < self2 ? 1 : -1;
+    } else if (total1 != total2) {
+      signumValue = total1 < total2 ? 1 : -1;
+    } else {
+      signumValue = func1 < ((const funcSummaryRecord *) summary2)->funcObject ? -1 : 1;
+    } /* if */
+    return signumValue;
+  } /* cmpFuncSummary */
+
+
+
+/**
+ *  Write the time (in microseconds) spent in each function and action.
+ *  The 'self' column contains the time where the function was at
+ *  the top of the stack. The 'total' column contains the time
+ *  where the function was somewhere in the stack. Recursive calls
+ *  are counted only once per sample.
+ */
+static void writeSummary (double usecsPerSample)
+
+  {
+    memSizeType summarySize;
+    funcSummaryType summary;
+    funcSummaryType entry;
+    memSizeType funcCount = 0;
+    memSizeType index;
+    memSizeType pos;
+    memSizeType hashIndex;
+    const_objectType funcObject;
+    FILE *outFile;
+
+  /* writeSummary */
+    logFunction(printf("writeSummary\n"););
+    summarySize = 64;
+    while (summarySize < 2 * poolUsed) {
+      summarySize <<= 1;
+    } /* while */
+    if (!ALLOC_TABLE(summary, funcSummaryRecord, summarySize)) {
+      printf("*** Not enough memory for the profile summary\n");
+    } else {
+      memset(summary, 0, summarySize * sizeof(funcSummaryRecord));
+      for (index = 0; index < PROF_TABLE_SIZE; index++) {
+        for (pos = 0; pos < sampleTable[index].length; pos++) {
+          funcObject = framePool[sampleTable[index].poolIndex + pos];
+          hashIndex = ((memSizeType) funcObject >> 4) & (summarySize - 1);
+          while (summary[hashIndex].funcObject != NULL &&
+                 summary[hashIndex].funcObject != funcObject) {
+            hashIndex = (hashIndex + 1) & (summarySize - 1);
+          } /* while */
+          entry = &summary[hashIndex];
+          if (entry->funcObject == NULL) {
+            entry->funcObject = funcObject;
+            funcCount++;
+          } else if (entry->lastSample == index + 1) {
+            /* Recursive call: Count the sample only once. */
+            entry = NULL;
+          } /* if */
+          if (entry != NULL) {
+            entry->total += sampleTable[index].count;
+            entry->lastSample = index + 1;
+          } /* if */
+          if (pos == sampleTable[index].length - 1) {
+            summary[hashIndex].self += sampleTable[index].count;
+          } /* if */
+        } /* for */
+      } /* for */
+      /* Move the used entries to the front and sort them. */
+      pos = 0;
+      for (index = 0; index < summarySize; index++) {
+        if (summary[index].funcObject != NULL) {
+          summary[pos] = summary[index];
+          pos++;
+        } /* if */
+      } /* for */
+      qsort(summary, funcCount, sizeof(funcSummaryRecord), cmpFuncSummary);
+      outFile = fopen(PROF_SUMMARY_FILE_NAME, "w");
+      if (outFile == NULL) {
+        printf("*** Cannot open " PROF_SUMMARY_FILE_NAME "\n");
+      } else {
+        fprintf(outFile, "self\ttotal\tplace\tname\n");
+        for (index = 0; index < funcCount; index++) {
+          fprintf(outFile, "%.0f\t%.0f\t",
+                  (double) summary[index].self * usecsPerSample,
+                  (double) summary[index].total * usecsPerSample);
+          writePlace(outFile, summary[index].funcObject, TRUE);
+          fputs("\t", outFile);
+          writeFuncName(outFile, summary[index].funcObject);
+          fputs("\n", outFile);
+        } /* for */
+        fclose(outFile);
+      } /* if */
+      FREE_TABLE(summary, funcSummaryRecord, summarySize);
+    } /* if */
+    logFunction(printf("writeSummary -->\n"););
+  } /* writeSummary */
+
+
+
+static void freeSampleTables (void)
+
+  { /* freeSampleTables */
+    if (sampleTable != NULL) {
+      FREE_TABLE(sampleTable, sampleRecord, PROF_TABLE_SIZE);
+      sampleTable = NULL;
+    } /* if */
+    if (framePool != NULL) {
+      FREE_TABLE(framePool, const_objectType, PROF_POOL_SIZE);
+      framePool = NULL;
+    } /* if */
+  } /* freeSampleTables */
+
+
+
+/**
+ *  Start sampling the stack of the interpreter.
+ *  The interpreter maintains a stack of the functions and actions
+ *  currently executed (see profEnter() and profLeave()). A SIGPROF
+ *  interval timer interrupts the program and the signal handler
+ *  counts the current stack. Only CPU time used by the process is
+ *  measured. The results are written by profStop(), which is also
+ *  called when the program exits.
+ *  @param program Program whose functions are profiled.
+ */
+void profStart (const_progType program)
+
+  {
+#if HAS_SETITIMER
+    struct sigaction sigAct;
+    struct itimerval timerVal;
+#endif
+
+  /* profStart */
+    logFunction(printf("profStart\n"););
+#if HAS_SETITIMER
+    if (!prof_active) {
+      if (!ALLOC_TABLE(sampleTable, sampleRecord, PROF_TABLE_SIZE) ||
+          !ALLOC_TABLE(framePool, const_objectType, PROF_POOL_SIZE)) {
+        freeSampleTables();
+        printf("*** Not enough memory for profiling\n");
+      } else {
+        memset(sampleTable, 0, PROF_TABLE_SIZE * sizeof(sampleRecord));
+        poolUsed = 0;
+        tableUsed = 0;
+        sampleCount = 0;
+        lostSampleCount = 0;
+        profiledProgram = program;
+        startClock = clock();
+        prof_depth = 0;
+        prof_active = TRUE;
+        sigAct.sa_handler = profSignalHandler;
+        sigemptyset(&sigAct.sa_mask);
+        sigAct.sa_flags = SA_RESTART;
+        timerVal.it_interval.tv_sec = 0;
+        timerVal.it_interval.tv_usec = PROF_SAMPLE_INTERVAL;
+        timerVal.it_value = timerVal.it_interval;
+        if (unlikely(sigaction(SIGPROF, &sigAct, NULL) != 0 ||
+                     setitimer(ITIMER_PROF, &timerVal, NULL) != 0)) {
+          prof_active = FALSE;
+          freeSampleTables();
+          printf("*** Starting the profiling timer failed\n");
+        } else if (!atexitRegistered) {
+          os_atexit(profStop);
+          atexitRegistered = TRUE;
+        } /* if */
+      } /* if */
+    } /* if */
+#else
+    printf("*** Profiling is not supported on this platform\n");
+#endif
+    logFunction(printf("profStart -->\n"););
+  } /* profStart */
+
+
+
+/**
+ *  Stop sampling and write the results.
+ *  The folded stacks are written to the file profile_folded.
+ *  This file can be processed with flamegraph tools. The time
+ *  spent in each function is written to the file profile_out.
+ *  Calling profStop() when no profiling is active does nothing.
+ */
+void profStop (void)
+
+  {
+#if HAS_SETITIMER
+    struct sigaction sigAct;
+    struct itimerval timerVal;
+    double usecsPerSample;
+#endif
+
+  /* profStop */
+    logFunction(printf("profStop\n"););
+#if HAS_SETITIMER
+    if (prof_active) {
+      memset(&timerVal, 0, sizeof(struct itimerval));
+      setitimer(ITIMER_PROF, &timerVal, NULL);
+      /* A pending SIGPROF would terminate the program otherwise. */
+      sigAct.sa_handler = SIG_IGN;
+      sigemptyset(&sigAct.sa_mask);
+      sigAct.sa_flags = 0;
+      sigaction(SIGPROF, &sigAct, NULL);
+      prof_active = FALSE;
+      prof_depth = 0;
+      /* The timer granularity of the operating system might be */
+      /* coarser than PROF_SAMPLE_INTERVAL. Therefore the time   */
+      /* of a sample is computed from the CPU time used.         */
+      if (sampleCount != 0) {
+        usecsPerSample = (double) (clock() - startClock) * 1000000.0 /
+                         (double) CLOCKS_PER_SEC / (double) sampleCount;
+      } else {
+        usecsPerSample = (double) PROF_SAMPLE_INTERVAL;
+      } /* if */
+      writeFoldedStacks();
+      writeSummary(usecsPerSample);
+      if (lostSampleCount != 0) {
+        printf("*** Profiling: " FMT_U_MEM " of " FMT_U_MEM
+               " samples lost (too many different stacks)\n",
+               lostSampleCount, sampleCount);
+      } /* if */
+      freeSampleTables();
+    } /* if */
+#endif
+    logFunction(printf("profStop -->\n"););
+  } /* profStop */
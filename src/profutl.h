@@ -0,0 +1,55 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  agent                                       */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Interpreter                                             */
+/*  File: seed7/src/profutl.h                                       */
+/*  Changes: 2026  agent                                            */
+/*  Content: Sampling profiler for the interpreter.                 */
+/*                                                                  */
+/********************************************************************/
+
+#define PROF_STACK_SIZE 256
+
+#ifdef DO_INIT
+boolType prof_active = FALSE;
+volatile memSizeType prof_depth = 0;
+#else
+EXTERN boolType prof_active;
+EXTERN volatile memSizeType prof_depth;
+#endif
+EXTERN const_objectType volatile prof_frame[PROF_STACK_SIZE];
+
+/* The frame is stored before prof_depth is incremented. This */
+/* way the signal handler always sees a consistent stack.     */
+#define profEnter(funcObject) \
+    if (unlikely(prof_active)) { \
+      if (prof_depth < PROF_STACK_SIZE) { \
+        prof_frame[prof_depth] = (funcObject); \
+      } \
+      prof_depth++; \
+    }
+#define profLeave() \
+    if (unlikely(prof_active)) { \
+      prof_depth--; \
+    }
+
+
+void profStart (const_progType program);
+void profStop (void);
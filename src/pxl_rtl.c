@@ -0,0 +1,2542 @@
+/********************************************************************/
+/*                                                                  */
+/*  pxl_rtl.c     Primitive actions for packed pixel rasters.       */
+/*  Copyright (C) 2026  agent                                       */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/pxl_rtl.c                                       */
+/*  Changes: 2026  agent                                            */
+/*  Content: Primitive actions for packed pixel rasters.            */
+/*                                                                  */
+/*  A raster is a bstring with 32-bit pixels. The pixels of a line  */
+/*  are contiguous and line y starts at pixel y * stride. The       */
+/*  pixels have the format of drwRgbColor(). Functions that mix     */
+/*  pixels (pxlScale and pxlBlend) treat the four bytes of a pixel  */
+/*  as independent channels.                                        */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+
+#include "common.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "striutl.h"
+#include "rtl_err.h"
+#include "drw_drv.h"
+
+#undef EXTERN
+#define EXTERN
+#include "pxl_rtl.h"
+
+
+/* Rotated and mirrored lines are copied in tiles of this size. */
+#define TRANSFORM_TILE_SIZE 64
+
+#define RED_BLUE_MASK    0x00FF00FF
+#define ALPHA_GREEN_MASK 0xFF00FF00
+
+#define JPEG_BLOCK_SIZE      64
+#define JPEG_BLOCK_BYTES     (JPEG_BLOCK_SIZE * sizeof(int16Type))
+#define JPEG_MAX_CODE_LENGTH 16
+#define JPEG_MAX_VALUE_BITS  16
+#define JPEG_MAX_DIMENSION   65535
+
+/* Codes up to this length are decoded with one table lookup. */
+#define JPEG_FAST_BITS 9
+
+/* Factors of the IDCT: 2048 * sqrt(2.0) * cos(n * PI / 16) */
+#define JPEG_W1 2841
+#define JPEG_W2 2676
+#define JPEG_W3 2408
+#define JPEG_W5 1609
+#define JPEG_W6 1108
+#define JPEG_W7  565
+
+#define JPEG_SCAN_SEQUENTIAL 0
+#define JPEG_SCAN_DC_FIRST   1
+#define JPEG_SCAN_DC_REFINE  2
+#define JPEG_SCAN_AC_FIRST   3
+#define JPEG_SCAN_AC_REFINE  4
+
+#if RSHIFT_DOES_SIGN_EXTEND
+#define FLOOR_SHIFT(value, bits) ((value) >> (bits))
+#else
+#define FLOOR_SHIFT(value, bits) ((value) < 0 ? ~(~(value) >> (bits)) : (value) >> (bits))
+#endif
+
+typedef struct {
+    boolType initialized;
+    intType redPixel;
+    intType greenPixel;
+    intType bluePixel;
+    boolType direct;
+    uint32Type red[256];
+    uint32Type green[256];
+    uint32Type blue[256];
+  } pixelLayoutType;
+
+static pixelLayoutType pixelLayout;
+
+typedef struct {
+    unsigned int horizontal;
+    unsigned int vertical;
+    memSizeType unitColumns;
+    memSizeType unitLines;
+    memSizeType blockColumns[3];
+    memSizeType blockLines[3];
+    memSizeType blocksPerLine[3];
+    memSizeType firstBlock[3];
+    memSizeType beyondBlock[3];
+  } jpegLayoutType;
+
+typedef struct {
+    unsigned int maximumCodeLength;
+    unsigned int lastSymbol;
+    uint16Type fast[1 << JPEG_FAST_BITS];
+    int32Type maxCode[JPEG_MAX_CODE_LENGTH + 1];
+    int32Type valueOffset[JPEG_MAX_CODE_LENGTH + 1];
+    ucharType symbols[256];
+  } jpegHuffmanType;
+
+typedef struct {
+    const strElemType *pos;
+    const strElemType *beyond;
+    uint32Type buffer;
+    unsigned int bitsInBuffer;
+  } jpegBitStreamType;
+
+typedef struct {
+    unsigned int plane;
+    int32Type predictor;
+    jpegHuffmanType dcTable;
+    jpegHuffmanType acTable;
+  } jpegScanComponentType;
+
+typedef struct {
+    int kind;
+    unsigned int startOfSpectral;
+    unsigned int endOfSpectral;
+    unsigned int approximationLow;
+    unsigned int eobRunLength;
+    jpegScanComponentType component[3];
+  } jpegScanType;
+
+
+
+/**
+ *  Determine how drwRgbColor() combines the channels of a pixel.
+ *  If the channels are independent bit fields (direct) the pixel
+ *  of an 8-bit color is computed with three table lookups. The
+ *  tables are only recomputed, if the pixels of red, green and
+ *  blue change.
+ */
+static const pixelLayoutType *getPixelLayout (void)
+
+  {
+    intType redPixel;
+    intType greenPixel;
+    intType bluePixel;
+    unsigned int value;
+
+  /* getPixelLayout */
+    redPixel   = drwRgbColor(0xFFFF, 0, 0);
+    greenPixel = drwRgbColor(0, 0xFFFF, 0);
+    bluePixel  = drwRgbColor(0, 0, 0xFFFF);
+    if (!pixelLayout.initialized ||
+        redPixel   != pixelLayout.redPixel ||
+        greenPixel != pixelLayout.greenPixel ||
+        bluePixel  != pixelLayout.bluePixel) {
+      pixelLayout.redPixel   = redPixel;
+      pixelLayout.greenPixel = greenPixel;
+      pixelLayout.bluePixel  = bluePixel;
+      pixelLayout.direct = (redPixel & greenPixel) == 0 &&
+                           (redPixel & bluePixel) == 0 &&
+                           (greenPixel & bluePixel) == 0 &&
+                           drwRgbColor(0, 0, 0) == 0 &&
+                           drwRgbColor(0xFFFF, 0xFFFF, 0xFFFF) ==
+                               (redPixel | greenPixel | bluePixel);
+      if (pixelLayout.direct) {
+        for (value = 0; value <= 255; value++) {
+          pixelLayout.red[value]   = (uint32Type) drwRgbColor((intType) value * 257, 0, 0);
+          pixelLayout.green[value] = (uint32Type) drwRgbColor(0, (intType) value * 257, 0);
+          pixelLayout.blue[value]  = (uint32Type) drwRgbColor(0, 0, (intType) value * 257);
+        } /* for */
+      } /* if */
+      pixelLayout.initialized = TRUE;
+    } /* if */
+    return &pixelLayout;
+  } /* getPixelLayout */
+
+
+
+/**
+ *  Check that an area is inside of the pixels of 'data'.
+ *  The area must be inside of a line ('xPos' + 'width' <= 'stride')
+ *  and all lines of the area must be in 'data'.
+ */
+static boolType areaOkay (const const_bstriType data, intType stride,
+    intType xPos, intType yPos, intType width, intType height)
+
+  {
+    memSizeType numLines;
+    boolType okay;
+
+  /* areaOkay */
+    if (unlikely(stride < 0 || xPos < 0 || yPos < 0 ||
+                 width < 0 || height < 0 ||
+                 (uintType) stride > MAX_MEMSIZETYPE / sizeof(int32Type) ||
+                 xPos > stride || width > stride - xPos)) {
+      okay = FALSE;
+    } else if (width == 0 || height == 0) {
+      okay = TRUE;
+    } else {
+      numLines = data->size / sizeof(int32Type) / (memSizeType) stride;
+      okay = (uintType) yPos <= numLines &&
+             (uintType) height <= numLines - (memSizeType) yPos;
+    } /* if */
+    return okay;
+  } /* areaOkay */
+
+
+
+static bstriType allocPixels (intType width, intType height)
+
+  {
+    memSizeType size;
+    bstriType result;
+
+  /* allocPixels */
+    if (unlikely(width < 0 || height < 0)) {
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if (unlikely((uintType) width > MAX_MEMSIZETYPE / sizeof(int32Type) ||
+                        (width != 0 && (uintType) height >
+                         MAX_MEMSIZETYPE / sizeof(int32Type) / (memSizeType) width))) {
+      raise_error(MEMORY_ERROR);
+      result = NULL;
+    } else {
+      size = (memSizeType) width * (memSizeType) height * sizeof(int32Type);
+      if (unlikely(size > MAX_BSTRI_LEN || !ALLOC_BSTRI_SIZE_OK(result, size))) {
+        raise_error(MEMORY_ERROR);
+        result = NULL;
+      } else {
+        result->size = size;
+      } /* if */
+    } /* if */
+    return result;
+  } /* allocPixels */
+
+
+
+/**
+ *  Blend an area of 'srcData' into 'destData'.
+ *  Every channel of a destination pixel is replaced by
+ *  (src * alpha + dest * (255 - alpha)) / 255 (approximately). Two
+ *  channels are blended with one multiplication.
+ *  @param alpha Opacity of the source from 0 (transparent) to
+ *         255 (opaque).
+ *  @exception RANGE_ERROR If 'alpha' is not in the range 0 to 255 or
+ *             an area is not inside of its raster.
+ */
+void pxlBlend (bstriType destData, intType destStride, intType destX,
+    intType destY, const const_bstriType srcData, intType srcStride,
+    intType srcX, intType srcY, intType width, intType height,
+    intType alpha)
+
+  {
+    uint32Type factor;
+    int32Type *copy = NULL;
+    const int32Type *srcLine;
+    int32Type *destLine;
+    memSizeType srcLineStride;
+    memSizeType line;
+    memSizeType column;
+    uint32Type srcPixel;
+    uint32Type destPixel;
+
+  /* pxlBlend */
+    logFunction(printf("pxlBlend(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " FMT_D
+                       ", " FMT_U_MEM ", " FMT_D ", " FMT_D ", " FMT_D ", "
+                       FMT_D ", " FMT_D ", " FMT_D ")\n",
+                       (memSizeType) destData, destStride, destX, destY,
+                       (memSizeType) srcData, srcStride, srcX, srcY,
+                       width, height, alpha););
+    if (unlikely(alpha < 0 || alpha > 255 ||
+                 !areaOkay(destData, destStride, destX, destY, width, height) ||
+                 !areaOkay(srcData, srcStride, srcX, srcY, width, height))) {
+      raise_error(RANGE_ERROR);
+    } else if (width != 0 && height != 0 && alpha != 0) {
+      srcLine = &((const int32Type *) srcData->mem)[
+          (memSizeType) srcY * (memSizeType) srcStride + (memSizeType) srcX];
+      srcLineStride = (memSizeType) srcStride;
+      if (srcData == destData) {
+        /* Source and destination may overlap. */
+        copy = (int32Type *) malloc((memSizeType) width * (memSizeType) height *
+                                    sizeof(int32Type));
+        if (copy != NULL) {
+          for (line = 0; line < (memSizeType) height; line++) {
+            memcpy(&copy[line * (memSizeType) width], &srcLine[line * srcLineStride],
+                   (memSizeType) width * sizeof(int32Type));
+          } /* for */
+          srcLine = copy;
+          srcLineStride = (memSizeType) width;
+        } /* if */
+      } /* if */
+      if (unlikely(srcData == destData && copy == NULL)) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        destLine = &((int32Type *) destData->mem)[
+            (memSizeType) destY * (memSizeType) destStride + (memSizeType) destX];
+        /* Map 0 .. 255 to 0 .. 256, such that 255 is opaque. */
+        factor = (uint32Type) alpha + ((uint32Type) alpha >> 7);
+        for (line = 0; line < (memSizeType) height; line++) {
+          if (factor == 256) {
+            memcpy(destLine, srcLine, (memSizeType) width * sizeof(int32Type));
+          } else {
+            for (column = 0; column < (memSizeType) width; column++) {
+              srcPixel = (uint32Type) srcLine[column];
+              destPixel = (uint32Type) destLine[column];
+              destLine[column] = (int32Type) (
+                  ((((srcPixel & RED_BLUE_MASK) * factor +
+                     (destPixel & RED_BLUE_MASK) * (256 - factor)) >> 8) & RED_BLUE_MASK) |
+                  ((((srcPixel >> 8) & RED_BLUE_MASK) * factor +
+                    ((destPixel >> 8) & RED_BLUE_MASK) * (256 - factor)) & ALPHA_GREEN_MASK));
+            } /* for */
+          } /* if */
+          srcLine += srcLineStride;
+          destLine += destStride;
+        } /* for */
+        free(copy);
+      } /* if */
+    } /* if */
+  } /* pxlBlend */
+
+
+
+/**
+ *  Reduce the raster to the given area, without changing the stride.
+ *  The lines of the area are moved to the start of 'data'. Afterwards
+ *  line y of the area starts at pixel y * stride.
+ *  @exception RANGE_ERROR If the area is not inside of the raster.
+ */
+void pxlCrop (bstriType data, intType stride, intType xPos, intType yPos,
+    intType width, intType height)
+
+  {
+    int32Type *pixels;
+    memSizeType line;
+
+  /* pxlCrop */
+    logFunction(printf("pxlCrop(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " FMT_D
+                       ", " FMT_D ", " FMT_D ")\n",
+                       (memSizeType) data, stride, xPos, yPos, width, height););
+    if (unlikely(!areaOkay(data, stride, xPos, yPos, width, height))) {
+      raise_error(RANGE_ERROR);
+    } else if (width != 0 && (xPos != 0 || yPos != 0)) {
+      pixels = (int32Type *) data->mem;
+      for (line = 0; line < (memSizeType) height; line++) {
+        memmove(&pixels[line * (memSizeType) stride],
+                &pixels[(line + (memSizeType) yPos) * (memSizeType) stride +
+                        (memSizeType) xPos],
+                (memSizeType) width * sizeof(int32Type));
+      } /* for */
+    } /* if */
+  } /* pxlCrop */
+
+
+
+/**
+ *  Set all pixels of an area to 'pixel'.
+ *  @exception RANGE_ERROR If the area is not inside of the raster.
+ */
+void pxlFill (bstriType data, intType stride, intType xPos, intType yPos,
+    intType width, intType height, intType pixel)
+
+  {
+    int32Type *destLine;
+    memSizeType line;
+    memSizeType column;
+
+  /* pxlFill */
+    logFunction(printf("pxlFill(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " FMT_D
+                       ", " FMT_D ", " FMT_D ", " F_X(08) ")\n",
+                       (memSizeType) data, stride, xPos, yPos, width, height,
+                       pixel););
+    if (unlikely(!areaOkay(data, stride, xPos, yPos, width, height))) {
+      raise_error(RANGE_ERROR);
+    } else if (width != 0) {
+      destLine = &((int32Type *) data->mem)[
+          (memSizeType) yPos * (memSizeType) stride + (memSizeType) xPos];
+      for (line = 0; line < (memSizeType) height; line++) {
+        if (pixel == 0) {
+          memset(destLine, 0, (memSizeType) width * sizeof(int32Type));
+        } else {
+          for (column = 0; column < (memSizeType) width; column++) {
+            destLine[column] = (int32Type) pixel;
+          } /* for */
+        } /* if */
+        destLine += stride;
+      } /* for */
+    } /* if */
+  } /* pxlFill */
+
+
+
+/**
+ *  Copy an area of a raster to a new raster.
+ *  @return the pixels of the area with a stride of 'width'.
+ *  @exception RANGE_ERROR If the area is not inside of the raster.
+ *  @exception MEMORY_ERROR Not enough memory to create the result.
+ */
+bstriType pxlGetArea (const const_bstriType data, intType stride,
+    intType xPos, intType yPos, intType width, intType height)
+
+  {
+    const int32Type *srcLine;
+    int32Type *destLine;
+    memSizeType line;
+    bstriType result;
+
+  /* pxlGetArea */
+    logFunction(printf("pxlGetArea(" FMT_U_MEM ", " FMT_D ", " FMT_D ", "
+                       FMT_D ", " FMT_D ", " FMT_D ")\n",
+                       (memSizeType) data, stride, xPos, yPos, width, height););
+    if (unlikely(!areaOkay(data, stride, xPos, yPos, width, height))) {
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      result = allocPixels(width, height);
+      if (result != NULL && width != 0) {
+        srcLine = &((const int32Type *) data->mem)[
+            (memSizeType) yPos * (memSizeType) stride + (memSizeType) xPos];
+        destLine = (int32Type *) result->mem;
+        for (line = 0; line < (memSizeType) height; line++) {
+          memcpy(destLine, srcLine, (memSizeType) width * sizeof(int32Type));
+          srcLine += stride;
+          destLine += width;
+        } /* for */
+      } /* if */
+    } /* if */
+    return result;
+  } /* pxlGetArea */
+
+
+
+/**
+ *  Get the pixel at the position ('xPos', 'yPos') of a raster.
+ *  @exception RANGE_ERROR If the position is not inside of the raster.
+ */
+intType pxlGetPixel (const const_bstriType data, intType stride,
+    intType xPos, intType yPos)
+
+  {
+    intType pixel;
+
+  /* pxlGetPixel */
+    if (unlikely(!areaOkay(data, stride, xPos, yPos, 1, 1))) {
+      raise_error(RANGE_ERROR);
+      pixel = 0;
+    } else {
+      pixel = ((const int32Type *) data->mem)[
+          (memSizeType) yPos * (memSizeType) stride + (memSizeType) xPos];
+    } /* if */
+    return pixel;
+  } /* pxlGetPixel */
+
+
+
+/**
+ *  Create a new pixmap from the pixels of a raster.
+ *  If the lines of the raster are contiguous ('stride' = 'width')
+ *  the pixels are passed to the driver without copying them.
+ *  @return the created pixmap.
+ *  @exception RANGE_ERROR If 'width' or 'height' are not positive or
+ *             if the area is not inside of the raster.
+ *  @exception MEMORY_ERROR Not enough memory to create the pixmap.
+ */
+winType pxlGetPixmap (const const_bstriType data, intType width,
+    intType height, intType stride)
+
+  {
+    bstriType contiguous;
+    winType result;
+
+  /* pxlGetPixmap */
+    logFunction(printf("pxlGetPixmap(" FMT_U_MEM ", " FMT_D ", " FMT_D ", "
+                       FMT_D ")\n", (memSizeType) data, width, height, stride););
+    if (unlikely(width <= 0 || height <= 0 ||
+                 !areaOkay(data, stride, 0, 0, width, height))) {
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if (stride == width) {
+      result = drwImage((int32Type *) data->mem, (memSizeType) width,
+                        (memSizeType) height, TRUE);
+    } else {
+      contiguous = pxlGetArea(data, stride, 0, 0, width, height);
+      if (unlikely(contiguous == NULL)) {
+        result = NULL;
+      } else {
+        result = drwImage((int32Type *) contiguous->mem, (memSizeType) width,
+                          (memSizeType) height, TRUE);
+        FREE_BSTRI(contiguous, contiguous->size);
+      } /* if */
+    } /* if */
+    logFunction(printf("pxlGetPixmap --> " FMT_U_MEM "\n",
+                       (memSizeType) result););
+    return result;
+  } /* pxlGetPixmap */
+
+
+
+/**
+ *  Compute how the coefficient blocks of a JPEG image are stored.
+ *  The blocks of a component are stored in lines of blocks. The
+ *  luma blocks are followed by the chroma blue and the chroma red
+ *  blocks. Every block consists of 64 16-bit coefficients. The
+ *  luma component is sampled 'horizontal' * 'vertical' times per
+ *  minimum coded unit (MCU). The chroma components are sampled once
+ *  per MCU.
+ *  @return TRUE if the parameters describe a valid layout, or
+ *          FALSE otherwise.
+ */
+static boolType getJpegLayout (intType width, intType height,
+    intType horizontal, intType vertical, jpegLayoutType *layout)
+
+  {
+    memSizeType lumaBlocks;
+    memSizeType chromaBlocks;
+    boolType okay;
+
+  /* getJpegLayout */
+    if (unlikely(width <= 0 || height <= 0 ||
+                 width > JPEG_MAX_DIMENSION || height > JPEG_MAX_DIMENSION ||
+                 horizontal < 1 || horizontal > 2 ||
+                 vertical < 1 || vertical > 2)) {
+      okay = FALSE;
+    } else {
+      layout->horizontal = (unsigned int) horizontal;
+      layout->vertical   = (unsigned int) vertical;
+      layout->unitColumns = ((memSizeType) width - 1) / (8 * (memSizeType) horizontal) + 1;
+      layout->unitLines   = ((memSizeType) height - 1) / (8 * (memSizeType) vertical) + 1;
+      layout->blockColumns[0] = ((memSizeType) width - 1) / 8 + 1;
+      layout->blockLines[0]   = ((memSizeType) height - 1) / 8 + 1;
+      layout->blockColumns[1] = layout->unitColumns;
+      layout->blockLines[1]   = layout->unitLines;
+      layout->blockColumns[2] = layout->unitColumns;
+      layout->blockLines[2]   = layout->unitLines;
+      layout->blocksPerLine[0] = layout->unitColumns * (memSizeType) horizontal;
+      layout->blocksPerLine[1] = layout->unitColumns;
+      layout->blocksPerLine[2] = layout->unitColumns;
+      lumaBlocks = layout->blocksPerLine[0] * layout->unitLines * (memSizeType) vertical;
+      chromaBlocks = layout->unitColumns * layout->unitLines;
+      layout->firstBlock[0] = 0;
+      layout->firstBlock[1] = lumaBlocks;
+      layout->firstBlock[2] = lumaBlocks + chromaBlocks;
+      layout->beyondBlock[0] = lumaBlocks;
+      layout->beyondBlock[1] = lumaBlocks + chromaBlocks;
+      layout->beyondBlock[2] = lumaBlocks + 2 * chromaBlocks;
+      okay = TRUE;
+    } /* if */
+    return okay;
+  } /* getJpegLayout */
+
+
+
+/**
+ *  Create zeroed coefficients for all blocks of a JPEG image.
+ *  The coefficients are filled by pxlJpegDecodeScan() and converted
+ *  to pixels by pxlJpegToRaster().
+ *  @param horizontal Horizontal sampling factor of luma (1 or 2).
+ *  @param vertical Vertical sampling factor of luma (1 or 2).
+ *  @param numComponents Number of components (1 to 3).
+ *  @return the coefficients of all blocks.
+ *  @exception RANGE_ERROR If a parameter is not in its allowed range.
+ *  @exception MEMORY_ERROR Not enough memory to create the result.
+ */
+bstriType pxlJpegCoefficients (intType width, intType height,
+    intType horizontal, intType vertical, intType numComponents)
+
+  {
+    jpegLayoutType layout;
+    memSizeType size;
+    bstriType result;
+
+  /* pxlJpegCoefficients */
+    logFunction(printf("pxlJpegCoefficients(" FMT_D ", " FMT_D ", " FMT_D
+                       ", " FMT_D ", " FMT_D ")\n", width, height,
+                       horizontal, vertical, numComponents););
+    if (unlikely(numComponents < 1 || numComponents > 3 ||
+                 !getJpegLayout(width, height, horizontal, vertical,
+                                &layout))) {
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      size = layout.beyondBlock[numComponents - 1] * JPEG_BLOCK_BYTES;
+      if (unlikely(size > MAX_BSTRI_LEN || !ALLOC_BSTRI_SIZE_OK(result, size))) {
+        raise_error(MEMORY_ERROR);
+        result = NULL;
+      } else {
+        result->size = size;
+        memset(result->mem, 0, size);
+      } /* if */
+    } /* if */
+    return result;
+  } /* pxlJpegCoefficients */
+
+
+
+/**
+ *  Read a Huffman table in the format of a JPEG DHT segment.
+ *  The table starts with 16 bytes with the number of codes of the
+ *  code lengths 1 to 16. It is followed by the symbols ordered by
+ *  code length. The codes are assigned canonically. A code, which
+ *  is not assigned, is decoded as the last symbol with the maximum
+ *  code length.
+ *  @return the position after the table, or NULL if the table is
+ *          not valid.
+ */
+static const strElemType *getJpegHuffmanTable (const strElemType *spec,
+    const strElemType *beyond, jpegHuffmanType *table)
+
+  {
+    unsigned int numCodes[JPEG_MAX_CODE_LENGTH + 1];
+    unsigned int codeLength;
+    unsigned int numSymbols = 0;
+    unsigned int symbolIndex;
+    unsigned int code = 0;
+    unsigned int index;
+    unsigned int fastIndex;
+    unsigned int repeatCount;
+    uint16Type entry;
+
+  /* getJpegHuffmanTable */
+    if (unlikely(beyond - spec < JPEG_MAX_CODE_LENGTH)) {
+      return NULL;
+    } /* if */
+    table->maximumCodeLength = 0;
+    for (codeLength = 1; codeLength <= JPEG_MAX_CODE_LENGTH; codeLength++) {
+      if (unlikely(spec[codeLength - 1] > 255)) {
+        return NULL;
+      } /* if */
+      numCodes[codeLength] = (unsigned int) spec[codeLength - 1];
+      numSymbols += numCodes[codeLength];
+      if (numCodes[codeLength] != 0) {
+        table->maximumCodeLength = codeLength;
+      } /* if */
+    } /* for */
+    spec += JPEG_MAX_CODE_LENGTH;
+    if (unlikely(numSymbols > 256 ||
+                 (memSizeType) (beyond - spec) < numSymbols)) {
+      return NULL;
+    } /* if */
+    for (symbolIndex = 0; symbolIndex < numSymbols; symbolIndex++) {
+      if (unlikely(spec[symbolIndex] > 255)) {
+        return NULL;
+      } /* if */
+      table->symbols[symbolIndex] = (ucharType) spec[symbolIndex];
+    } /* for */
+    memset(table->fast, 0, sizeof(table->fast));
+    symbolIndex = 0;
+    for (codeLength = 1; codeLength <= JPEG_MAX_CODE_LENGTH; codeLength++) {
+      if (unlikely(code + numCodes[codeLength] > 1U << codeLength)) {
+        /* More codes than possible with this code length. */
+        return NULL;
+      } /* if */
+      table->maxCode[codeLength] = (int32Type) (code + numCodes[codeLength]) - 1;
+      table->valueOffset[codeLength] = (int32Type) symbolIndex - (int32Type) code;
+      if (codeLength <= JPEG_FAST_BITS) {
+        repeatCount = 1U << (JPEG_FAST_BITS - codeLength);
+        for (index = 0; index < numCodes[codeLength]; index++) {
+          entry = (uint16Type) (codeLength << 8 | table->symbols[symbolIndex + index]);
+          for (fastIndex = (code + index) * repeatCount;
+               fastIndex < (code + index + 1) * repeatCount; fastIndex++) {
+            table->fast[fastIndex] = entry;
+          } /* for */
+        } /* for */
+      } /* if */
+      code += numCodes[codeLength];
+      symbolIndex += numCodes[codeLength];
+      code <<= 1;
+    } /* for */
+    if (numSymbols != 0) {
+      table->lastSymbol = table->symbols[numSymbols - 1];
+      if (table->maximumCodeLength <= JPEG_FAST_BITS) {
+        entry = (uint16Type) (table->maximumCodeLength << 8 | table->lastSymbol);
+        for (fastIndex = 0; fastIndex < 1U << JPEG_FAST_BITS; fastIndex++) {
+          if (table->fast[fastIndex] == 0) {
+            table->fast[fastIndex] = entry;
+          } /* if */
+        } /* for */
+      } /* if */
+    } /* if */
+    return spec + numSymbols;
+  } /* getJpegHuffmanTable */
+
+
+
+/**
+ *  Fill the bit buffer of 'stream' with at least 25 bits.
+ *  The bytes 16#ff, 16#00 are read as 16#ff. A marker (16#ff
+ *  followed by another byte) is not consumed. At a marker and at
+ *  the end of the data the stream is padded with one bits.
+ */
+static void fillJpegBits (jpegBitStreamType *stream)
+
+  {
+    uint32Type byte;
+
+  /* fillJpegBits */
+    while (stream->bitsInBuffer <= 24) {
+      if (stream->pos >= stream->beyond) {
+        byte = 0xFF;
+      } else if (stream->pos[0] != 0xFF) {
+        byte = (uint32Type) stream->pos[0];
+        stream->pos++;
+      } else if (&stream->pos[1] < stream->beyond && stream->pos[1] == 0) {
+        byte = 0xFF;
+        stream->pos += 2;
+      } else {
+        byte = 0xFF;
+      } /* if */
+      stream->buffer |= byte << (24 - stream->bitsInBuffer);
+      stream->bitsInBuffer += 8;
+    } /* while */
+  } /* fillJpegBits */
+
+
+
+/**
+ *  Read 'numBits' (1 to 16) bits from 'stream' (MSB first).
+ */
+static inline unsigned int getJpegBits (jpegBitStreamType *stream,
+    unsigned int numBits)
+
+  {
+    unsigned int bits;
+
+  /* getJpegBits */
+    if (stream->bitsInBuffer < numBits) {
+      fillJpegBits(stream);
+    } /* if */
+    bits = (unsigned int) (stream->buffer >> (32 - numBits));
+    stream->buffer <<= numBits;
+    stream->bitsInBuffer -= numBits;
+    return bits;
+  } /* getJpegBits */
+
+
+
+/**
+ *  Read a value with 'bitWidth' (1 to 16) bits from 'stream'.
+ *  Negative values are encoded with the highest bit set to zero.
+ */
+static inline int32Type getJpegValue (jpegBitStreamType *stream,
+    unsigned int bitWidth)
+
+  {
+    int32Type value;
+
+  /* getJpegValue */
+    value = (int32Type) getJpegBits(stream, bitWidth);
+    if (value >> (bitWidth - 1) == 0) {
+      value -= (int32Type) ((1U << bitWidth) - 1);
+    } /* if */
+    return value;
+  } /* getJpegValue */
+
+
+
+static inline unsigned int getJpegSymbol (jpegBitStreamType *stream,
+    const jpegHuffmanType *table)
+
+  {
+    uint16Type entry;
+    unsigned int codeLength;
+    unsigned int symbol;
+
+  /* getJpegSymbol */
+    if (stream->bitsInBuffer < JPEG_MAX_CODE_LENGTH) {
+      fillJpegBits(stream);
+    } /* if */
+    entry = table->fast[stream->buffer >> (32 - JPEG_FAST_BITS)];
+    if (likely(entry != 0)) {
+      codeLength = (unsigned int) entry >> 8;
+      symbol = (unsigned int) entry & 0xFF;
+    } else {
+      codeLength = JPEG_FAST_BITS + 1;
+      while (codeLength <= table->maximumCodeLength &&
+             (int32Type) (stream->buffer >> (32 - codeLength)) >
+             table->maxCode[codeLength]) {
+        codeLength++;
+      } /* while */
+      if (codeLength > table->maximumCodeLength) {
+        codeLength = table->maximumCodeLength;
+        symbol = table->lastSymbol;
+      } else {
+        symbol = table->symbols[(int32Type) (stream->buffer >> (32 - codeLength)) +
+                                table->valueOffset[codeLength]];
+      } /* if */
+    } /* if */
+    stream->buffer <<= codeLength;
+    stream->bitsInBuffer -= codeLength;
+    return symbol;
+  } /* getJpegSymbol */
+
+
+
+/**
+ *  Skip to the data after the next restart marker and reset 'stream'.
+ */
+static void restartJpegBits (jpegBitStreamType *stream)
+
+  { /* restartJpegBits */
+    while (stream->pos < stream->beyond &&
+           (stream->pos[0] != 0xFF || &stream->pos[1] >= stream->beyond ||
+            stream->pos[1] < 0xD0 || stream->pos[1] > 0xD7)) {
+      stream->pos++;
+    } /* while */
+    if (stream->pos < stream->beyond) {
+      stream->pos += 2;
+    } /* if */
+    stream->buffer = 0;
+    stream->bitsInBuffer = 0;
+  } /* restartJpegBits */
+
+
+
+/**
+ *  Decode the difference of the DC coefficient of a block and add
+ *  it to the DC predictor of the 'component'.
+ *  @return FALSE if the data is corrupt, or TRUE otherwise.
+ */
+static inline boolType decodeJpegDc (jpegBitStreamType *stream,
+    jpegScanComponentType *component)
+
+  {
+    unsigned int bitWidth;
+    boolType okay = TRUE;
+
+  /* decodeJpegDc */
+    bitWidth = getJpegSymbol(stream, &component->dcTable);
+    if (bitWidth != 0) {
+      if (unlikely(bitWidth > JPEG_MAX_VALUE_BITS)) {
+        okay = FALSE;
+      } else {
+        component->predictor += getJpegValue(stream, bitWidth);
+      } /* if */
+    } /* if */
+    return okay;
+  } /* decodeJpegDc */
+
+
+
+/**
+ *  Decode all 64 coefficients of a block of a sequential JPEG.
+ *  @return FALSE if the data is corrupt, or TRUE otherwise.
+ */
+static boolType decodeJpegBlock (jpegBitStreamType *stream,
+    jpegScanComponentType *component, int16Type *block)
+
+  {
+    unsigned int symbol;
+    unsigned int bitWidth;
+    unsigned int index = 0;
+
+  /* decodeJpegBlock */
+    memset(block, 0, JPEG_BLOCK_BYTES);
+    if (unlikely(!decodeJpegDc(stream, component))) {
+      return FALSE;
+    } /* if */
+    block[0] = (int16Type) component->predictor;
+    do {
+      symbol = getJpegSymbol(stream, &component->acTable);
+      index += (symbol >> 4) + 1;
+      bitWidth = symbol & 0xF;
+      if (bitWidth != 0) {
+        if (unlikely(index >= JPEG_BLOCK_SIZE)) {
+          return FALSE;
+        } /* if */
+        block[index] = (int16Type) getJpegValue(stream, bitWidth);
+        if (index == JPEG_BLOCK_SIZE - 1) {
+          symbol = 0;
+        } /* if */
+      } else if (unlikely(symbol != 0 && index >= JPEG_BLOCK_SIZE)) {
+        return FALSE;
+      } /* if */
+    } while (symbol != 0);
+    return TRUE;
+  } /* decodeJpegBlock */
+
+
+
+/**
+ *  Decode the first AC coefficients of a block of a progressive JPEG.
+ *  @return FALSE if the data is corrupt, or TRUE otherwise.
+ */
+static boolType decodeJpegAcFirst (jpegBitStreamType *stream,
+    jpegScanComponentType *component, jpegScanType *scan,
+    int16Type *block)
+
+  {
+    unsigned int symbol;
+    unsigned int zeros;
+    unsigned int bitWidth;
+    unsigned int index;
+
+  /* decodeJpegAcFirst */
+    if (scan->eobRunLength > 0) {
+      scan->eobRunLength--;
+    } else {
+      index = scan->startOfSpectral - 1;
+      do {
+        symbol = getJpegSymbol(stream, &component->acTable);
+        zeros = symbol >> 4;
+        bitWidth = symbol & 0xF;
+        if (bitWidth == 0) {
+          if (zeros == 15) {
+            index += 16;
+            if (unlikely(index >= JPEG_BLOCK_SIZE - 1)) {
+              return FALSE;
+            } /* if */
+          } else {
+            scan->eobRunLength = 1U << zeros;
+            if (zeros != 0) {
+              scan->eobRunLength += getJpegBits(stream, zeros);
+            } /* if */
+            scan->eobRunLength--;
+            symbol = 0;
+          } /* if */
+        } else {
+          index += zeros + 1;
+          if (unlikely(index >= JPEG_BLOCK_SIZE)) {
+            return FALSE;
+          } /* if */
+          block[index] = (int16Type) (getJpegValue(stream, bitWidth) *
+                                      ((int32Type) 1 << scan->approximationLow));
+          if (index == scan->endOfSpectral) {
+            symbol = 0;
+          } /* if */
+        } /* if */
+      } while (symbol != 0);
+    } /* if */
+    return TRUE;
+  } /* decodeJpegAcFirst */
+
+
+
+/**
+ *  Refine the nonzero AC coefficients of a block, starting at
+ *  'spectral', until 'numberOfZeros' zero coefficients have been
+ *  skipped. A negative 'numberOfZeros' refines up to the end of
+ *  the spectral band.
+ *  @return the index of the first coefficient not processed.
+ */
+static unsigned int refineJpegNonZeroes (jpegBitStreamType *stream,
+    const jpegScanType *scan, int16Type *block, unsigned int spectral,
+    int numberOfZeros, int16Type delta)
+
+  {
+    boolType enoughZeros = FALSE;
+
+  /* refineJpegNonZeroes */
+    while (spectral <= scan->endOfSpectral && !enoughZeros) {
+      if (block[spectral] == 0) {
+        if (numberOfZeros == 0) {
+          enoughZeros = TRUE;
+        } else {
+          numberOfZeros--;
+          spectral++;
+        } /* if */
+      } else {
+        if (getJpegBits(stream, 1) != 0) {
+          if (block[spectral] >= 0) {
+            block[spectral] = (int16Type) (block[spectral] + delta);
+          } else {
+            block[spectral] = (int16Type) (block[spectral] - delta);
+          } /* if */
+        } /* if */
+        spectral++;
+      } /* if */
+    } /* while */
+    return spectral;
+  } /* refineJpegNonZeroes */
+
+
+
+/**
+ *  Refine the AC coefficients of a block of a progressive JPEG.
+ *  @return FALSE if the data is corrupt, or TRUE otherwise.
+ */
+static boolType refineJpegAc (jpegBitStreamType *stream,
+    jpegScanComponentType *component, jpegScanType *scan,
+    int16Type *block)
+
+  {
+    int16Type delta;
+    int16Type coefficient;
+    unsigned int spectral;
+    unsigned int symbol;
+    unsigned int zeros;
+    unsigned int bitWidth;
+
+  /* refineJpegAc */
+    delta = (int16Type) (1 << scan->approximationLow);
+    spectral = scan->startOfSpectral;
+    while (spectral <= scan->endOfSpectral && scan->eobRunLength == 0) {
+      coefficient = 0;
+      symbol = getJpegSymbol(stream, &component->acTable);
+      zeros = symbol >> 4;
+      bitWidth = symbol & 0xF;
+      if (bitWidth == 0) {
+        if (zeros != 15) {
+          scan->eobRunLength = 1U << zeros;
+          if (zeros != 0) {
+            scan->eobRunLength += getJpegBits(stream, zeros);
+          } /* if */
+        } /* if */
+      } else if (bitWidth == 1) {
+        if (getJpegBits(stream, 1) != 0) {
+          coefficient = delta;
+        } else {
+          coefficient = (int16Type) -delta;
+        } /* if */
+      } else {
+        return FALSE;
+      } /* if */
+      if (scan->eobRunLength == 0) {
+        spectral = refineJpegNonZeroes(stream, scan, block, spectral,
+                                       (int) zeros, delta);
+        if (unlikely(spectral > scan->endOfSpectral)) {
+          return FALSE;
+        } /* if */
+        if (coefficient != 0) {
+          block[spectral] = coefficient;
+        } /* if */
+        spectral++;
+      } /* if */
+    } /* while */
+    if (scan->eobRunLength > 0) {
+      scan->eobRunLength--;
+      refineJpegNonZeroes(stream, scan, block, spectral, -1, delta);
+    } /* if */
+    return TRUE;
+  } /* refineJpegAc */
+
+
+
+/**
+ *  Decode the data of one block of a scan.
+ *  @return FALSE if the data is corrupt, or TRUE otherwise.
+ */
+static boolType decodeJpegScanBlock (jpegBitStreamType *stream,
+    jpegScanComponentType *component, jpegScanType *scan, int16Type *block)
+
+  {
+    boolType okay = TRUE;
+
+  /* decodeJpegScanBlock */
+    switch (scan->kind) {
+      case JPEG_SCAN_SEQUENTIAL:
+        okay = decodeJpegBlock(stream, component, block);
+        break;
+      case JPEG_SCAN_DC_FIRST:
+        okay = decodeJpegDc(stream, component);
+        block[0] = (int16Type) (component->predictor *
+                                ((int32Type) 1 << scan->approximationLow));
+        break;
+      case JPEG_SCAN_DC_REFINE:
+        if (getJpegBits(stream, 1) != 0) {
+          block[0] = (int16Type) (block[0] + (1 << scan->approximationLow));
+        } /* if */
+        break;
+      case JPEG_SCAN_AC_FIRST:
+        okay = decodeJpegAcFirst(stream, component, scan, block);
+        break;
+      case JPEG_SCAN_AC_REFINE:
+        okay = refineJpegAc(stream, component, scan, block);
+        break;
+    } /* switch */
+    return okay;
+  } /* decodeJpegScanBlock */
+
+
+
+/**
+ *  Decode the entropy coded data of a JPEG scan into 'coefficients'.
+ *  The coefficients of the blocks are stored in zigzag order and
+ *  they are not dequantized. The scan is sequential, if
+ *  'startOfSpectral' is 0 and 'endOfSpectral' is 63. Otherwise it
+ *  is a scan of a progressive JPEG. Scans of a progressive JPEG
+ *  must be decoded in the order of the file into the same
+ *  coefficients.
+ *  @param scanData Entropy coded data of the scan. The data still
+ *         contains the bytes 16#ff, 16#00 (which stand for 16#ff) and
+ *         the restart markers.
+ *  @param scanTables For every component of the scan the component
+ *         number (1 to 3) followed by the DC and the AC Huffman table.
+ *         A Huffman table starts with the 16 code counts followed by
+ *         the symbols (as in a DHT segment).
+ *  @param startOfSpectral Ss of the scan header (0 to 63).
+ *  @param endOfSpectral Se of the scan header (0 to 63).
+ *  @param approximationHigh Ah of the scan header.
+ *  @param approximationLow Al of the scan header.
+ *  @param restartInterval Number of MCUs between restart markers,
+ *         or 0 if there are no restart markers.
+ *  @exception RANGE_ERROR If a parameter is not in its allowed range,
+ *             if a Huffman table is not valid or if the data is corrupt.
+ */
+void pxlJpegDecodeScan (bstriType coefficients, const const_striType scanData,
+    const const_striType scanTables, intType width, intType height,
+    intType horizontal, intType vertical, intType startOfSpectral,
+    intType endOfSpectral, intType approximationHigh,
+    intType approximationLow, intType restartInterval)
+
+  {
+    jpegLayoutType layout;
+    jpegScanType scan;
+    jpegScanComponentType *component;
+    jpegBitStreamType stream;
+    const strElemType *tablePos;
+    const strElemType *tableBeyond;
+    strElemType checkBits = 0;
+    memSizeType pos;
+    unsigned int numComponents = 0;
+    unsigned int compIndex;
+    unsigned int plane;
+    memSizeType unitLine;
+    memSizeType unitColumn;
+    memSizeType blockLine;
+    memSizeType blockColumn;
+    memSizeType mcuLines;
+    memSizeType mcuColumns;
+    memSizeType mcuCount;
+    unsigned int sampleLine;
+    unsigned int sampleColumn;
+    int16Type *blocks;
+    boolType needsDcTable;
+    boolType needsAcTable;
+    boolType okay;
+
+  /* pxlJpegDecodeScan */
+    logFunction(printf("pxlJpegDecodeScan(" FMT_U_MEM ", \"%s\", \"%s\", "
+                       FMT_D ", " FMT_D ", " FMT_D ", " FMT_D ", " FMT_D ", "
+                       FMT_D ", " FMT_D ", " FMT_D ", " FMT_D ")\n",
+                       (memSizeType) coefficients,
+                       striAsUnquotedCStri(scanData),
+                       striAsUnquotedCStri(scanTables), width, height,
+                       horizontal, vertical, startOfSpectral, endOfSpectral,
+                       approximationHigh, approximationLow, restartInterval););
+    okay = getJpegLayout(width, height, horizontal, vertical, &layout) &&
+           startOfSpectral >= 0 && startOfSpectral <= endOfSpectral &&
+           endOfSpectral < JPEG_BLOCK_SIZE &&
+           approximationHigh >= 0 && approximationHigh <= 13 &&
+           approximationLow >= 0 && approximationLow <= 13 &&
+           restartInterval >= 0 && restartInterval <= 65535;
+    if (okay) {
+      tablePos = scanTables->mem;
+      tableBeyond = &scanTables->mem[scanTables->size];
+      while (okay && tablePos < tableBeyond) {
+        if (numComponents >= 3 || *tablePos < 1 || *tablePos > 3) {
+          okay = FALSE;
+        } else {
+          component = &scan.component[numComponents];
+          component->plane = (unsigned int) *tablePos - 1;
+          component->predictor = 0;
+          tablePos++;
+          tablePos = getJpegHuffmanTable(tablePos, tableBeyond,
+                                         &component->dcTable);
+          if (tablePos != NULL) {
+            tablePos = getJpegHuffmanTable(tablePos, tableBeyond,
+                                           &component->acTable);
+          } /* if */
+          okay = tablePos != NULL &&
+                 layout.beyondBlock[component->plane] * JPEG_BLOCK_BYTES <=
+                 coefficients->size;
+          numComponents++;
+        } /* if */
+      } /* while */
+      okay = okay && numComponents != 0;
+    } /* if */
+    if (okay) {
+      scan.startOfSpectral = (unsigned int) startOfSpectral;
+      scan.endOfSpectral = (unsigned int) endOfSpectral;
+      scan.approximationLow = (unsigned int) approximationLow;
+      scan.eobRunLength = 0;
+      if (startOfSpectral == 0 && endOfSpectral == JPEG_BLOCK_SIZE - 1) {
+        scan.kind = JPEG_SCAN_SEQUENTIAL;
+      } else if (startOfSpectral == 0) {
+        scan.kind = approximationHigh == 0 ? JPEG_SCAN_DC_FIRST : JPEG_SCAN_DC_REFINE;
+      } else {
+        scan.kind = approximationHigh == 0 ? JPEG_SCAN_AC_FIRST : JPEG_SCAN_AC_REFINE;
+      } /* if */
+      needsDcTable = scan.kind == JPEG_SCAN_SEQUENTIAL ||
+                     scan.kind == JPEG_SCAN_DC_FIRST;
+      needsAcTable = scan.kind == JPEG_SCAN_SEQUENTIAL ||
+                     scan.kind == JPEG_SCAN_AC_FIRST ||
+                     scan.kind == JPEG_SCAN_AC_REFINE;
+      for (compIndex = 0; compIndex < numComponents; compIndex++) {
+        component = &scan.component[compIndex];
+        if ((needsDcTable && component->dcTable.maximumCodeLength == 0) ||
+            (needsAcTable && component->acTable.maximumCodeLength == 0)) {
+          okay = FALSE;
+        } /* if */
+      } /* for */
+      for (pos = 0; pos < scanData->size; pos++) {
+        checkBits |= scanData->mem[pos];
+      } /* for */
+      okay = okay && checkBits <= 255;
+    } /* if */
+    if (unlikely(!okay)) {
+      raise_error(RANGE_ERROR);
+    } else {
+      stream.pos = scanData->mem;
+      stream.beyond = &scanData->mem[scanData->size];
+      stream.buffer = 0;
+      stream.bitsInBuffer = 0;
+      blocks = (int16Type *) coefficients->mem;
+      mcuCount = (memSizeType) restartInterval;
+      if (numComponents == 1) {
+        /* Not interleaved: Every MCU consists of one block. */
+        component = &scan.component[0];
+        plane = component->plane;
+        mcuLines = layout.blockLines[plane];
+        mcuColumns = layout.blockColumns[plane];
+      } else {
+        mcuLines = layout.unitLines;
+        mcuColumns = layout.unitColumns;
+      } /* if */
+      for (unitLine = 0; okay && unitLine < mcuLines; unitLine++) {
+        for (unitColumn = 0; okay && unitColumn < mcuColumns; unitColumn++) {
+          if (restartInterval != 0) {
+            if (mcuCount == 0) {
+              restartJpegBits(&stream);
+              for (compIndex = 0; compIndex < numComponents; compIndex++) {
+                scan.component[compIndex].predictor = 0;
+              } /* for */
+              scan.eobRunLength = 0;
+              mcuCount = (memSizeType) restartInterval;
+            } /* if */
+            mcuCount--;
+          } /* if */
+          if (numComponents == 1) {
+            okay = decodeJpegScanBlock(&stream, component, &scan,
+                &blocks[(layout.firstBlock[plane] +
+                         unitLine * layout.blocksPerLine[plane] + unitColumn) *
+                        JPEG_BLOCK_SIZE]);
+          } else {
+            for (compIndex = 0; okay && compIndex < numComponents; compIndex++) {
+              component = &scan.component[compIndex];
+              plane = component->plane;
+              if (plane == 0) {
+                for (sampleLine = 0; okay && sampleLine < layout.vertical; sampleLine++) {
+                  blockLine = unitLine * layout.vertical + sampleLine;
+                  for (sampleColumn = 0; okay && sampleColumn < layout.horizontal;
+                       sampleColumn++) {
+                    blockColumn = unitColumn * layout.horizontal + sampleColumn;
+                    okay = decodeJpegScanBlock(&stream, component, &scan,
+                        &blocks[(blockLine * layout.blocksPerLine[0] + blockColumn) *
+                                JPEG_BLOCK_SIZE]);
+                  } /* for */
+                } /* for */
+              } else {
+                okay = decodeJpegScanBlock(&stream, component, &scan,
+                    &blocks[(layout.firstBlock[plane] +
+                             unitLine * layout.blocksPerLine[plane] + unitColumn) *
+                            JPEG_BLOCK_SIZE]);
+              } /* if */
+            } /* for */
+          } /* if */
+        } /* for */
+      } /* for */
+      if (unlikely(!okay)) {
+        raise_error(RANGE_ERROR);
+      } /* if */
+    } /* if */
+  } /* pxlJpegDecodeScan */
+
+
+
+/**
+ *  Inverse discrete cosine transform of the 8 values of a block
+ *  line (step 1) or block column (step 8). For the internal
+ *  calculation the values are scaled by 2048. At the end the
+ *  scaling is reversed. A DC only line or column is just filled
+ *  with its DC value (the full calculation gives the same result).
+ */
+static void jpegIdct8 (intType *value, unsigned int step)
+
+  {
+    intType x0, x1, x2, x3, x4, x5, x6, x7, x8;
+
+  /* jpegIdct8 */
+    x1 = value[4 * step];
+    x2 = value[6 * step];
+    x3 = value[2 * step];
+    x4 = value[1 * step];
+    x5 = value[7 * step];
+    x6 = value[5 * step];
+    x7 = value[3 * step];
+    if ((x1 | x2 | x3 | x4 | x5 | x6 | x7) == 0) {
+      value[1 * step] = value[0];
+      value[2 * step] = value[0];
+      value[3 * step] = value[0];
+      value[4 * step] = value[0];
+      value[5 * step] = value[0];
+      value[6 * step] = value[0];
+      value[7 * step] = value[0];
+    } else {
+      x0 = value[0] * 2048 + 128;
+      x1 *= 2048;
+
+      /* First stage */
+      x8 = JPEG_W7 * (x4 + x5);
+      x4 = x8 + (JPEG_W1 - JPEG_W7) * x4;
+      x5 = x8 - (JPEG_W1 + JPEG_W7) * x5;
+      x8 = JPEG_W3 * (x6 + x7);
+      x6 = x8 - (JPEG_W3 - JPEG_W5) * x6;
+      x7 = x8 - (JPEG_W3 + JPEG_W5) * x7;
+
+      /* Second stage */
+      x8 = x0 + x1;
+      x0 -= x1;
+      x1 = JPEG_W6 * (x3 + x2);
+      x2 = x1 - (JPEG_W2 + JPEG_W6) * x2;
+      x3 = x1 + (JPEG_W2 - JPEG_W6) * x3;
+      x1 = x4 + x6;
+      x4 -= x6;
+      x6 = x5 + x7;
+      x5 -= x7;
+
+      /* Third stage */
+      x7 = x8 + x3;
+      x8 -= x3;
+      x3 = x0 + x2;
+      x0 -= x2;
+      x2 = FLOOR_SHIFT(181 * (x4 + x5) + 128, 8);
+      x4 = FLOOR_SHIFT(181 * (x4 - x5) + 128, 8);
+
+      /* Fourth stage */
+      value[0]        = FLOOR_SHIFT(x7 + x1, 11);
+      value[1 * step] = FLOOR_SHIFT(x3 + x2, 11);
+      value[2 * step] = FLOOR_SHIFT(x0 + x4, 11);
+      value[3 * step] = FLOOR_SHIFT(x8 + x6, 11);
+      value[4 * step] = FLOOR_SHIFT(x8 - x6, 11);
+      value[5 * step] = FLOOR_SHIFT(x0 - x4, 11);
+      value[6 * step] = FLOOR_SHIFT(x3 - x2, 11);
+      value[7 * step] = FLOOR_SHIFT(x7 - x1, 11);
+    } /* if */
+  } /* jpegIdct8 */
+
+
+
+/**
+ *  Dequantize the coefficients of a block, undo the zigzag order
+ *  and do the inverse discrete cosine transform. The resulting
+ *  samples are scaled with factor 8 and centered around 0. They
+ *  are not clamped.
+ */
+static void jpegBlockToSamples (const int16Type *block,
+    const strElemType *quantization, intType *sample)
+
+  {
+    static const ucharType zigzag[] = {
+         0,  1,  5,  6, 14, 15, 27, 28,
+         2,  4,  7, 13, 16, 26, 29, 42,
+         3,  8, 12, 17, 25, 30, 41, 43,
+         9, 11, 18, 24, 31, 40, 44, 53,
+        10, 19, 23, 32, 39, 45, 52, 54,
+        20, 22, 33, 38, 46, 51, 55, 60,
+        21, 34, 37, 47, 50, 56, 59, 61,
+        35, 36, 48, 49, 57, 58, 62, 63};
+    int acBits = 0;
+    unsigned int index;
+
+  /* jpegBlockToSamples */
+    for (index = 1; index < JPEG_BLOCK_SIZE; index++) {
+      acBits |= block[index];
+    } /* for */
+    if (acBits == 0) {
+      /* Only the DC coefficient: All samples are equal. */
+      sample[0] = (intType) block[0] * (intType) quantization[0];
+      for (index = 1; index < JPEG_BLOCK_SIZE; index++) {
+        sample[index] = sample[0];
+      } /* for */
+    } else {
+      for (index = 0; index < JPEG_BLOCK_SIZE; index++) {
+        sample[index] = (intType) block[zigzag[index]] *
+                        (intType) quantization[zigzag[index]];
+      } /* for */
+      for (index = 0; index < JPEG_BLOCK_SIZE; index += 8) {
+        jpegIdct8(&sample[index], 1);
+      } /* for */
+      for (index = 0; index < 8; index++) {
+        jpegIdct8(&sample[index], 8);
+      } /* for */
+    } /* if */
+  } /* jpegBlockToSamples */
+
+
+
+static inline unsigned int clampJpegSample (intType value)
+
+  { /* clampJpegSample */
+    return value < 0 ? 0 : (value > 255 ? 255 : (unsigned int) value);
+  } /* clampJpegSample */
+
+
+
+/**
+ *  Convert the blocks of a minimum coded unit (MCU) to RGB.
+ *  A gray MCU consists of one 8x8 block. A color MCU covers
+ *  8 * 'horizontal' columns and 8 * 'vertical' lines. The chroma
+ *  samples are upsampled by repeating them. The colors are
+ *  converted from YCbCr to RGB with the integer approximation
+ *  R = Y + 1.402 * Cr, G = Y - 0.344 * Cb - 0.714 * Cr and
+ *  B = Y + 1.772 * Cb. The red, green and blue bytes of the
+ *  pixels are written to 'rgb' with a line length of
+ *  3 * 'unitWidth' bytes.
+ */
+static void jpegUnitToRgb (const int16Type *blocks,
+    const strElemType *quantization, intType numComponents,
+    const jpegLayoutType *layout, memSizeType unitLine,
+    memSizeType unitColumn, unsigned int unitWidth, ucharType *rgb)
+
+  {
+    intType luma[4 * JPEG_BLOCK_SIZE];
+    intType chromaBlue[JPEG_BLOCK_SIZE];
+    intType chromaRed[JPEG_BLOCK_SIZE];
+    intType redDelta[JPEG_BLOCK_SIZE];
+    intType greenDelta[JPEG_BLOCK_SIZE];
+    intType blueDelta[JPEG_BLOCK_SIZE];
+    unsigned int line;
+    unsigned int column;
+    unsigned int index;
+    unsigned int chromaIndex;
+    intType luminance;
+    ucharType *destRgb;
+
+  /* jpegUnitToRgb */
+    if (numComponents == 1) {
+      jpegBlockToSamples(&blocks[(unitLine * layout->blocksPerLine[0] +
+                                  unitColumn) * JPEG_BLOCK_SIZE],
+                         quantization, luma);
+      for (index = 0; index < JPEG_BLOCK_SIZE; index++) {
+        destRgb = &rgb[3 * index];
+        destRgb[0] = (ucharType) clampJpegSample(FLOOR_SHIFT(luma[index], 3) + 128);
+        destRgb[1] = destRgb[0];
+        destRgb[2] = destRgb[0];
+      } /* for */
+    } else {
+      for (index = 0; index < layout->horizontal * layout->vertical; index++) {
+        jpegBlockToSamples(&blocks[
+            ((unitLine * layout->vertical + index / layout->horizontal) *
+             layout->blocksPerLine[0] +
+             unitColumn * layout->horizontal + index % layout->horizontal) *
+            JPEG_BLOCK_SIZE],
+            quantization, &luma[index * JPEG_BLOCK_SIZE]);
+      } /* for */
+      jpegBlockToSamples(&blocks[(layout->firstBlock[1] +
+                                  unitLine * layout->blocksPerLine[1] +
+                                  unitColumn) * JPEG_BLOCK_SIZE],
+                         &quantization[JPEG_BLOCK_SIZE], chromaBlue);
+      jpegBlockToSamples(&blocks[(layout->firstBlock[2] +
+                                  unitLine * layout->blocksPerLine[2] +
+                                  unitColumn) * JPEG_BLOCK_SIZE],
+                         &quantization[2 * JPEG_BLOCK_SIZE], chromaRed);
+      for (index = 0; index < JPEG_BLOCK_SIZE; index++) {
+        redDelta[index] = FLOOR_SHIFT(chromaRed[index] * 359, 11);
+        greenDelta[index] = FLOOR_SHIFT(chromaBlue[index] * 88 +
+                                        chromaRed[index] * 183, 11);
+        blueDelta[index] = FLOOR_SHIFT(chromaBlue[index] * 454, 11);
+      } /* for */
+      for (line = 0; line < 8 * layout->vertical; line++) {
+        destRgb = &rgb[3 * line * unitWidth];
+        for (column = 0; column < unitWidth; column++) {
+          luminance = FLOOR_SHIFT(luma[
+              ((line >> 3) * layout->horizontal + (column >> 3)) * JPEG_BLOCK_SIZE +
+              (line & 7) * 8 + (column & 7)], 3) + 128;
+          chromaIndex = line / layout->vertical * 8 + column / layout->horizontal;
+          destRgb[0] = (ucharType) clampJpegSample(luminance + redDelta[chromaIndex]);
+          destRgb[1] = (ucharType) clampJpegSample(luminance - greenDelta[chromaIndex]);
+          destRgb[2] = (ucharType) clampJpegSample(luminance + blueDelta[chromaIndex]);
+          destRgb += 3;
+        } /* for */
+      } /* for */
+    } /* if */
+  } /* jpegUnitToRgb */
+
+
+
+/**
+ *  Convert the coefficients of a JPEG image to RGB or to pixels.
+ *  If 'rgbData' is not NULL the red, green and blue bytes of the
+ *  pixels are written to it with a line length of 3 * 'width'
+ *  bytes. Otherwise the pixels are written to 'pixelData' with
+ *  a line length of 'stride' pixels.
+ */
+static void jpegToPixels (const int16Type *blocks,
+    const strElemType *quantization, intType numComponents,
+    const jpegLayoutType *layout, memSizeType width, memSizeType height,
+    ucharType *rgbData, int32Type *pixelData, memSizeType stride)
+
+  {
+    const pixelLayoutType *pixLayout = NULL;
+    ucharType unitRgb[3 * 4 * JPEG_BLOCK_SIZE];
+    memSizeType unitLines;
+    memSizeType unitColumns;
+    unsigned int unitWidth;
+    unsigned int unitHeight;
+    memSizeType unitLine;
+    memSizeType unitColumn;
+    memSizeType lineBase;
+    memSizeType columnBase;
+    unsigned int lineMax;
+    unsigned int columnMax;
+    unsigned int line;
+    unsigned int column;
+    const ucharType *sourceRgb;
+    int32Type *destPixel;
+
+  /* jpegToPixels */
+    if (numComponents == 1) {
+      unitLines = layout->blockLines[0];
+      unitColumns = layout->blockColumns[0];
+      unitWidth = 8;
+      unitHeight = 8;
+    } else {
+      unitLines = layout->unitLines;
+      unitColumns = layout->unitColumns;
+      unitWidth = 8 * layout->horizontal;
+      unitHeight = 8 * layout->vertical;
+    } /* if */
+    if (rgbData == NULL) {
+      pixLayout = getPixelLayout();
+    } /* if */
+    for (unitLine = 0; unitLine < unitLines; unitLine++) {
+      lineBase = unitLine * unitHeight;
+      lineMax = (unsigned int) (height - lineBase < unitHeight ?
+                                height - lineBase : unitHeight);
+      for (unitColumn = 0; unitColumn < unitColumns; unitColumn++) {
+        columnBase = unitColumn * unitWidth;
+        columnMax = (unsigned int) (width - columnBase < unitWidth ?
+                                    width - columnBase : unitWidth);
+        jpegUnitToRgb(blocks, quantization, numComponents, layout,
+                      unitLine, unitColumn, unitWidth, unitRgb);
+        for (line = 0; line < lineMax; line++) {
+          sourceRgb = &unitRgb[3 * line * unitWidth];
+          if (rgbData != NULL) {
+            memcpy(&rgbData[3 * ((lineBase + line) * width + columnBase)],
+                   sourceRgb, 3 * columnMax);
+          } else {
+            destPixel = &pixelData[(lineBase + line) * stride + columnBase];
+            for (column = 0; column < columnMax; column++) {
+              if (pixLayout->direct) {
+                destPixel[column] = (int32Type) (pixLayout->red[sourceRgb[0]] |
+                                                 pixLayout->green[sourceRgb[1]] |
+                                                 pixLayout->blue[sourceRgb[2]]);
+              } else {
+                destPixel[column] = (int32Type) drwRgbColor((intType) sourceRgb[0] * 257,
+                                                            (intType) sourceRgb[1] * 257,
+                                                            (intType) sourceRgb[2] * 257);
+              } /* if */
+              sourceRgb += 3;
+            } /* for */
+          } /* if */
+        } /* for */
+      } /* for */
+    } /* for */
+  } /* jpegToPixels */
+
+
+
+/**
+ *  Check the parameters of pxlJpegToRaster() and pxlJpegToRgb().
+ *  @return TRUE if the parameters are okay, or FALSE otherwise.
+ */
+static boolType jpegParametersOkay (const const_bstriType coefficients,
+    const const_striType quantization, intType numComponents,
+    intType width, intType height, intType horizontal, intType vertical,
+    jpegLayoutType *layout)
+
+  {
+    strElemType checkBits = 0;
+    memSizeType pos;
+
+  /* jpegParametersOkay */
+    for (pos = 0; pos < quantization->size; pos++) {
+      checkBits |= quantization->mem[pos];
+    } /* for */
+    return (numComponents == 1 || numComponents == 3) &&
+           getJpegLayout(width, height, horizontal, vertical, layout) &&
+           layout->beyondBlock[numComponents - 1] * JPEG_BLOCK_BYTES <=
+               coefficients->size &&
+           quantization->size == (memSizeType) numComponents * JPEG_BLOCK_SIZE &&
+           checkBits <= 0xFFFF;
+  } /* jpegParametersOkay */
+
+
+
+/**
+ *  Convert the coefficients of a JPEG image to pixels.
+ *  The pixels are written to the area from (0, 0) to
+ *  ('width' - 1, 'height' - 1) of the raster 'data'. The
+ *  conversion is described at jpegUnitToRgb().
+ *  @param coefficients Coefficients of all blocks (see
+ *         pxlJpegDecodeScan()).
+ *  @param quantization For every component 64 quantization values
+ *         in zigzag order.
+ *  @param numComponents 1 for gray images and 3 for color images.
+ *  @exception RANGE_ERROR If a parameter is not in its allowed range,
+ *             if 'coefficients' is too short or if the area is not
+ *             inside of the raster.
+ */
+void pxlJpegToRaster (bstriType data, intType stride,
+    const const_bstriType coefficients, const const_striType quantization,
+    intType numComponents, intType width, intType height,
+    intType horizontal, intType vertical)
+
+  {
+    jpegLayoutType layout;
+
+  /* pxlJpegToRaster */
+    logFunction(printf("pxlJpegToRaster(" FMT_U_MEM ", " FMT_D ", "
+                       FMT_U_MEM ", \"%s\", " FMT_D ", " FMT_D ", " FMT_D
+                       ", " FMT_D ", " FMT_D ")\n", (memSizeType) data,
+                       stride, (memSizeType) coefficients,
+                       striAsUnquotedCStri(quantization), numComponents,
+                       width, height, horizontal, vertical););
+    if (unlikely(!jpegParametersOkay(coefficients, quantization,
+                                     numComponents, width, height,
+                                     horizontal, vertical, &layout) ||
+                 !areaOkay(data, stride, 0, 0, width, height))) {
+      raise_error(RANGE_ERROR);
+    } else {
+      jpegToPixels((const int16Type *) coefficients->mem, quantization->mem,
+                   numComponents, &layout, (memSizeType) width,
+                   (memSizeType) height, NULL, (int32Type *) data->mem,
+                   (memSizeType) stride);
+    } /* if */
+  } /* pxlJpegToRaster */
+
+
+
+/**
+ *  Convert the coefficients of a JPEG image to RGB.
+ *  This does the same computation as pxlJpegToRaster(), but the
+ *  result does not depend on the pixel format of the graphic
+ *  driver. It is used to check the conversion.
+ *  @return the red, green and blue bytes of all pixels, line by line.
+ *  @exception RANGE_ERROR If a parameter is not in its allowed range
+ *             or if 'coefficients' is too short.
+ *  @exception MEMORY_ERROR Not enough memory to create the result.
+ */
+bstriType pxlJpegToRgb (const const_bstriType coefficients,
+    const const_striType quantization, intType numComponents,
+    intType width, intType height, intType horizontal, intType vertical)
+
+  {
+    jpegLayoutType layout;
+    memSizeType size;
+    bstriType result;
+
+  /* pxlJpegToRgb */
+    logFunction(printf("pxlJpegToRgb(" FMT_U_MEM ", \"%s\", " FMT_D ", "
+                       FMT_D ", " FMT_D ", " FMT_D ", " FMT_D ")\n",
+                       (memSizeType) coefficients,
+                       striAsUnquotedCStri(quantization), numComponents,
+                       width, height, horizontal, vertical););
+    if (unlikely(!jpegParametersOkay(coefficients, quantization,
+                                     numComponents, width, height,
+                                     horizontal, vertical, &layout))) {
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if (unlikely((memSizeType) width > MAX_BSTRI_LEN / 3 / (memSizeType) height)) {
+      raise_error(MEMORY_ERROR);
+      result = NULL;
+    } else {
+      size = 3 * (memSizeType) width * (memSizeType) height;
+      if (unlikely(!ALLOC_BSTRI_SIZE_OK(result, size))) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        result->size = size;
+        jpegToPixels((const int16Type *) coefficients->mem, quantization->mem,
+                     numComponents, &layout, (memSizeType) width,
+                     (memSizeType) height, result->mem, NULL, 0);
+      } /* if */
+    } /* if */
+    return result;
+  } /* pxlJpegToRgb */
+
+
+
+/**
+ *  Create a raster with 'width' * 'height' pixels set to 'pixel'.
+ *  @return the pixels of the new raster with a stride of 'width'.
+ *  @exception RANGE_ERROR If 'width' or 'height' are negative.
+ *  @exception MEMORY_ERROR Not enough memory to create the raster.
+ */
+bstriType pxlNew (intType width, intType height, intType pixel)
+
+  {
+    int32Type *pixels;
+    memSizeType numPixels;
+    memSizeType pos;
+    bstriType result;
+
+  /* pxlNew */
+    logFunction(printf("pxlNew(" FMT_D ", " FMT_D ", " F_X(08) ")\n",
+                       width, height, pixel););
+    result = allocPixels(width, height);
+    if (result != NULL) {
+      if (pixel == 0) {
+        memset(result->mem, 0, result->size);
+      } else {
+        pixels = (int32Type *) result->mem;
+        numPixels = result->size / sizeof(int32Type);
+        for (pos = 0; pos < numPixels; pos++) {
+          pixels[pos] = (int32Type) pixel;
+        } /* for */
+      } /* if */
+    } /* if */
+    return result;
+  } /* pxlNew */
+
+
+
+/**
+ *  Determine the number of bytes per pixel of 'bytes' in 'format'.
+ *  @return the number of bytes per pixel, or 0 if 'format' is
+ *          unknown, if the length of 'bytes' is not a multiple of
+ *          the pixel size or if a character of 'bytes' is beyond
+ *          '\255;'.
+ */
+static memSizeType pixelBytesSize (const const_striType bytes,
+    intType format)
+
+  {
+    memSizeType bytesPerPixel;
+    memSizeType pos;
+    strElemType checkBits = 0;
+
+  /* pixelBytesSize */
+    switch (format) {
+      case PXL_GRAY_8:        bytesPerPixel = 1; break;
+      case PXL_GRAY_16:       bytesPerPixel = 2; break;
+      case PXL_RGB_24:        bytesPerPixel = 3; break;
+      case PXL_RGB_48:        bytesPerPixel = 6; break;
+      case PXL_BGR_24:        bytesPerPixel = 3; break;
+      case PXL_BGRX_32:       bytesPerPixel = 4; break;
+      case PXL_RGBA_32:       bytesPerPixel = 4; break;
+      case PXL_RGBA_64:       bytesPerPixel = 8; break;
+      case PXL_GRAY_ALPHA_16: bytesPerPixel = 2; break;
+      case PXL_GRAY_ALPHA_32: bytesPerPixel = 4; break;
+      default:                bytesPerPixel = 0; break;
+    } /* switch */
+    for (pos = 0; pos < bytes->size; pos++) {
+      checkBits |= bytes->mem[pos];
+    } /* for */
+    if (bytesPerPixel == 0 || bytes->size % bytesPerPixel != 0 ||
+        checkBits > 255) {
+      bytesPerPixel = 0;
+    } /* if */
+    return bytesPerPixel;
+  } /* pixelBytesSize */
+
+
+
+/**
+ *  Get the red, green and blue value of the pixel at 'byte'.
+ *  16-bit values are big-endian and only their high byte is used.
+ *  The alpha channel of the formats with alpha is ignored.
+ */
+static inline void pixelBytesToRgb (const strElemType *byte, intType format,
+    unsigned int *red, unsigned int *green, unsigned int *blue)
+
+  { /* pixelBytesToRgb */
+    switch (format) {
+      case PXL_GRAY_8:
+      case PXL_GRAY_16:
+      case PXL_GRAY_ALPHA_16:
+      case PXL_GRAY_ALPHA_32:
+        *red = *green = *blue = (unsigned int) byte[0];
+        break;
+      case PXL_RGB_24:
+      case PXL_RGBA_32:
+        *red   = (unsigned int) byte[0];
+        *green = (unsigned int) byte[1];
+        *blue  = (unsigned int) byte[2];
+        break;
+      case PXL_RGB_48:
+      case PXL_RGBA_64:
+        *red   = (unsigned int) byte[0];
+        *green = (unsigned int) byte[2];
+        *blue  = (unsigned int) byte[4];
+        break;
+      default: /* PXL_BGR_24 and PXL_BGRX_32 */
+        *blue  = (unsigned int) byte[0];
+        *green = (unsigned int) byte[1];
+        *red   = (unsigned int) byte[2];
+        break;
+    } /* switch */
+  } /* pixelBytesToRgb */
+
+
+
+/**
+ *  Convert 'bytes' with pixels in the given 'format' to RGB.
+ *  This does the same conversion as pxlSetPixels(), but the result
+ *  does not depend on the pixel format of the graphic driver. It is
+ *  used to check the conversion.
+ *  @return the red, green and blue bytes of the pixels.
+ *  @exception RANGE_ERROR If 'format' is unknown, if the length of
+ *             'bytes' is not a multiple of the pixel size or if a
+ *             character of 'bytes' is beyond '\255;'.
+ *  @exception MEMORY_ERROR Not enough memory to create the result.
+ */
+bstriType pxlPixelsToRgb (const const_striType bytes, intType format)
+
+  {
+    memSizeType bytesPerPixel;
+    memSizeType numPixels;
+    memSizeType pos;
+    const strElemType *byte;
+    unsigned int red;
+    unsigned int green;
+    unsigned int blue;
+    bstriType result;
+
+  /* pxlPixelsToRgb */
+    logFunction(printf("pxlPixelsToRgb(\"%s\", " FMT_D ")\n",
+                       striAsUnquotedCStri(bytes), format););
+    bytesPerPixel = pixelBytesSize(bytes, format);
+    if (unlikely(bytesPerPixel == 0)) {
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      numPixels = bytes->size / bytesPerPixel;
+      if (unlikely(numPixels > MAX_BSTRI_LEN / 3 ||
+                   !ALLOC_BSTRI_SIZE_OK(result, 3 * numPixels))) {
+        raise_error(MEMORY_ERROR);
+        result = NULL;
+      } else {
+        result->size = 3 * numPixels;
+        byte = bytes->mem;
+        for (pos = 0; pos < numPixels; pos++) {
+          pixelBytesToRgb(byte, format, &red, &green, &blue);
+          result->mem[3 * pos]     = (ucharType) red;
+          result->mem[3 * pos + 1] = (ucharType) green;
+          result->mem[3 * pos + 2] = (ucharType) blue;
+          byte += bytesPerPixel;
+        } /* for */
+      } /* if */
+    } /* if */
+    return result;
+  } /* pxlPixelsToRgb */
+
+
+/**
+ *  Predict a byte from its left (a), upper (b) and upper left (c)
+ *  neighbour, as defined for the PNG filter type 4 (Paeth).
+ */
+static inline unsigned int paethPredictor (unsigned int a, unsigned int b,
+    unsigned int c)
+
+  {
+    int pa;
+    int pb;
+    int pc;
+
+  /* paethPredictor */
+    pa = abs((int) b - (int) c);
+    pb = abs((int) a - (int) c);
+    pc = abs((int) a + (int) b - 2 * (int) c);
+    return pa <= pb && pa <= pc ? a : (pb <= pc ? b : c);
+  } /* paethPredictor */
+
+
+
+static inline unsigned int filterCost (unsigned int delta)
+
+  { /* filterCost */
+    return delta >= 128 ? 256 - delta : delta;
+  } /* filterCost */
+
+
+
+static boolType pngDataOkay (const const_striType pixelData, intType height,
+    intType bytesPerScanline, intType bytesPerPixel)
+
+  { /* pngDataOkay */
+    return height >= 0 && bytesPerScanline >= 1 &&
+           bytesPerPixel >= 1 && bytesPerPixel <= 8 &&
+           (height == 0 ||
+            (uintType) bytesPerScanline <= pixelData->size / (memSizeType) height);
+  } /* pngDataOkay */
+
+
+
+/**
+ *  Apply PNG filters to the scanlines of 'pixelData'.
+ *  Every scanline consists of a filter type byte followed by
+ *  bytesPerScanline - 1 bytes of pixel data. For every scanline the
+ *  filter (0 to 4) with the smallest sum of absolute differences is
+ *  chosen. The lines are processed from bottom to top, such that the
+ *  line above is still unfiltered.
+ *  @param pixelData Unfiltered scanlines, which are replaced by the
+ *         filtered scanlines.
+ *  @param bytesPerPixel Number of bytes per pixel (rounded up to 1).
+ *  @exception RANGE_ERROR If 'pixelData' is too short.
+ *  @exception MEMORY_ERROR Not enough memory for the filter buffers.
+ */
+void pxlPngFilter (striType pixelData, intType height,
+    intType bytesPerScanline, intType bytesPerPixel)
+
+  {
+    memSizeType length;
+    memSizeType bpp;
+    ucharType *buffer;
+    ucharType *filtered[5];
+    uintType sum[5];
+    strElemType *line;
+    const strElemType *prior;
+    intType lineNum;
+    memSizeType pos;
+    unsigned int filterType;
+    unsigned int best;
+    unsigned int left;
+    unsigned int upLeft;
+    unsigned int delta;
+
+  /* pxlPngFilter */
+    logFunction(printf("pxlPngFilter(\"%s\", " FMT_D ", " FMT_D ", " FMT_D ")\n",
+                       striAsUnquotedCStri(pixelData), height,
+                       bytesPerScanline, bytesPerPixel););
+    if (unlikely(!pngDataOkay(pixelData, height, bytesPerScanline,
+                              bytesPerPixel))) {
+      raise_error(RANGE_ERROR);
+    } else if (height != 0 && bytesPerScanline > 1) {
+      length = (memSizeType) bytesPerScanline - 1;
+      bpp = (memSizeType) bytesPerPixel;
+      if (unlikely(length > MAX_MEMSIZETYPE / 4 ||
+                   (buffer = (ucharType *) malloc(4 * length)) == NULL)) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        for (filterType = 1; filterType <= 4; filterType++) {
+          filtered[filterType] = &buffer[(filterType - 1) * length];
+        } /* for */
+        for (lineNum = height - 1; lineNum >= 0; lineNum--) {
+          line = &pixelData->mem[(memSizeType) lineNum *
+                                 (memSizeType) bytesPerScanline + 1];
+          if (lineNum != 0) {
+            prior = line - bytesPerScanline;
+          } else {
+            prior = NULL;
+          } /* if */
+          memset(sum, 0, sizeof(sum));
+          for (pos = 0; pos < length; pos++) {
+            sum[0] += filterCost(line[pos] & 0xFF);
+          } /* for */
+          /* The first bytesPerPixel bytes of filter 1 and of the  */
+          /* filters 3 and 4 in the first line are not counted.     */
+          /* This chooses the same filters as the former Seed7      */
+          /* implementation in png.s7i.                             */
+          for (pos = 0; pos < length && pos < bpp; pos++) {
+            filtered[1][pos] = (ucharType) line[pos];
+            if (prior == NULL) {
+              filtered[3][pos] = (ucharType) line[pos];
+              filtered[4][pos] = (ucharType) line[pos];
+            } else {
+              delta = (line[pos] - prior[pos]) & 0xFF;
+              filtered[2][pos] = (ucharType) delta;
+              sum[2] += filterCost(delta);
+              delta = (line[pos] - (prior[pos] >> 1)) & 0xFF;
+              filtered[3][pos] = (ucharType) delta;
+              sum[3] += filterCost(delta);
+              delta = (line[pos] - prior[pos]) & 0xFF;
+              filtered[4][pos] = (ucharType) delta;
+              sum[4] += filterCost(delta);
+            } /* if */
+          } /* for */
+          for (; pos < length; pos++) {
+            left = line[pos - bpp];
+            delta = (line[pos] - left) & 0xFF;
+            filtered[1][pos] = (ucharType) delta;
+            sum[1] += filterCost(delta);
+            if (prior == NULL) {
+              delta = (line[pos] - (left >> 1)) & 0xFF;
+              filtered[3][pos] = (ucharType) delta;
+              sum[3] += filterCost(delta);
+              delta = (line[pos] - left) & 0xFF;
+              filtered[4][pos] = (ucharType) delta;
+              sum[4] += filterCost(delta);
+            } else {
+              upLeft = prior[pos - bpp];
+              delta = (line[pos] - prior[pos]) & 0xFF;
+              filtered[2][pos] = (ucharType) delta;
+              sum[2] += filterCost(delta);
+              delta = (line[pos] - ((left + prior[pos]) >> 1)) & 0xFF;
+              filtered[3][pos] = (ucharType) delta;
+              sum[3] += filterCost(delta);
+              delta = (line[pos] - paethPredictor(left, prior[pos], upLeft)) & 0xFF;
+              filtered[4][pos] = (ucharType) delta;
+              sum[4] += filterCost(delta);
+            } /* if */
+          } /* for */
+          if (prior == NULL) {
+            /* The up filter is not used in the first line. */
+            sum[2] = UINTTYPE_MAX;
+          } /* if */
+          best = 0;
+          for (filterType = 1; filterType <= 4; filterType++) {
+            if (sum[filterType] < sum[best]) {
+              best = filterType;
+            } /* if */
+          } /* for */
+          if (best != 0) {
+            line[-1] = (strElemType) best;
+            for (pos = 0; pos < length; pos++) {
+              line[pos] = filtered[best][pos];
+            } /* for */
+          } /* if */
+        } /* for */
+        free(buffer);
+      } /* if */
+    } /* if */
+  } /* pxlPngFilter */
+
+
+
+/**
+ *  Undo the PNG filters of the scanlines in 'pixelData'.
+ *  Every scanline consists of a filter type byte followed by
+ *  bytesPerScanline - 1 filtered bytes. The filter type bytes are
+ *  left unchanged. Scanlines with an unknown filter type are not
+ *  changed. The filter types 0 (none) and 2 (up) work on
+ *  independent bytes. The other filters depend on the byte
+ *  'bytesPerPixel' to the left.
+ *  @param pixelData Filtered scanlines, which are replaced by the
+ *         unfiltered scanlines.
+ *  @param bytesPerPixel Number of bytes per pixel (rounded up to 1).
+ *  @exception RANGE_ERROR If 'pixelData' is too short.
+ */
+void pxlPngUnfilter (striType pixelData, intType height,
+    intType bytesPerScanline, intType bytesPerPixel)
+
+  {
+    memSizeType length;
+    memSizeType bpp;
+    strElemType *line;
+    const strElemType *prior;
+    intType lineNum;
+    memSizeType pos;
+
+  /* pxlPngUnfilter */
+    logFunction(printf("pxlPngUnfilter(\"%s\", " FMT_D ", " FMT_D ", " FMT_D ")\n",
+                       striAsUnquotedCStri(pixelData), height,
+                       bytesPerScanline, bytesPerPixel););
+    if (unlikely(!pngDataOkay(pixelData, height, bytesPerScanline,
+                              bytesPerPixel))) {
+      raise_error(RANGE_ERROR);
+    } else {
+      length = (memSizeType) bytesPerScanline - 1;
+      bpp = (memSizeType) bytesPerPixel;
+      prior = NULL;
+      for (lineNum = 0; lineNum < height; lineNum++) {
+        line = &pixelData->mem[(memSizeType) lineNum *
+                               (memSizeType) bytesPerScanline + 1];
+        switch (line[-1]) {
+          case 1:
+            for (pos = bpp; pos < length; pos++) {
+              line[pos] = (line[pos] + line[pos - bpp]) & 0xFF;
+            } /* for */
+            break;
+          case 2:
+            if (prior != NULL) {
+              for (pos = 0; pos < length; pos++) {
+                line[pos] = (line[pos] + prior[pos]) & 0xFF;
+              } /* for */
+            } /* if */
+            break;
+          case 3:
+            if (prior == NULL) {
+              for (pos = bpp; pos < length; pos++) {
+                line[pos] = (line[pos] + (line[pos - bpp] >> 1)) & 0xFF;
+              } /* for */
+            } else {
+              for (pos = 0; pos < length && pos < bpp; pos++) {
+                line[pos] = (line[pos] + (prior[pos] >> 1)) & 0xFF;
+              } /* for */
+              for (; pos < length; pos++) {
+                line[pos] = (line[pos] +
+                             ((line[pos - bpp] + prior[pos]) >> 1)) & 0xFF;
+              } /* for */
+            } /* if */
+            break;
+          case 4:
+            if (prior == NULL) {
+              /* Without upper line the Paeth predictor is the left byte. */
+              for (pos = bpp; pos < length; pos++) {
+                line[pos] = (line[pos] + line[pos - bpp]) & 0xFF;
+              } /* for */
+            } else {
+              for (pos = 0; pos < length && pos < bpp; pos++) {
+                line[pos] = (line[pos] + prior[pos]) & 0xFF;
+              } /* for */
+              for (; pos < length; pos++) {
+                line[pos] = (line[pos] +
+                             paethPredictor(line[pos - bpp], prior[pos],
+                                            prior[pos - bpp])) & 0xFF;
+              } /* for */
+            } /* if */
+            break;
+        } /* switch */
+        prior = line;
+      } /* for */
+    } /* if */
+  } /* pxlPngUnfilter */
+
+
+
+/**
+ *  Scale a raster to 'newWidth' * 'newHeight' pixels.
+ *  When a dimension is reduced every destination pixel is the
+ *  average of the source pixels in its box (area averaging). When
+ *  a dimension is enlarged the source pixels are replicated.
+ *  @return the pixels of the scaled raster with a stride of 'newWidth'.
+ *  @exception RANGE_ERROR If a size is negative, if the area is not
+ *             inside of the raster or if an empty raster should be
+ *             enlarged.
+ *  @exception MEMORY_ERROR Not enough memory to create the result.
+ */
+bstriType pxlScale (const const_bstriType data, intType width,
+    intType height, intType stride, intType newWidth, intType newHeight)
+
+  {
+    memSizeType *xBegin;
+    memSizeType *xEnd;
+    uintType *sum;
+    memSizeType destX;
+    memSizeType destY;
+    memSizeType srcX;
+    memSizeType srcY;
+    memSizeType yBegin;
+    memSizeType yEnd;
+    const int32Type *srcLine;
+    int32Type *destPixel;
+    uint32Type pixel;
+    uintType count;
+    uintType *channel;
+    bstriType result;
+
+  /* pxlScale */
+    logFunction(printf("pxlScale(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " FMT_D
+                       ", " FMT_D ", " FMT_D ")\n", (memSizeType) data,
+                       width, height, stride, newWidth, newHeight););
+    if (unlikely(!areaOkay(data, stride, 0, 0, width, height) ||
+                 newWidth < 0 || newHeight < 0 ||
+                 ((width == 0 || height == 0) &&
+                  newWidth != 0 && newHeight != 0))) {
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if ((result = allocPixels(newWidth, newHeight)) != NULL &&
+               newWidth != 0 && newHeight != 0) {
+      xBegin = (memSizeType *) malloc((memSizeType) newWidth * sizeof(memSizeType));
+      xEnd = (memSizeType *) malloc((memSizeType) newWidth * sizeof(memSizeType));
+      sum = (uintType *) malloc((memSizeType) newWidth * 4 * sizeof(uintType));
+      if (unlikely(xBegin == NULL || xEnd == NULL || sum == NULL)) {
+        free(xBegin);
+        free(xEnd);
+        free(sum);
+        FREE_BSTRI(result, result->size);
+        raise_error(MEMORY_ERROR);
+        result = NULL;
+      } else {
+        for (destX = 0; destX < (memSizeType) newWidth; destX++) {
+          xBegin[destX] = (memSizeType) ((uintType) destX * (uintType) width /
+                                         (uintType) newWidth);
+          xEnd[destX] = (memSizeType) ((uintType) (destX + 1) * (uintType) width /
+                                       (uintType) newWidth);
+          if (xEnd[destX] == xBegin[destX]) {
+            xEnd[destX]++;
+          } /* if */
+        } /* for */
+        destPixel = (int32Type *) result->mem;
+        for (destY = 0; destY < (memSizeType) newHeight; destY++) {
+          yBegin = (memSizeType) ((uintType) destY * (uintType) height /
+                                  (uintType) newHeight);
+          yEnd = (memSizeType) ((uintType) (destY + 1) * (uintType) height /
+                                (uintType) newHeight);
+          if (yEnd == yBegin) {
+            yEnd++;
+          } /* if */
+          memset(sum, 0, (memSizeType) newWidth * 4 * sizeof(uintType));
+          for (srcY = yBegin; srcY < yEnd; srcY++) {
+            srcLine = &((const int32Type *) data->mem)[srcY * (memSizeType) stride];
+            channel = sum;
+            for (destX = 0; destX < (memSizeType) newWidth; destX++) {
+              for (srcX = xBegin[destX]; srcX < xEnd[destX]; srcX++) {
+                pixel = (uint32Type) srcLine[srcX];
+                channel[0] += pixel & 0xFF;
+                channel[1] += (pixel >> 8) & 0xFF;
+                channel[2] += (pixel >> 16) & 0xFF;
+                channel[3] += pixel >> 24;
+              } /* for */
+              channel += 4;
+            } /* for */
+          } /* for */
+          channel = sum;
+          for (destX = 0; destX < (memSizeType) newWidth; destX++) {
+            count = (uintType) (xEnd[destX] - xBegin[destX]) *
+                    (uintType) (yEnd - yBegin);
+            *destPixel = (int32Type) (
+                (uint32Type) ((channel[0] + count / 2) / count) |
+                (uint32Type) ((channel[1] + count / 2) / count) << 8 |
+                (uint32Type) ((channel[2] + count / 2) / count) << 16 |
+                (uint32Type) ((channel[3] + count / 2) / count) << 24);
+            destPixel++;
+            channel += 4;
+          } /* for */
+        } /* for */
+        free(xBegin);
+        free(xEnd);
+        free(sum);
+      } /* if */
+    } /* if */
+    return result;
+  } /* pxlScale */
+
+
+
+/**
+ *  Convert palette indices from 'bytes' to pixels.
+ *  The indices are packed with 'bitsPerIndex' bits and the
+ *  leftmost index is in the most significant bits of a byte (as in
+ *  PNG and BMP files). The pixels are stored in the line 'yPos'
+ *  starting at 'xPos'.
+ *  @param count Number of pixels to be converted.
+ *  @param bitsPerIndex One of 1, 2, 4 or 8.
+ *  @param palette Pixels of the palette.
+ *  @param paletteSize Number of pixels in 'palette'.
+ *  @exception RANGE_ERROR If 'bitsPerIndex' is not 1, 2, 4 or 8, if
+ *             'bytes' is too short, if the pixels do not fit into the
+ *             line, if a character of 'bytes' is beyond '\255;' or if
+ *             an index is not less than 'paletteSize'.
+ */
+void pxlSetIndexedPixels (bstriType data, intType stride, intType xPos,
+    intType yPos, intType count, const const_striType bytes,
+    intType bitsPerIndex, const const_bstriType palette,
+    intType paletteSize)
+
+  {
+    memSizeType numBytes;
+    memSizeType pos;
+    strElemType checkBits = 0;
+    const int32Type *colors;
+    int32Type *destPixel;
+    unsigned int indicesPerByte;
+    unsigned int mask;
+    unsigned int shift;
+    unsigned int index;
+
+  /* pxlSetIndexedPixels */
+    logFunction(printf("pxlSetIndexedPixels(" FMT_U_MEM ", " FMT_D ", "
+                       FMT_D ", " FMT_D ", " FMT_D ", \"%s\", " FMT_D ", "
+                       FMT_U_MEM ", " FMT_D ")\n", (memSizeType) data,
+                       stride, xPos, yPos, count, striAsUnquotedCStri(bytes),
+                       bitsPerIndex, (memSizeType) palette, paletteSize););
+    if (unlikely((bitsPerIndex != 1 && bitsPerIndex != 2 &&
+                  bitsPerIndex != 4 && bitsPerIndex != 8) ||
+                 count < 0 || paletteSize < 0 ||
+                 (uintType) paletteSize > palette->size / sizeof(int32Type) ||
+                 !areaOkay(data, stride, xPos, yPos, count, 1))) {
+      raise_error(RANGE_ERROR);
+    } else {
+      indicesPerByte = 8 / (unsigned int) bitsPerIndex;
+      numBytes = ((memSizeType) count + indicesPerByte - 1) / indicesPerByte;
+      if (unlikely(numBytes > bytes->size)) {
+        raise_error(RANGE_ERROR);
+      } else {
+        for (pos = 0; pos < numBytes; pos++) {
+          checkBits |= bytes->mem[pos];
+        } /* for */
+        if (unlikely(checkBits > 255)) {
+          raise_error(RANGE_ERROR);
+        } else {
+          colors = (const int32Type *) palette->mem;
+          destPixel = &((int32Type *) data->mem)[
+              (memSizeType) yPos * (memSizeType) stride + (memSizeType) xPos];
+          mask = (1U << bitsPerIndex) - 1;
+          for (pos = 0; pos < (memSizeType) count; pos++) {
+            if (bitsPerIndex == 8) {
+              index = (unsigned int) bytes->mem[pos];
+            } else {
+              shift = 8 - (unsigned int) bitsPerIndex *
+                      (unsigned int) (pos % indicesPerByte + 1);
+              index = ((unsigned int) bytes->mem[pos / indicesPerByte] >> shift) & mask;
+            } /* if */
+            if (unlikely(index >= (unsigned int) paletteSize)) {
+              raise_error(RANGE_ERROR);
+              pos = (memSizeType) count;
+            } else {
+              destPixel[pos] = colors[index];
+            } /* if */
+          } /* for */
+        } /* if */
+      } /* if */
+    } /* if */
+  } /* pxlSetIndexedPixels */
+
+
+
+/**
+ *  Set the pixel at the position ('xPos', 'yPos') of a raster.
+ *  @exception RANGE_ERROR If the position is not inside of the raster.
+ */
+void pxlSetPixel (bstriType data, intType stride, intType xPos,
+    intType yPos, intType pixel)
+
+  { /* pxlSetPixel */
+    if (unlikely(!areaOkay(data, stride, xPos, yPos, 1, 1))) {
+      raise_error(RANGE_ERROR);
+    } else {
+      ((int32Type *) data->mem)[
+          (memSizeType) yPos * (memSizeType) stride + (memSizeType) xPos] =
+          (int32Type) pixel;
+    } /* if */
+  } /* pxlSetPixel */
+
+
+
+/**
+ *  Convert 'bytes' with pixels in the given 'format' to pixels.
+ *  The pixels are stored in the line 'yPos' starting at 'xPos'.
+ *  16-bit values are big-endian and only their high byte is used.
+ *  The alpha channel of the formats with alpha is ignored.
+ *  @param format One of PXL_GRAY_8, PXL_GRAY_16, PXL_RGB_24,
+ *         PXL_RGB_48, PXL_BGR_24, PXL_BGRX_32, PXL_RGBA_32,
+ *         PXL_RGBA_64, PXL_GRAY_ALPHA_16 or PXL_GRAY_ALPHA_32.
+ *  @exception RANGE_ERROR If 'format' is unknown, if the length of
+ *             'bytes' is not a multiple of the pixel size, if the
+ *             pixels do not fit into the line or if a character of
+ *             'bytes' is beyond '\255;'.
+ */
+void pxlSetPixels (bstriType data, intType stride, intType xPos,
+    intType yPos, const const_striType bytes, intType format)
+
+  {
+    const pixelLayoutType *layout;
+    memSizeType bytesPerPixel;
+    memSizeType numPixels;
+    memSizeType pos;
+    const strElemType *byte;
+    int32Type *destPixel;
+    unsigned int red;
+    unsigned int green;
+    unsigned int blue;
+
+  /* pxlSetPixels */
+    logFunction(printf("pxlSetPixels(" FMT_U_MEM ", " FMT_D ", " FMT_D ", "
+                       FMT_D ", \"%s\", " FMT_D ")\n", (memSizeType) data,
+                       stride, xPos, yPos, striAsUnquotedCStri(bytes), format););
+    bytesPerPixel = pixelBytesSize(bytes, format);
+    if (unlikely(bytesPerPixel == 0 ||
+                 (uintType) (bytes->size / bytesPerPixel) > (uintType) INTTYPE_MAX ||
+                 !areaOkay(data, stride, xPos, yPos,
+                           (intType) (bytes->size / bytesPerPixel), 1))) {
+      raise_error(RANGE_ERROR);
+    } else if (bytes->size != 0) {
+      layout = getPixelLayout();
+      numPixels = bytes->size / bytesPerPixel;
+      byte = bytes->mem;
+      destPixel = &((int32Type *) data->mem)[
+          (memSizeType) yPos * (memSizeType) stride + (memSizeType) xPos];
+      for (pos = 0; pos < numPixels; pos++) {
+        pixelBytesToRgb(byte, format, &red, &green, &blue);
+        if (layout->direct) {
+          destPixel[pos] = (int32Type) (layout->red[red] |
+                                        layout->green[green] |
+                                        layout->blue[blue]);
+        } else {
+          destPixel[pos] = (int32Type) drwRgbColor((intType) red * 257,
+                                                   (intType) green * 257,
+                                                   (intType) blue * 257);
+        } /* if */
+        byte += bytesPerPixel;
+      } /* for */
+    } /* if */
+  } /* pxlSetPixels */
+
+
+
+/**
+ *  Rotate and/or mirror a raster.
+ *  The 'orientation' uses the values of the Exif orientation tag.
+ *  It describes how the stored pixels are oriented. The result is
+ *  the raster turned upright:
+ *   1: Unchanged copy.
+ *   2: Mirror horizontally.
+ *   3: Rotate by 180 degrees.
+ *   4: Mirror vertically.
+ *   5: Transpose (rotate by 270 degrees counterclockwise and mirror horizontally).
+ *   6: Rotate by 270 degrees counterclockwise.
+ *   7: Transverse (rotate by 90 degrees counterclockwise and mirror horizontally).
+ *   8: Rotate by 90 degrees counterclockwise.
+ *  For 5 to 8 width and height of the result are swapped. These
+ *  transformations are done in tiles, such that source and
+ *  destination lines stay in the cache.
+ *  @return the pixels of the transformed raster. The stride of the
+ *          result is its width.
+ *  @exception RANGE_ERROR If 'orientation' is not in the range 1 to 8
+ *             or if the area is not inside of the raster.
+ *  @exception MEMORY_ERROR Not enough memory to create the result.
+ */
+bstriType pxlTransform (const const_bstriType data, intType width,
+    intType height, intType stride, intType orientation)
+
+  {
+    const int32Type *srcPixels;
+    const int32Type *start;
+    intType xStep;
+    intType yStep;
+    memSizeType destWidth;
+    memSizeType destHeight;
+    memSizeType tileX;
+    memSizeType tileY;
+    memSizeType tileXEnd;
+    memSizeType tileYEnd;
+    memSizeType destX;
+    memSizeType destY;
+    const int32Type *srcPixel;
+    int32Type *destLine;
+    bstriType result;
+
+  /* pxlTransform */
+    logFunction(printf("pxlTransform(" FMT_U_MEM ", " FMT_D ", " FMT_D ", "
+                       FMT_D ", " FMT_D ")\n", (memSizeType) data,
+                       width, height, stride, orientation););
+    if (unlikely(orientation < 1 || orientation > 8 ||
+                 !areaOkay(data, stride, 0, 0, width, height))) {
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      if (orientation <= 4) {
+        result = allocPixels(width, height);
+        destWidth = (memSizeType) width;
+        destHeight = (memSizeType) height;
+      } else {
+        result = allocPixels(height, width);
+        destWidth = (memSizeType) height;
+        destHeight = (memSizeType) width;
+      } /* if */
+      if (result != NULL && width != 0 && height != 0) {
+        /* The source pixel of the destination pixel (x, y) is */
+        /* start[x * xStep + y * yStep].                       */
+        srcPixels = (const int32Type *) data->mem;
+        switch (orientation) {
+          case 1:
+            start = srcPixels;
+            xStep = 1;
+            yStep = stride;
+            break;
+          case 2:
+            start = &srcPixels[width - 1];
+            xStep = -1;
+            yStep = stride;
+            break;
+          case 3:
+            start = &srcPixels[(height - 1) * stride + width - 1];
+            xStep = -1;
+            yStep = -stride;
+            break;
+          case 4:
+            start = &srcPixels[(height - 1) * stride];
+            xStep = 1;
+            yStep = -stride;
+            break;
+          case 5:
+            start = srcPixels;
+            xStep = stride;
+            yStep = 1;
+            break;
+          case 6:
+            start = &srcPixels[(height - 1) * stride];
+            xStep = -stride;
+            yStep = 1;
+            break;
+          case 7:
+            start = &srcPixels[(height - 1) * stride + width - 1];
+            xStep = -stride;
+            yStep = -1;
+            break;
+          default: /* case 8 */
+            start = &srcPixels[width - 1];
+            xStep = stride;
+            yStep = -1;
+            break;
+        } /* switch */
+        destLine = (int32Type *) result->mem;
+        if (orientation <= 4) {
+          for (destY = 0; destY < destHeight; destY++) {
+            srcPixel = start + (intType) destY * yStep;
+            if (xStep == 1) {
+              memcpy(destLine, srcPixel, destWidth * sizeof(int32Type));
+            } else {
+              for (destX = 0; destX < destWidth; destX++) {
+                destLine[destX] = *(srcPixel - (intType) destX);
+              } /* for */
+            } /* if */
+            destLine += destWidth;
+          } /* for */
+        } else {
+          for (tileY = 0; tileY < destHeight; tileY += TRANSFORM_TILE_SIZE) {
+            tileYEnd = tileY + TRANSFORM_TILE_SIZE;
+            if (tileYEnd > destHeight) {
+              tileYEnd = destHeight;
+            } /* if */
+            for (tileX = 0; tileX < destWidth; tileX += TRANSFORM_TILE_SIZE) {
+              tileXEnd = tileX + TRANSFORM_TILE_SIZE;
+              if (tileXEnd > destWidth) {
+                tileXEnd = destWidth;
+              } /* if */
+              for (destY = tileY; destY < tileYEnd; destY++) {
+                destLine = &((int32Type *) result->mem)[destY * destWidth];
+                srcPixel = start + (intType) destY * yStep + (intType) tileX * xStep;
+                for (destX = tileX; destX < tileXEnd; destX++) {
+                  destLine[destX] = *srcPixel;
+                  srcPixel += xStep;
+                } /* for */
+              } /* for */
+            } /* for */
+          } /* for */
+        } /* if */
+      } /* if */
+    } /* if */
+    return result;
+  } /* pxlTransform */
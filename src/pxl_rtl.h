@@ -0,0 +1,90 @@
+/********************************************************************/
+/*                                                                  */
+/*  pxl_rtl.h     Primitive actions for packed pixel rasters.       */
+/*  Copyright (C) 2026  agent                                       */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/pxl_rtl.h                                       */
+/*  Changes: 2026  agent                                            */
+/*  Content: Primitive actions for packed pixel rasters.            */
+/*                                                                  */
+/********************************************************************/
+
+/* Formats of the bytes used by pxlSetPixels(). */
+/* The same values are defined in pixelraster.s7i. */
+#define PXL_GRAY_8   0
+#define PXL_GRAY_16  1
+#define PXL_RGB_24   2
+#define PXL_RGB_48   3
+#define PXL_BGR_24   4
+#define PXL_BGRX_32  5
+#define PXL_RGBA_32  6
+#define PXL_RGBA_64  7
+#define PXL_GRAY_ALPHA_16 8
+#define PXL_GRAY_ALPHA_32 9
+
+void pxlBlend (bstriType destData, intType destStride, intType destX,
+    intType destY, const const_bstriType srcData, intType srcStride,
+    intType srcX, intType srcY, intType width, intType height,
+    intType alpha);
+void pxlCrop (bstriType data, intType stride, intType xPos, intType yPos,
+    intType width, intType height);
+void pxlFill (bstriType data, intType stride, intType xPos, intType yPos,
+    intType width, intType height, intType pixel);
+bstriType pxlGetArea (const const_bstriType data, intType stride,
+    intType xPos, intType yPos, intType width, intType height);
+intType pxlGetPixel (const const_bstriType data, intType stride,
+    intType xPos, intType yPos);
+winType pxlGetPixmap (const const_bstriType data, intType width,
+    intType height, intType stride);
+bstriType pxlJpegCoefficients (intType width, intType height,
+    intType horizontal, intType vertical, intType numComponents);
+void pxlJpegDecodeScan (bstriType coefficients, const const_striType scanData,
+    const const_striType scanTables, intType width, intType height,
+    intType horizontal, intType vertical, intType startOfSpectral,
+    intType endOfSpectral, intType approximationHigh,
+    intType approximationLow, intType restartInterval);
+void pxlJpegToRaster (bstriType data, intType stride,
+    const const_bstriType coefficients, const const_striType quantization,
+    intType numComponents, intType width, intType height,
+    intType horizontal, intType vertical);
+bstriType pxlJpegToRgb (const const_bstriType coefficients,
+    const const_striType quantization, intType numComponents,
+    intType width, intType height, intType horizontal, intType vertical);
+bstriType pxlNew (intType width, intType height, intType pixel);
+bstriType pxlPixelsToRgb (const const_striType bytes, intType format);
+void pxlPngFilter (striType pixelData, intType height,
+    intType bytesPerScanline, intType bytesPerPixel);
+void pxlPngUnfilter (striType pixelData, intType height,
+    intType bytesPerScanline, intType bytesPerPixel);
+bstriType pxlScale (const const_bstriType data, intType width,
+    intType height, intType stride, intType newWidth, intType newHeight);
+void pxlSetIndexedPixels (bstriType data, intType stride, intType xPos,
+    intType yPos, intType count, const const_striType bytes,
+    intType bitsPerIndex, const const_bstriType palette,
+    intType paletteSize);
+void pxlSetPixel (bstriType data, intType stride, intType xPos,
+    intType yPos, intType pixel);
+void pxlSetPixels (bstriType data, intType stride, intType xPos,
+    intType yPos, const const_striType bytes, intType format);
+bstriType pxlTransform (const const_bstriType data, intType width,
+    intType height, intType stride, intType orientation);
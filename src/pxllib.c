@@ -0,0 +1,503 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  agent                                       */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/pxllib.c                                        */
+/*  Changes: 2026  agent                                            */
+/*  Content: All primitive actions for packed pixel rasters.        */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+
+#include "common.h"
+#include "data.h"
+#include "heaputl.h"
+#include "syvarutl.h"
+#include "objutl.h"
+#include "runerr.h"
+#include "pxl_rtl.h"
+
+#undef EXTERN
+#define EXTERN
+#include "pxllib.h"
+
+
+
+/**
+ *  Blend an area of the raster 'srcData' (arg_5) into the raster
+ *  'destData' (arg_1) with the opacity 'alpha' (arg_11).
+ *  @exception RANGE_ERROR If 'alpha' is not in the range 0 to 255 or
+ *             an area is not inside of its raster.
+ */
+objectType pxl_blend (listType arguments)
+
+  { /* pxl_blend */
+    isit_bstri(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    isit_int(arg_4(arguments));
+    isit_bstri(arg_5(arguments));
+    isit_int(arg_6(arguments));
+    isit_int(arg_7(arguments));
+    isit_int(arg_8(arguments));
+    isit_int(arg_9(arguments));
+    isit_int(arg_10(arguments));
+    isit_int(arg_11(arguments));
+    is_variable(arg_1(arguments));
+    pxlBlend(take_bstri(arg_1(arguments)), take_int(arg_2(arguments)),
+             take_int(arg_3(arguments)), take_int(arg_4(arguments)),
+             take_bstri(arg_5(arguments)), take_int(arg_6(arguments)),
+             take_int(arg_7(arguments)), take_int(arg_8(arguments)),
+             take_int(arg_9(arguments)), take_int(arg_10(arguments)),
+             take_int(arg_11(arguments)));
+    return SYS_EMPTY_OBJECT;
+  } /* pxl_blend */
+
+
+
+/**
+ *  Move an area of the raster 'data' (arg_1) to its start.
+ *  @exception RANGE_ERROR If the area is not inside of the raster.
+ */
+objectType pxl_crop (listType arguments)
+
+  { /* pxl_crop */
+    isit_bstri(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    isit_int(arg_4(arguments));
+    isit_int(arg_5(arguments));
+    isit_int(arg_6(arguments));
+    is_variable(arg_1(arguments));
+    pxlCrop(take_bstri(arg_1(arguments)), take_int(arg_2(arguments)),
+            take_int(arg_3(arguments)), take_int(arg_4(arguments)),
+            take_int(arg_5(arguments)), take_int(arg_6(arguments)));
+    return SYS_EMPTY_OBJECT;
+  } /* pxl_crop */
+
+
+
+/**
+ *  Set all pixels of an area of the raster 'data' (arg_1) to 'pixel' (arg_7).
+ *  @exception RANGE_ERROR If the area is not inside of the raster.
+ */
+objectType pxl_fill (listType arguments)
+
+  { /* pxl_fill */
+    isit_bstri(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    isit_int(arg_4(arguments));
+    isit_int(arg_5(arguments));
+    isit_int(arg_6(arguments));
+    isit_int(arg_7(arguments));
+    is_variable(arg_1(arguments));
+    pxlFill(take_bstri(arg_1(arguments)), take_int(arg_2(arguments)),
+            take_int(arg_3(arguments)), take_int(arg_4(arguments)),
+            take_int(arg_5(arguments)), take_int(arg_6(arguments)),
+            take_int(arg_7(arguments)));
+    return SYS_EMPTY_OBJECT;
+  } /* pxl_fill */
+
+
+
+/**
+ *  Copy an area of a raster to a new raster.
+ *  @return the pixels of the area with a stride of its width.
+ *  @exception RANGE_ERROR If the area is not inside of the raster.
+ *  @exception MEMORY_ERROR Not enough memory to create the result.
+ */
+objectType pxl_get_area (listType arguments)
+
+  { /* pxl_get_area */
+    isit_bstri(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    isit_int(arg_4(arguments));
+    isit_int(arg_5(arguments));
+    isit_int(arg_6(arguments));
+    return bld_bstri_temp(
+        pxlGetArea(take_bstri(arg_1(arguments)), take_int(arg_2(arguments)),
+                   take_int(arg_3(arguments)), take_int(arg_4(arguments)),
+                   take_int(arg_5(arguments)), take_int(arg_6(arguments))));
+  } /* pxl_get_area */
+
+
+
+/**
+ *  Get a pixel of a raster.
+ *  @exception RANGE_ERROR If the position is not inside of the raster.
+ */
+objectType pxl_get_pixel (listType arguments)
+
+  { /* pxl_get_pixel */
+    isit_bstri(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    isit_int(arg_4(arguments));
+    return bld_int_temp(
+        pxlGetPixel(take_bstri(arg_1(arguments)), take_int(arg_2(arguments)),
+                    take_int(arg_3(arguments)), take_int(arg_4(arguments))));
+  } /* pxl_get_pixel */
+
+
+
+/**
+ *  Create a new pixmap from the pixels of a raster.
+ *  @return the created pixmap.
+ *  @exception RANGE_ERROR If width or height are not positive or
+ *             if the area is not inside of the raster.
+ */
+objectType pxl_get_pixmap (listType arguments)
+
+  { /* pxl_get_pixmap */
+    isit_bstri(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    isit_int(arg_4(arguments));
+    return bld_win_temp(
+        pxlGetPixmap(take_bstri(arg_1(arguments)), take_int(arg_2(arguments)),
+                     take_int(arg_3(arguments)), take_int(arg_4(arguments))));
+  } /* pxl_get_pixmap */
+
+
+
+/**
+ *  Create zeroed coefficients for all blocks of a JPEG image with
+ *  'width' (arg_1), 'height' (arg_2), the luma sampling factors
+ *  'horizontal' (arg_3) and 'vertical' (arg_4) and 'numComponents'
+ *  (arg_5) components.
+ *  @return the coefficients of all blocks.
+ *  @exception RANGE_ERROR If a parameter is not in its allowed range.
+ *  @exception MEMORY_ERROR Not enough memory to create the result.
+ */
+objectType pxl_jpeg_coefficients (listType arguments)
+
+  { /* pxl_jpeg_coefficients */
+    isit_int(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    isit_int(arg_4(arguments));
+    isit_int(arg_5(arguments));
+    return bld_bstri_temp(
+        pxlJpegCoefficients(take_int(arg_1(arguments)), take_int(arg_2(arguments)),
+                            take_int(arg_3(arguments)), take_int(arg_4(arguments)),
+                            take_int(arg_5(arguments))));
+  } /* pxl_jpeg_coefficients */
+
+
+
+/**
+ *  Decode the entropy coded data 'scanData' (arg_2) of a JPEG scan
+ *  into 'coefficients' (arg_1).
+ *  @exception RANGE_ERROR If a parameter is not in its allowed range,
+ *             if a Huffman table is not valid or if the data is corrupt.
+ */
+objectType pxl_jpeg_decode_scan (listType arguments)
+
+  { /* pxl_jpeg_decode_scan */
+    isit_bstri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    isit_stri(arg_3(arguments));
+    isit_int(arg_4(arguments));
+    isit_int(arg_5(arguments));
+    isit_int(arg_6(arguments));
+    isit_int(arg_7(arguments));
+    isit_int(arg_8(arguments));
+    isit_int(arg_9(arguments));
+    isit_int(arg_10(arguments));
+    isit_int(arg_11(arguments));
+    isit_int(arg_12(arguments));
+    is_variable(arg_1(arguments));
+    pxlJpegDecodeScan(take_bstri(arg_1(arguments)), take_stri(arg_2(arguments)),
+                      take_stri(arg_3(arguments)), take_int(arg_4(arguments)),
+                      take_int(arg_5(arguments)), take_int(arg_6(arguments)),
+                      take_int(arg_7(arguments)), take_int(arg_8(arguments)),
+                      take_int(arg_9(arguments)), take_int(arg_10(arguments)),
+                      take_int(arg_11(arguments)), take_int(arg_12(arguments)));
+    return SYS_EMPTY_OBJECT;
+  } /* pxl_jpeg_decode_scan */
+
+
+
+/**
+ *  Convert the JPEG 'coefficients' (arg_3) to pixels of the raster
+ *  'data' (arg_1).
+ *  @exception RANGE_ERROR If a parameter is not in its allowed range,
+ *             if 'coefficients' is too short or if the area is not
+ *             inside of the raster.
+ */
+objectType pxl_jpeg_to_raster (listType arguments)
+
+  { /* pxl_jpeg_to_raster */
+    isit_bstri(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_bstri(arg_3(arguments));
+    isit_stri(arg_4(arguments));
+    isit_int(arg_5(arguments));
+    isit_int(arg_6(arguments));
+    isit_int(arg_7(arguments));
+    isit_int(arg_8(arguments));
+    isit_int(arg_9(arguments));
+    is_variable(arg_1(arguments));
+    pxlJpegToRaster(take_bstri(arg_1(arguments)), take_int(arg_2(arguments)),
+                    take_bstri(arg_3(arguments)), take_stri(arg_4(arguments)),
+                    take_int(arg_5(arguments)), take_int(arg_6(arguments)),
+                    take_int(arg_7(arguments)), take_int(arg_8(arguments)),
+                    take_int(arg_9(arguments)));
+    return SYS_EMPTY_OBJECT;
+  } /* pxl_jpeg_to_raster */
+
+
+
+/**
+ *  Convert the JPEG 'coefficients' (arg_1) to red, green and blue
+ *  bytes. This does the same computation as pxl_jpeg_to_raster.
+ *  @return the red, green and blue bytes of all pixels, line by line.
+ *  @exception RANGE_ERROR If a parameter is not in its allowed range
+ *             or if 'coefficients' is too short.
+ *  @exception MEMORY_ERROR Not enough memory to create the result.
+ */
+objectType pxl_jpeg_to_rgb (listType arguments)
+
+  { /* pxl_jpeg_to_rgb */
+    isit_bstri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    isit_int(arg_4(arguments));
+    isit_int(arg_5(arguments));
+    isit_int(arg_6(arguments));
+    isit_int(arg_7(arguments));
+    return bld_bstri_temp(
+        pxlJpegToRgb(take_bstri(arg_1(arguments)), take_stri(arg_2(arguments)),
+                     take_int(arg_3(arguments)), take_int(arg_4(arguments)),
+                     take_int(arg_5(arguments)), take_int(arg_6(arguments)),
+                     take_int(arg_7(arguments))));
+  } /* pxl_jpeg_to_rgb */
+
+
+
+/**
+ *  Create a raster with 'width' (arg_1) * 'height' (arg_2) pixels
+ *  set to 'pixel' (arg_3).
+ *  @return the pixels of the new raster.
+ *  @exception RANGE_ERROR If 'width' or 'height' are negative.
+ *  @exception MEMORY_ERROR Not enough memory to create the raster.
+ */
+objectType pxl_new (listType arguments)
+
+  { /* pxl_new */
+    isit_int(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    return bld_bstri_temp(
+        pxlNew(take_int(arg_1(arguments)), take_int(arg_2(arguments)),
+               take_int(arg_3(arguments))));
+  } /* pxl_new */
+
+
+
+/**
+ *  Convert 'bytes' (arg_1) with pixels in the given 'format' (arg_2)
+ *  to red, green and blue bytes. This does the same conversion as
+ *  pxl_set_pixels.
+ *  @return the red, green and blue bytes of the pixels.
+ *  @exception RANGE_ERROR If 'format' is unknown, if the length of
+ *             'bytes' is not a multiple of the pixel size or if a
+ *             character of 'bytes' is beyond '\255;'.
+ *  @exception MEMORY_ERROR Not enough memory to create the result.
+ */
+objectType pxl_pixels_to_rgb (listType arguments)
+
+  { /* pxl_pixels_to_rgb */
+    isit_stri(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    return bld_bstri_temp(
+        pxlPixelsToRgb(take_stri(arg_1(arguments)), take_int(arg_2(arguments))));
+  } /* pxl_pixels_to_rgb */
+
+
+
+/**
+ *  Apply PNG filters to the scanlines of 'pixelData' (arg_1).
+ *  @exception RANGE_ERROR If 'pixelData' is too short.
+ *  @exception MEMORY_ERROR Not enough memory for the filter buffers.
+ */
+objectType pxl_png_filter (listType arguments)
+
+  { /* pxl_png_filter */
+    isit_stri(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    isit_int(arg_4(arguments));
+    is_variable(arg_1(arguments));
+    pxlPngFilter(take_stri(arg_1(arguments)), take_int(arg_2(arguments)),
+                 take_int(arg_3(arguments)), take_int(arg_4(arguments)));
+    return SYS_EMPTY_OBJECT;
+  } /* pxl_png_filter */
+
+
+
+/**
+ *  Undo the PNG filters of the scanlines in 'pixelData' (arg_1).
+ *  @exception RANGE_ERROR If 'pixelData' is too short.
+ */
+objectType pxl_png_unfilter (listType arguments)
+
+  { /* pxl_png_unfilter */
+    isit_stri(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    isit_int(arg_4(arguments));
+    is_variable(arg_1(arguments));
+    pxlPngUnfilter(take_stri(arg_1(arguments)), take_int(arg_2(arguments)),
+                   take_int(arg_3(arguments)), take_int(arg_4(arguments)));
+    return SYS_EMPTY_OBJECT;
+  } /* pxl_png_unfilter */
+
+
+
+/**
+ *  Scale a raster to 'newWidth' (arg_5) * 'newHeight' (arg_6) pixels.
+ *  @return the pixels of the scaled raster.
+ *  @exception RANGE_ERROR If a size is negative or if the area is not
+ *             inside of the raster.
+ *  @exception MEMORY_ERROR Not enough memory to create the result.
+ */
+objectType pxl_scale (listType arguments)
+
+  { /* pxl_scale */
+    isit_bstri(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    isit_int(arg_4(arguments));
+    isit_int(arg_5(arguments));
+    isit_int(arg_6(arguments));
+    return bld_bstri_temp(
+        pxlScale(take_bstri(arg_1(arguments)), take_int(arg_2(arguments)),
+                 take_int(arg_3(arguments)), take_int(arg_4(arguments)),
+                 take_int(arg_5(arguments)), take_int(arg_6(arguments))));
+  } /* pxl_scale */
+
+
+
+/**
+ *  Convert palette indices from 'bytes' (arg_6) to pixels of the
+ *  raster 'data' (arg_1).
+ *  @exception RANGE_ERROR If 'bitsPerIndex' is not 1, 2, 4 or 8, if
+ *             the pixels do not fit into the line or if an index or a
+ *             character of 'bytes' is out of range.
+ */
+objectType pxl_set_indexed_pixels (listType arguments)
+
+  { /* pxl_set_indexed_pixels */
+    isit_bstri(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    isit_int(arg_4(arguments));
+    isit_int(arg_5(arguments));
+    isit_stri(arg_6(arguments));
+    isit_int(arg_7(arguments));
+    isit_bstri(arg_8(arguments));
+    isit_int(arg_9(arguments));
+    is_variable(arg_1(arguments));
+    pxlSetIndexedPixels(take_bstri(arg_1(arguments)), take_int(arg_2(arguments)),
+                        take_int(arg_3(arguments)), take_int(arg_4(arguments)),
+                        take_int(arg_5(arguments)), take_stri(arg_6(arguments)),
+                        take_int(arg_7(arguments)), take_bstri(arg_8(arguments)),
+                        take_int(arg_9(arguments)));
+    return SYS_EMPTY_OBJECT;
+  } /* pxl_set_indexed_pixels */
+
+
+
+/**
+ *  Set a pixel of the raster 'data' (arg_1).
+ *  @exception RANGE_ERROR If the position is not inside of the raster.
+ */
+objectType pxl_set_pixel (listType arguments)
+
+  { /* pxl_set_pixel */
+    isit_bstri(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    isit_int(arg_4(arguments));
+    isit_int(arg_5(arguments));
+    is_variable(arg_1(arguments));
+    pxlSetPixel(take_bstri(arg_1(arguments)), take_int(arg_2(arguments)),
+                take_int(arg_3(arguments)), take_int(arg_4(arguments)),
+                take_int(arg_5(arguments)));
+    return SYS_EMPTY_OBJECT;
+  } /* pxl_set_pixel */
+
+
+
+/**
+ *  Convert 'bytes' (arg_5) in the given 'format' (arg_6) to pixels
+ *  of the raster 'data' (arg_1).
+ *  @exception RANGE_ERROR If 'format' is unknown, if the pixels do
+ *             not fit into the line or if a character of 'bytes' is
+ *             beyond '\255;'.
+ */
+objectType pxl_set_pixels (listType arguments)
+
+  { /* pxl_set_pixels */
+    isit_bstri(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    isit_int(arg_4(arguments));
+    isit_stri(arg_5(arguments));
+    isit_int(arg_6(arguments));
+    is_variable(arg_1(arguments));
+    pxlSetPixels(take_bstri(arg_1(arguments)), take_int(arg_2(arguments)),
+                 take_int(arg_3(arguments)), take_int(arg_4(arguments)),
+                 take_stri(arg_5(arguments)), take_int(arg_6(arguments)));
+    return SYS_EMPTY_OBJECT;
+  } /* pxl_set_pixels */
+
+
+
+/**
+ *  Rotate and/or mirror a raster according to an Exif 'orientation' (arg_5).
+ *  @return the pixels of the transformed raster.
+ *  @exception RANGE_ERROR If 'orientation' is not in the range 1 to 8
+ *             or if the area is not inside of the raster.
+ *  @exception MEMORY_ERROR Not enough memory to create the result.
+ */
+objectType pxl_transform (listType arguments)
+
+  { /* pxl_transform */
+    isit_bstri(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    isit_int(arg_4(arguments));
+    isit_int(arg_5(arguments));
+    return bld_bstri_temp(
+        pxlTransform(take_bstri(arg_1(arguments)), take_int(arg_2(arguments)),
+                     take_int(arg_3(arguments)), take_int(arg_4(arguments)),
+                     take_int(arg_5(arguments))));
+  } /* pxl_transform */
@@ -0,0 +1,46 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  agent                                       */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/pxllib.h                                        */
+/*  Changes: 2026  agent                                            */
+/*  Content: All primitive actions for packed pixel rasters.        */
+/*                                                                  */
+/********************************************************************/
+
+objectType pxl_blend (listType arguments);
+objectType pxl_crop (listType arguments);
+objectType pxl_fill (listType arguments);
+objectType pxl_get_area (listType arguments);
+objectType pxl_get_pixel (listType arguments);
+objectType pxl_get_pixmap (listType arguments);
+objectType pxl_jpeg_coefficients (listType arguments);
+objectType pxl_jpeg_decode_scan (listType arguments);
+objectType pxl_jpeg_to_raster (listType arguments);
+objectType pxl_jpeg_to_rgb (listType arguments);
+objectType pxl_new (listType arguments);
+objectType pxl_pixels_to_rgb (listType arguments);
+objectType pxl_png_filter (listType arguments);
+objectType pxl_png_unfilter (listType arguments);
+objectType pxl_scale (listType arguments);
+objectType pxl_set_indexed_pixels (listType arguments);
+objectType pxl_set_pixel (listType arguments);
+objectType pxl_set_pixels (listType arguments);
+objectType pxl_transform (listType arguments);
@@ -114,6 +114,9 @@ static void writeHelp (void)
     printf("  -i   Show the identifier table after the analysis phase.\n");
     printf("  -l   Add a directory to the include library search path (e.g.: -l ../lib).\n");
     printf("  -p   Specify a protocol file, for trace output (e.g.: -p prot.txt).\n");
+    printf("  -P   Profile the execution with a sampling profiler. The folded stacks\n");
+    printf("       are written to profile_folded (use it with flamegraph tools) and\n");
+    printf("       the time spent in each function is written to profile_out.\n");
     printf("  -q   Compile quiet. Line and file information and compilation\n");
     printf("       statistics are suppressed.\n");
     printf("  -s   Deactivate signal handlers.\n");
@@ -125,6 +128,8 @@ static void writeHelp (void)
     printf("         h Trace heap size (in combination with 'a')\n");
     printf("         s Trace signals\n");
     printf("  -t   Equivalent to -ta\n");
+    printf("  -T   Execute the bodies of functions as threaded code. A body is\n");
+    printf("       lowered to threaded code when it is called the first time.\n");
     printf("  -vn  Set verbosity level of analysis phase to n. Where n is one of:\n");
     printf("         0 Compile quiet (equivalent to -q)\n");
     printf("         1 Write just the header with version information (default)\n");
@@ -249,6 +254,12 @@ static void processOptions (rtlArrayType arg_v, const optionType option)
                 opt = NULL;
               } /* if */
               break;
+            case 'P':
+              option->execOptions |= PROFILE_EXECUTION;
+              break;
+            case 'T':
+              option->execOptions |= THREADED_CODE;
+              break;
             case 'q':
               verbosity_level = 0;
               break;
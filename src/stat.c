@@ -46,7 +46,7 @@ static clock_t start_time;
 
 
 
-void show_statistic (void)
+void show_statistic (const_progType aProg)
 
   {
 #if WITH_COMPILATION_INFO
@@ -75,6 +75,15 @@ void show_statistic (void)
       printf("%6lu lines per second\n",
           (total_lines * 1000) / msecs_total);
     } /* if */
+    printf("%6lu identifiers in a hash table of %lu entries\n",
+        (unsigned long) aProg->ident.number_of_idents,
+        (unsigned long) aProg->ident.table_size);
+    printf("%6lu identifier lookups\n", ident_lookups);
+    if (ident_lookups != 0) {
+      printf("%3lu.%02lu identifier table probes per lookup\n",
+          (ident_lookups + ident_probes) / ident_lookups,
+          ((ident_lookups + ident_probes) * 100 / ident_lookups) % 100);
+    } /* if */
 #endif
 #if WITH_STATISTIC
     printf("%6d literals\n", literal_count);
@@ -97,6 +106,8 @@ void reset_statistic (void)
   { /* reset_statistic */
 #if WITH_COMPILATION_INFO
     total_lines = 0;
+    ident_lookups = 0;
+    ident_probes = 0;
 #endif
 #if WITH_STATISTIC
     literal_count = 0;
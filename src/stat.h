@@ -27,6 +27,8 @@
 
 #if WITH_COMPILATION_INFO
 EXTERN unsigned long total_lines;
+EXTERN unsigned long ident_lookups;
+EXTERN unsigned long ident_probes;
 #endif
 #if WITH_STATISTIC
 EXTERN unsigned int literal_count;
@@ -35,5 +37,5 @@ EXTERN unsigned int comment_count;
 #endif
 
 
-void show_statistic (void);
+void show_statistic (const_progType aProg);
 void reset_statistic (void);
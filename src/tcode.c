@@ -0,0 +1,807 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  agent                                       */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Interpreter                                             */
+/*  File: seed7/src/tcode.c                                         */
+/*  Changes: 2026  agent                                            */
+/*  Content: Threaded code for the bodies of interpreted functions. */
+/*                                                                  */
+/*  The body of a function is lowered to threaded code when it is   */
+/*  executed for the first time. Every node of the body becomes an  */
+/*  instruction with a pointer to its handler function. The kind of */
+/*  a node (variable, constant, primitive action, call of a Seed7   */
+/*  function) is decided once, when the body is lowered. Actions    */
+/*  and blocks are resolved to direct pointers. The arguments of an */
+/*  instruction are stored in a contiguous array of instructions.   */
+/*  The loop and if-statements of seed7_05.s7i are executed by own  */
+/*  handlers, which call their call-by-name code directly. Other    */
+/*  nodes are executed by the tree walker of exec.c.                */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+
+#include "common.h"
+#include "data.h"
+#include "heaputl.h"
+#include "flistutl.h"
+#include "syvarutl.h"
+#include "traceutl.h"
+#include "executl.h"
+#include "objutl.h"
+#include "runerr.h"
+#include "exec.h"
+#include "prclib.h"
+#include "profutl.h"
+
+#undef EXTERN
+#define EXTERN
+#define DO_INIT
+#include "tcode.h"
+
+
+typedef struct {
+    tcodeType code;
+    memSizeType used;
+  } lowerStateRecord, *lowerStateType;
+
+
+
+/**
+ *  Execute a call-by-name parameter of a loop or if-statement.
+ *  When the parameter was lowered its threaded code is executed.
+ *  Otherwise the evaluated argument is executed with evaluate().
+ */
+#define tcEvaluate(code, argument) \
+    ((code) != NULL ? (code)->handler(code) : evaluate(argument))
+
+
+
+static objectType tcConst (const_tcodeType instr)
+
+  { /* tcConst */
+    return instr->object;
+  } /* tcConst */
+
+
+
+static objectType tcVariable (const_tcodeType instr)
+
+  {
+    objectType value;
+
+  /* tcVariable */
+    value = instr->object->value.objValue;
+    if (value != NULL) {
+      return value;
+    } else {
+      return instr->object;
+    } /* if */
+  } /* tcVariable */
+
+
+
+/**
+ *  Execute a call, that was not lowered, with the tree walker.
+ */
+static objectType tcWalkCall (const_tcodeType instr)
+
+  { /* tcWalkCall */
+    return exec_call(instr->object);
+  } /* tcWalkCall */
+
+
+
+/**
+ *  Evaluate the arguments of a call into argList.
+ *  This corresponds to eval_arg_list() of exec.c, but the list
+ *  elements are provided by the caller.
+ *  @return the number of evaluated arguments.
+ */
+static inline memSizeType tcEvalArgs (const_tcodeType instr,
+    listRecord *argList, uint32Type *temp_bits_ptr)
+
+  {
+    const_tcodeType arg;
+    objectType evaluated_object;
+    uint32Type temp_bits = 0;
+    memSizeType num_evaluated = 0;
+
+  /* tcEvalArgs */
+    arg = instr->args;
+    while (num_evaluated < instr->numArgs && !fail_flag) {
+      evaluated_object = arg->handler(arg);
+      argList[num_evaluated].obj = evaluated_object;
+      argList[num_evaluated].next = &argList[num_evaluated + 1];
+      if (evaluated_object != NULL && TEMP_OBJECT(evaluated_object)) {
+        temp_bits |= (uint32Type) 1 << num_evaluated;
+      } /* if */
+      arg++;
+      num_evaluated++;
+    } /* while */
+    if (num_evaluated != 0) {
+      argList[num_evaluated - 1].next = NULL;
+    } /* if */
+    *temp_bits_ptr = temp_bits;
+    return num_evaluated;
+  } /* tcEvalArgs */
+
+
+
+static void tcDumpArgs (listRecord *argList, memSizeType num_evaluated,
+    uint32Type temp_bits)
+
+  {
+    memSizeType pos;
+
+  /* tcDumpArgs */
+    for (pos = 0; temp_bits != 0 && pos < num_evaluated; pos++) {
+      if (temp_bits & 1 && argList[pos].obj != NULL &&
+          TEMP_OBJECT(argList[pos].obj)) {
+        dump_any_temp(argList[pos].obj);
+      } /* if */
+      temp_bits >>= 1;
+    } /* for */
+  } /* tcDumpArgs */
+
+
+
+/**
+ *  Evaluate the arguments of an action and prepare its execution.
+ *  Signals and exceptions are handled like in exec_action().
+ *  The previous curr_argument_list is saved in backup_argument_list.
+ *  It is restored with tcLeaveAction() or if an exception was raised.
+ *  @return FALSE if an exception was raised, TRUE otherwise.
+ */
+static inline boolType tcEnterAction (const_tcodeType instr,
+    listRecord *argList, memSizeType *num_evaluated, uint32Type *temp_bits,
+    listType *backup_argument_list)
+
+  { /* tcEnterAction */
+    *backup_argument_list = curr_argument_list;
+    *num_evaluated = tcEvalArgs(instr, argList, temp_bits);
+    if (interrupt_flag) {
+      if (!fail_flag) {
+        curr_exec_object = instr->object;
+        curr_argument_list = *num_evaluated != 0 ? argList : NULL;
+        show_signal();
+      } /* if */
+      if (fail_flag) {
+        tcDumpArgs(argList, *num_evaluated, *temp_bits);
+        curr_argument_list = *backup_argument_list;
+        return FALSE;
+      } /* if */
+    } /* if */
+    curr_exec_object = instr->object;
+    curr_argument_list = *num_evaluated != 0 ? argList : NULL;
+    return TRUE;
+  } /* tcEnterAction */
+
+
+
+/**
+ *  Finish the execution of an action that was started with tcEnterAction().
+ *  This is done on the normal path and after an exception was raised.
+ *  The evaluated arguments do not outlive the action, therefore
+ *  curr_argument_list is restored like in exec_action().
+ */
+static inline void tcLeaveAction (listRecord *argList,
+    memSizeType num_evaluated, uint32Type temp_bits,
+    listType backup_argument_list)
+
+  { /* tcLeaveAction */
+    tcDumpArgs(argList, num_evaluated, temp_bits);
+    curr_argument_list = backup_argument_list;
+  } /* tcLeaveAction */
+
+
+
+static objectType tcAction (const_tcodeType instr)
+
+  {
+    listRecord argList[TC_MAX_ARGS];
+    memSizeType num_evaluated;
+    uint32Type temp_bits;
+    listType backup_argument_list;
+    objectType result;
+
+  /* tcAction */
+#if CHECK_STACK
+    if (checkStack(FALSE)) {
+      return raise_with_arguments(SYS_MEM_EXCEPTION,
+                                  instr->object->value.listValue->next);
+    } /* if */
+#endif
+    if (unlikely(trace.actions || trace.check_actions)) {
+      return exec_call(instr->object);
+    } /* if */
+    if (unlikely(!tcEnterAction(instr, argList, &num_evaluated, &temp_bits,
+                                &backup_argument_list))) {
+      return fail_value;
+    } /* if */
+    profEnter(instr->subroutine);
+    result = instr->action(num_evaluated != 0 ? argList : NULL);
+    profLeave();
+    if (result != NULL && result->type_of == NULL) {
+      result->type_of = instr->subroutine->type_of->result_type;
+    } /* if */
+    tcLeaveAction(argList, num_evaluated, temp_bits, backup_argument_list);
+    return result;
+  } /* tcAction */
+
+
+
+/**
+ *  Threaded code version of prc_if().
+ */
+static objectType tcIf (const_tcodeType instr)
+
+  {
+    listRecord argList[TC_MAX_ARGS];
+    memSizeType num_evaluated;
+    uint32Type temp_bits;
+    listType backup_argument_list;
+    listType arguments = argList;
+    objectType condition;
+
+  /* tcIf */
+    if (unlikely(!tcEnterAction(instr, argList, &num_evaluated, &temp_bits,
+                                &backup_argument_list))) {
+      return fail_value;
+    } /* if */
+    isit_bool(arg_2(arguments));
+    condition = take_bool(arg_2(arguments));
+    if (condition == SYS_TRUE_OBJECT) {
+      tcEvaluate(instr->byName[0], arg_4(arguments));
+    } /* if */
+    tcLeaveAction(argList, num_evaluated, temp_bits, backup_argument_list);
+    return SYS_EMPTY_OBJECT;
+  } /* tcIf */
+
+
+
+/**
+ *  Threaded code version of prc_if_elsif().
+ */
+static objectType tcIfElsif (const_tcodeType instr)
+
+  {
+    listRecord argList[TC_MAX_ARGS];
+    memSizeType num_evaluated;
+    uint32Type temp_bits;
+    listType backup_argument_list;
+    listType arguments = argList;
+    objectType condition;
+
+  /* tcIfElsif */
+    if (unlikely(!tcEnterAction(instr, argList, &num_evaluated, &temp_bits,
+                                &backup_argument_list))) {
+      return fail_value;
+    } /* if */
+    isit_bool(arg_2(arguments));
+    condition = take_bool(arg_2(arguments));
+    if (condition == SYS_TRUE_OBJECT) {
+      tcEvaluate(instr->byName[0], arg_4(arguments));
+    } else {
+      tcEvaluate(instr->byName[1], arg_5(arguments));
+    } /* if */
+    tcLeaveAction(argList, num_evaluated, temp_bits, backup_argument_list);
+    return SYS_EMPTY_OBJECT;
+  } /* tcIfElsif */
+
+
+
+/**
+ *  Threaded code version of prc_if_noop().
+ */
+static objectType tcIfNoop (const_tcodeType instr)
+
+  {
+    listRecord argList[TC_MAX_ARGS];
+    memSizeType num_evaluated;
+    uint32Type temp_bits;
+    listType backup_argument_list;
+    listType arguments = argList;
+    objectType condition;
+
+  /* tcIfNoop */
+    if (unlikely(!tcEnterAction(instr, argList, &num_evaluated, &temp_bits,
+                                &backup_argument_list))) {
+      return fail_value;
+    } /* if */
+    isit_bool(arg_2(arguments));
+    condition = take_bool(arg_2(arguments));
+    if (condition != SYS_TRUE_OBJECT) {
+      tcEvaluate(instr->byName[0], arg_4(arguments));
+    } /* if */
+    tcLeaveAction(argList, num_evaluated, temp_bits, backup_argument_list);
+    return SYS_EMPTY_OBJECT;
+  } /* tcIfNoop */
+
+
+
+/**
+ *  Evaluate the condition of a loop.
+ *  @param negate TRUE for the until condition of a repeat-loop.
+ *  @return TRUE if the loop should continue, FALSE otherwise.
+ */
+static inline boolType tcLoopCondition (const_tcodeType code,
+    objectType condition, boolType negate)
+
+  {
+    objectType cond_value;
+    boolType cond = FALSE;
+
+  /* tcLoopCondition */
+    cond_value = tcEvaluate(code, condition);
+    if (likely(!fail_flag)) {
+      if (unlikely(take_bool(cond_value) != SYS_TRUE_OBJECT &&
+                   take_bool(cond_value) != SYS_FALSE_OBJECT)) {
+        category_required(ENUMLITERALOBJECT, cond_value);
+      } else {
+        cond = (boolType) ((take_bool(cond_value) == SYS_TRUE_OBJECT) != negate);
+        if (TEMP_OBJECT(cond_value) &&
+            (CATEGORY_OF_OBJ(cond_value) == CONSTENUMOBJECT ||
+             CATEGORY_OF_OBJ(cond_value) == VARENUMOBJECT)) {
+          FREE_OBJECT(cond_value);
+        } /* if */
+      } /* if */
+    } /* if */
+    return cond;
+  } /* tcLoopCondition */
+
+
+
+/**
+ *  Threaded code version of prc_while().
+ */
+static objectType tcWhile (const_tcodeType instr)
+
+  {
+    listRecord argList[TC_MAX_ARGS];
+    memSizeType num_evaluated;
+    uint32Type temp_bits;
+    listType backup_argument_list;
+    listType arguments = argList;
+    objectType condition;
+    objectType statement;
+
+  /* tcWhile */
+    if (unlikely(!tcEnterAction(instr, argList, &num_evaluated, &temp_bits,
+                                &backup_argument_list))) {
+      return fail_value;
+    } /* if */
+    condition = arg_2(arguments);
+    statement = arg_4(arguments);
+    while (tcLoopCondition(instr->byName[0], condition, FALSE)) {
+      tcEvaluate(instr->byName[1], statement);
+      if (unlikely(fail_flag)) {
+        break;
+      } /* if */
+    } /* while */
+    tcLeaveAction(argList, num_evaluated, temp_bits, backup_argument_list);
+    return SYS_EMPTY_OBJECT;
+  } /* tcWhile */
+
+
+
+/**
+ *  Threaded code version of prc_repeat().
+ */
+static objectType tcRepeat (const_tcodeType instr)
+
+  {
+    listRecord argList[TC_MAX_ARGS];
+    memSizeType num_evaluated;
+    uint32Type temp_bits;
+    listType backup_argument_list;
+    listType arguments = argList;
+    objectType statement;
+    objectType condition;
+    boolType cond;
+
+  /* tcRepeat */
+    if (unlikely(!tcEnterAction(instr, argList, &num_evaluated, &temp_bits,
+                                &backup_argument_list))) {
+      return fail_value;
+    } /* if */
+    statement = arg_2(arguments);
+    condition = arg_4(arguments);
+    do {
+      tcEvaluate(instr->byName[0], statement);
+      cond = !fail_flag &&
+             tcLoopCondition(instr->byName[1], condition, TRUE);
+    } while (cond);
+    tcLeaveAction(argList, num_evaluated, temp_bits, backup_argument_list);
+    return SYS_EMPTY_OBJECT;
+  } /* tcRepeat */
+
+
+
+/**
+ *  Threaded code version of prc_for_to() and prc_for_downto().
+ */
+static objectType tcForStep (const_tcodeType instr, intType step)
+
+  {
+    listRecord argList[TC_MAX_ARGS];
+    memSizeType num_evaluated;
+    uint32Type temp_bits;
+    listType backup_argument_list;
+    listType arguments = argList;
+    objectType for_variable;
+    intType start_value;
+    intType end_value;
+    objectType statement;
+    objectType result = SYS_EMPTY_OBJECT;
+
+  /* tcForStep */
+    if (unlikely(!tcEnterAction(instr, argList, &num_evaluated, &temp_bits,
+                                &backup_argument_list))) {
+      return fail_value;
+    } /* if */
+    for_variable = arg_2(arguments);
+    is_variable(for_variable);
+    isit_int(for_variable);
+    isit_int(arg_4(arguments));
+    isit_int(arg_6(arguments));
+    start_value = take_int(arg_4(arguments));
+    end_value = take_int(arg_6(arguments));
+    statement = arg_8(arguments);
+    if (unlikely(end_value == (step > 0 ? INTTYPE_MAX : INTTYPE_MIN))) {
+      logError(printf("tcForStep(var1, " FMT_D ", " FMT_D "): "
+                      "Limit of integer.%s not allowed.\n",
+                      start_value, end_value, step > 0 ? "last" : "first"););
+      result = raise_exception(SYS_RNG_EXCEPTION);
+    } else {
+      for_variable->value.intValue = start_value;
+      while ((step > 0 ? take_int(for_variable) <= end_value :
+                         take_int(for_variable) >= end_value) && !fail_flag) {
+        tcEvaluate(instr->byName[0], statement);
+        if (!fail_flag) {
+          for_variable->value.intValue += step;
+        } /* if */
+      } /* while */
+    } /* if */
+    tcLeaveAction(argList, num_evaluated, temp_bits, backup_argument_list);
+    return result;
+  } /* tcForStep */
+
+
+
+static objectType tcForTo (const_tcodeType instr)
+
+  { /* tcForTo */
+    return tcForStep(instr, 1);
+  } /* tcForTo */
+
+
+
+static objectType tcForDownto (const_tcodeType instr)
+
+  { /* tcForDownto */
+    return tcForStep(instr, -1);
+  } /* tcForDownto */
+
+
+
+/**
+ *  Call a Seed7 function, whose arguments are evaluated by threaded code.
+ */
+static objectType tcLambda (const_tcodeType instr)
+
+  {
+    listRecord argList[TC_MAX_ARGS];
+    memSizeType num_evaluated;
+    uint32Type temp_bits;
+
+  /* tcLambda */
+    num_evaluated = tcEvalArgs(instr, argList, &temp_bits);
+    if (unlikely(fail_flag)) {
+      tcDumpArgs(argList, num_evaluated, temp_bits);
+      return fail_value;
+    } else {
+      return exec_evaluated_call(instr->subroutine->value.blockValue,
+          instr->object->value.listValue->next,
+          num_evaluated != 0 ? argList : NULL, instr->object);
+    } /* if */
+  } /* tcLambda */
+
+
+
+static tcodeType reserveInstr (lowerStateType state, memSizeType numInstr)
+
+  {
+    tcodeType reserved;
+
+  /* reserveInstr */
+    if (state->code == NULL) {
+      reserved = NULL;
+    } else {
+      reserved = &state->code[state->used];
+    } /* if */
+    state->used += numInstr;
+    return reserved;
+  } /* reserveInstr */
+
+
+
+static void lowerCall (lowerStateType state, objectType callObject,
+    tcodeType instr);
+
+
+
+/**
+ *  Lower an object that is evaluated with exec_object().
+ *  When state->code is NULL the instructions are just counted.
+ */
+static void lowerValue (lowerStateType state, objectType anObject,
+    tcodeType instr)
+
+  { /* lowerValue */
+    switch (CATEGORY_OF_OBJ(anObject)) {
+      case CALLOBJECT:
+        lowerCall(state, anObject, instr);
+        break;
+      case VALUEPARAMOBJECT:
+      case REFPARAMOBJECT:
+      case RESULTOBJECT:
+      case LOCALVOBJECT:
+        if (instr != NULL) {
+          instr->handler = tcVariable;
+          instr->object = anObject;
+        } /* if */
+        break;
+      default:
+        if (instr != NULL) {
+          instr->handler = tcConst;
+          instr->object = anObject;
+        } /* if */
+        break;
+    } /* switch */
+  } /* lowerValue */
+
+
+
+/**
+ *  Lower a call-by-name argument of a loop or if-statement.
+ *  Only arguments that are executed with exec_call() are lowered.
+ *  For other arguments the handler uses evaluate() at run-time.
+ */
+static void lowerByName (lowerStateType state, objectType argument,
+    tcodeType *code)
+
+  {
+    tcodeType instr;
+
+  /* lowerByName */
+    if (CATEGORY_OF_OBJ(argument) == MATCHOBJECT &&
+        argument->value.listValue != NULL) {
+      instr = reserveInstr(state, 1);
+      lowerCall(state, argument, instr);
+    } else {
+      instr = NULL;
+    } /* if */
+    if (state->code != NULL) {
+      *code = instr;
+    } /* if */
+  } /* lowerByName */
+
+
+
+static tcHandlerType actionHandler (actType action, memSizeType numArgs,
+    unsigned int byNamePos[2])
+
+  {
+    tcHandlerType handler = tcAction;
+
+  /* actionHandler */
+    byNamePos[0] = 0;
+    byNamePos[1] = 0;
+    if (action == prc_if && numArgs >= 4) {
+      handler = tcIf;
+      byNamePos[0] = 4;
+    } else if (action == prc_if_elsif && numArgs >= 5) {
+      handler = tcIfElsif;
+      byNamePos[0] = 4;
+      byNamePos[1] = 5;
+    } else if (action == prc_if_noop && numArgs >= 4) {
+      handler = tcIfNoop;
+      byNamePos[0] = 4;
+    } else if (action == prc_while && numArgs >= 4) {
+      handler = tcWhile;
+      byNamePos[0] = 2;
+      byNamePos[1] = 4;
+    } else if (action == prc_repeat && numArgs >= 4) {
+      handler = tcRepeat;
+      byNamePos[0] = 2;
+      byNamePos[1] = 4;
+    } else if (action == prc_for_to && numArgs >= 8) {
+      handler = tcForTo;
+      byNamePos[0] = 8;
+    } else if (action == prc_for_downto && numArgs >= 8) {
+      handler = tcForDownto;
+      byNamePos[0] = 8;
+    } /* if */
+    return handler;
+  } /* actionHandler */
+
+
+
+/**
+ *  Lower an object that is executed with exec_call().
+ *  Calls of actions and Seed7 functions are lowered. All other
+ *  calls (e.g.: calls of forward declared functions) use the tree
+ *  walker, since their category might change later.
+ */
+static void lowerCall (lowerStateType state, objectType callObject,
+    tcodeType instr)
+
+  {
+    objectType subroutine;
+    listType actualParam;
+    memSizeType numArgs = 0;
+    tcHandlerType handler;
+    unsigned int byNamePos[2] = {0, 0};
+    tcodeType args;
+    memSizeType pos;
+
+  /* lowerCall */
+    subroutine = callObject->value.listValue->obj;
+    for (actualParam = callObject->value.listValue->next; actualParam != NULL;
+         actualParam = actualParam->next) {
+      numArgs++;
+    } /* for */
+    if (numArgs > TC_MAX_ARGS) {
+      handler = tcWalkCall;
+    } else if (CATEGORY_OF_OBJ(subroutine) == ACTOBJECT) {
+      handler = actionHandler(subroutine->value.actValue, numArgs, byNamePos);
+    } else if (CATEGORY_OF_OBJ(subroutine) == BLOCKOBJECT) {
+      handler = tcLambda;
+    } else {
+      handler = tcWalkCall;
+    } /* if */
+    if (instr != NULL) {
+      instr->handler = handler;
+      instr->object = callObject;
+      instr->subroutine = subroutine;
+    } /* if */
+    if (handler != tcWalkCall) {
+      args = reserveInstr(state, numArgs);
+      if (instr != NULL) {
+        if (handler != tcLambda) {
+          instr->action = subroutine->value.actValue;
+        } /* if */
+        instr->numArgs = numArgs;
+        instr->args = args;
+      } /* if */
+      actualParam = callObject->value.listValue->next;
+      for (pos = 0; pos < numArgs; pos++) {
+        lowerValue(state, actualParam->obj, args != NULL ? &args[pos] : NULL);
+        actualParam = actualParam->next;
+      } /* for */
+      for (pos = 0; pos < 2; pos++) {
+        if (byNamePos[pos] != 0) {
+          actualParam = callObject->value.listValue->next;
+          while (--byNamePos[pos] != 0) {
+            actualParam = actualParam->next;
+          } /* while */
+          lowerByName(state, actualParam->obj,
+                      instr != NULL ? &instr->byName[pos] : NULL);
+        } /* if */
+      } /* for */
+    } /* if */
+  } /* lowerCall */
+
+
+
+static memSizeType countInstr (const_tcodeType code)
+
+  {
+    memSizeType pos;
+    memSizeType count = 1;
+
+  /* countInstr */
+    if (code->handler != tcWalkCall) {
+      for (pos = 0; pos < code->numArgs; pos++) {
+        count += countInstr(&code->args[pos]);
+      } /* for */
+    } /* if */
+    for (pos = 0; pos < 2; pos++) {
+      if (code->byName[pos] != NULL) {
+        count += countInstr(code->byName[pos]);
+      } /* if */
+    } /* for */
+    return count;
+  } /* countInstr */
+
+
+
+/**
+ *  Lower the body of a function to threaded code.
+ *  @return the threaded code or NULL if there is not enough memory.
+ */
+static tcodeType lowerBody (objectType body)
+
+  {
+    lowerStateRecord state;
+    tcodeType code;
+
+  /* lowerBody */
+    logFunction(printf("lowerBody(" FMT_U_MEM ")\n", (memSizeType) body););
+    state.code = NULL;
+    state.used = 1;
+    lowerCall(&state, body, NULL);
+    if (unlikely(!ALLOC_TABLE(code, tcInstrRecord, state.used))) {
+      code = NULL;
+    } else {
+      memset(code, 0, state.used * sizeof(tcInstrRecord));
+      state.code = code;
+      state.used = 1;
+      lowerCall(&state, body, code);
+    } /* if */
+    logFunction(printf("lowerBody --> " FMT_U_MEM " (" FMT_U_MEM
+                       " instructions)\n", (memSizeType) code, state.used););
+    return code;
+  } /* lowerBody */
+
+
+
+/**
+ *  Execute the body of a function with threaded code.
+ *  The body is lowered when it is executed for the first time.
+ *  If the body cannot be lowered it is executed with exec_call().
+ */
+objectType tcExecBody (blockType block)
+
+  {
+    tcodeType code;
+
+  /* tcExecBody */
+    code = block->tcode;
+    if (unlikely(code == NULL)) {
+      if (block->body == NULL ||
+          (CATEGORY_OF_OBJ(block->body) != CALLOBJECT &&
+           CATEGORY_OF_OBJ(block->body) != MATCHOBJECT) ||
+          block->body->value.listValue == NULL ||
+          (code = lowerBody(block->body)) == NULL) {
+        return exec_call(block->body);
+      } /* if */
+      block->tcode = code;
+    } /* if */
+    return code->handler(code);
+  } /* tcExecBody */
+
+
+
+void tcFree (tcodeType code)
+
+  { /* tcFree */
+    if (code != NULL) {
+      FREE_TABLE(code, tcInstrRecord, countInstr(code));
+    } /* if */
+  } /* tcFree */
@@ -0,0 +1,51 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  agent                                       */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Interpreter                                             */
+/*  File: seed7/src/tcode.h                                         */
+/*  Changes: 2026  agent                                            */
+/*  Content: Threaded code for the bodies of interpreted functions. */
+/*                                                                  */
+/********************************************************************/
+
+/* Calls with more arguments are executed by the tree walker. */
+#define TC_MAX_ARGS 10
+
+typedef objectType (*tcHandlerType) (const_tcodeType instr);
+
+typedef struct tcInstrStruct {
+    tcHandlerType handler;
+    objectType object;
+    objectType subroutine;
+    actType action;
+    memSizeType numArgs;
+    tcodeType args;
+    tcodeType byName[2];
+  } tcInstrRecord;
+
+#ifdef DO_INIT
+boolType tc_active = FALSE;
+#else
+EXTERN boolType tc_active;
+#endif
+
+
+objectType tcExecBody (blockType block);
+void tcFree (tcodeType code);
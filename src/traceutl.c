@@ -1305,8 +1305,7 @@ static void list_ident_names (const_identType anyident)
 
   { /* list_ident_names */
     logFunction(printf("list_ident_names\n"););
-    if (anyident != NULL) {
-      list_ident_names(anyident->next1);
+    while (anyident != NULL) {
       if (anyident->entity != NULL) {
         if (anyident->entity->data.owner != NULL) {
           prot_cstri8(id_string(anyident));
@@ -1315,8 +1314,8 @@ static void list_ident_names (const_identType anyident)
           prot_nl();
         } /* if */
       } /* if */
-      list_ident_names(anyident->next2);
-    } /* if */
+      anyident = anyident->next;
+    } /* while */
     logFunction(printf("list_ident_names -->\n"););
   } /* list_ident_names */
 
@@ -1477,7 +1476,7 @@ static void list_node_names (const_nodeType anynode, char *buffer)
 void trace_nodes (void)
 
   {
-    int position;
+    memSizeType position;
     int character;
     char buffer[NODE_NAME_LEN_MAX + NULL_TERMINATION_LEN];
 
@@ -1485,7 +1484,7 @@ void trace_nodes (void)
     logFunction(printf("trace_nodes\n"););
     prot_cstri("Names declared:");
     prot_nl();
-    for (position = 0; position < ID_TABLE_SIZE; position++) {
+    for (position = 0; position < prog->ident.table_size; position++) {
       list_ident_names(prog->ident.table[position]);
     } /* for */
     for (character = (int) '!'; character <= (int) '~'; character++) {
@@ -417,6 +417,9 @@ void showCapabilities (const char *const terminal_name)
     printFlagCap("xs", ceol_standout_glitch);
     printStriCap("AL", parm_insert_line);
     printStriCap("DL", parm_delete_line);
+    printStriCap("cs", change_scroll_region);
+    printStriCap("sf", scroll_forward);
+    printStriCap("sr", scroll_reverse);
     printStriCap("ke", keypad_local);
     printStriCap("ks", keypad_xmit);
     printStriCap("kb", key_backspace);
@@ -573,6 +576,9 @@ int getcaps (void)
           ceol_standout_glitch = tgetflag("xs");
           parm_insert_line =      tgetstr("AL", &area);
           parm_delete_line =      tgetstr("DL", &area);
+          change_scroll_region =  tgetstr("cs", &area);
+          scroll_forward =        tgetstr("sf", &area);
+          scroll_reverse =        tgetstr("sr", &area);
           keypad_local =          tgetstr("ke", &area);
           keypad_xmit =           tgetstr("ks", &area);
           key_backspace =         tgetstr("kb", &area);
@@ -596,6 +596,164 @@ void drawRawArc
   }*/
 }
 
+/*- Span Drawing Functions -------------
+Filled shapes are broken into horizontal
+spans. Each span is clipped to the buffer
+once and then filled with a tight loop.
+--------------------------------------*/
+// Fills the pixels x1 to x2 (inclusive) of row y. Parts outside the buffer are skipped.
+void drawRawSpan (way_winType window, intType y, intType x1, intType x2, intType col)
+{
+  const uint32_t pixelValue = (uint32_t) col;
+  uint32_t *pixel, *beyond;
+
+  if (y >= 0 && y < window->buffer->height)
+  { if (x1 < 0)
+      x1 = 0;
+    if (x2 >= window->buffer->width)
+      x2 = window->buffer->width - 1;
+    if (x1 <= x2)
+    { pixel = &window->buffer->content[y * window->buffer->width + x1];
+      beyond = pixel + (x2 - x1 + 1);
+      // Eight stores per iteration allow the compiler to use vector stores.
+      while (beyond - pixel >= 8)
+      { pixel[0] = pixelValue; pixel[1] = pixelValue;
+        pixel[2] = pixelValue; pixel[3] = pixelValue;
+        pixel[4] = pixelValue; pixel[5] = pixelValue;
+        pixel[6] = pixelValue; pixel[7] = pixelValue;
+        pixel += 8;
+      }
+      while (pixel < beyond)
+        *pixel++ = pixelValue;
+    }
+  }
+}
+
+// Returns the largest root with root*root <= value (or -1 if value is negative).
+static intType floorSqrt (intType value)
+{
+  intType root = -1;
+
+  if (value >= 0)
+  { root = (intType) sqrt((floatType) value);
+    while (root * root > value)
+      root--;
+    while ((root + 1) * (root + 1) <= value)
+      root++;
+  }
+  return root;
+}
+
+/* Returns the half width of row yd (relative to the center) of a filled circle,
+or -1 if the row is outside. Pixels with xd*xd + yd*yd <= r*r + r are inside. */
+static intType circleHalfWidth (intType radius, intType yd)
+{
+  return floorSqrt(radius * radius + radius - yd * yd);
+}
+
+typedef struct
+{ floatType start;   // Start angle normalized to [0, 2*PI).
+  floatType sweep;   // Counter-clockwise sweep (not negative).
+  floatType dirX[2]; // Directions of the start and the end ray (y grows downward).
+  floatType dirY[2];
+} arcSweepType;
+
+static void initArcSweep (arcSweepType *arc, floatType startAngle, floatType sweepAngle)
+{
+  if (sweepAngle < 0.0)
+  { startAngle += sweepAngle;
+    sweepAngle = -sweepAngle;
+  }
+  arc->start = fmod(startAngle, PI2);
+  if (arc->start < 0.0)
+    arc->start += PI2;
+  arc->sweep = sweepAngle;
+  arc->dirX[0] = cos(arc->start);
+  arc->dirY[0] = -sin(arc->start);
+  arc->dirX[1] = cos(arc->start + sweepAngle);
+  arc->dirY[1] = -sin(arc->start + sweepAngle);
+}
+
+static boolType insideArcSweep (const arcSweepType *arc, intType xd, intType yd)
+{
+  floatType angle;
+
+  if (xd == 0 && yd == 0)
+    return TRUE;
+  angle = fmod(atan2((floatType) -yd, (floatType) xd) - arc->start, PI2);
+  if (angle < 0.0)
+    angle += PI2;
+  return angle <= arc->sweep;
+}
+
+/* Fills the pixels xd1 to xd2 of row yd (relative to the center x, y) that lie
+inside the arc sweep. The row is cut where the two rays of the sweep (and the
+vertical through the center) cross it. Each piece is either completely inside
+or completely outside, so one angle check per piece suffices. */
+static void drawRawSweepSpan
+( way_winType window,
+  intType x,
+  intType y,
+  intType xd1,
+  intType xd2,
+  intType yd,
+  const arcSweepType *arc,
+  intType col
+)
+{
+  intType cut[4], from, to;
+  floatType crossing;
+  int numCuts = 0, index, pos;
+
+  for (index = 0; index < 4; index++)
+  { if (index < 2)
+    { if (arc->dirY[index] == 0.0 || (floatType) yd / arc->dirY[index] < 0.0)
+        continue;
+      crossing = (floatType) yd / arc->dirY[index] * arc->dirX[index];
+    }
+    else
+    if (index == 2)
+      crossing = 0.0;
+    else
+    if (yd == 0)
+      crossing = -0.5; // The center is a piece of its own.
+    else
+      continue;
+    // Pixels left of the cut are at most at the crossing.
+    if (crossing >= (floatType) xd1 && crossing < (floatType) xd2)
+    { cut[numCuts] = (intType) floor(crossing) + 1;
+      for (pos = numCuts; pos > 0 && cut[pos-1] > cut[pos]; pos--)
+      { from = cut[pos];
+        cut[pos] = cut[pos-1];
+        cut[pos-1] = from;
+      }
+      numCuts++;
+    }
+  }
+
+  from = xd1;
+  for (index = 0; index <= numCuts; index++)
+  { to = index < numCuts ? cut[index] - 1 : xd2;
+    if (from <= to && insideArcSweep(arc, from + (to - from) / 2, yd))
+      drawRawSpan(window, y + yd, x + from, x + to, col);
+    if (to + 1 > from)
+      from = to + 1;
+  }
+}
+
+// Fills a circle (center x, y) row by row, restricted to the visible rows.
+void drawRawDisc (way_winType window, intType x, intType y, intType radius, intType col)
+{
+  intType yPos, lastRow, halfWidth;
+
+  yPos = y - radius < 0 ? 0 : y - radius;
+  lastRow = y + radius < window->buffer->height ? y + radius : window->buffer->height - 1;
+  for (; yPos <= lastRow; yPos++)
+  { halfWidth = circleHalfWidth(radius, yPos - y);
+    drawRawSpan(window, yPos, x - halfWidth, x + halfWidth, col);
+  }
+}
+
 /*- Secondary Drawing Functions --------
 --------------------------------------*/
 /* Needed?
@@ -633,9 +791,8 @@ void drwClear (winType actual_window, intType col)
   // printf("Clear color: %ld\n", col);
 
   if (prepare_buffer_data(&waylandState, window))
-  { // Could use memset instead?
-    for (int pos = 0; pos < window->buffer->width * window->buffer->height; pos++)
-      window->buffer->content[pos] = col;
+  { for (intType yPos = 0; yPos < window->buffer->height; yPos++)
+      drawRawSpan(window, yPos, 0, window->buffer->width - 1, col);
 
     if (!window->isPixmap)
     { wl_buffer_add_listener(window->buffer->waylandData, &waylandBufferListener, NULL); // Add listener to destroy buffer.
@@ -700,7 +857,7 @@ void drwCopyArea
 )
 {
   way_winType source, destination;
-  intType dx, dy, sPos, dPos;
+  intType dy, row, sPos, dPos;
 
   logFunction(printf("drwCopyArea(" FMT_U_MEM ", " FMT_U_MEM ", "
                      FMT_D ", " FMT_D ", " FMT_D ", " FMT_D ", " FMT_D
@@ -723,13 +880,21 @@ void drwCopyArea
     destination = (way_winType) dest_window;
     clamp_common_area(source, destination, &src_x, &src_y, &width, &height, &dest_x, &dest_y);
     // If the resulting coordinates actually lie within both planes.
-    if (width > 0 && height > 0 && prepare_buffer_copy(&waylandState, destination))
-    { // Copy the pixels from source to destination.
+    if
+    ( width > 0 && height > 0 &&
+      source->buffer && source->buffer->content &&
+      prepare_buffer_copy(&waylandState, destination)
+    )
+    { /* Copy the pixels from source to destination, row by row with memmove.
+      When an area of a window is moved downward within the same window,
+      the rows are copied from the bottom, so no row is overwritten before
+      it is copied. Overlaps within a row are handled by memmove. */
       for (dy = 0; dy < height; dy++)
-      { sPos = (src_y+dy)*source->width + src_x;
-        dPos = (dest_y+dy)*destination->width + dest_x;
-        for (dx = 0; dx < width; dx++)
-          destination->buffer->content[dPos+dx] = source->buffer->content[sPos+dx];
+      { row = source == destination && dest_y > src_y ? height - 1 - dy : dy;
+        sPos = (src_y+row)*source->width + src_x;
+        dPos = (dest_y+row)*destination->width + dest_x;
+        memmove(&destination->buffer->content[dPos], &source->buffer->content[sPos],
+                (size_t) width * sizeof(uint32_t));
       }
       // When dealing with a wayland object, notify its surface of the change.
       if (!destination->isPixmap)
@@ -760,10 +925,10 @@ void drwFPolyLine (const_winType actual_window, intType x, intType y, bstriType
   int *coords;
   memSizeType numCoords, point;
   intType left, right, top, bottom,
-    y0, x1,y1, x2,y2, y3;
-  intType xPos, yPos, pos, maxPos;
-  float slope;
-  bool countCorner, contained;
+    x1,y1, x2,y2;
+  intType yPos, lastRow;
+  floatType crossing;
+  memSizeType numCrossings, pos;
 
   logFunction(printf("drwFPolyLine(" FMT_U_MEM ", " FMT_D ", " FMT_D
                      ", " FMT_U_MEM ", " F_X(08) ")\n",
@@ -780,15 +945,13 @@ void drwFPolyLine (const_winType actual_window, intType x, intType y, bstriType
   else
   { coords = (int *) point_list->mem;
     numCoords = point_list->size / sizeof(int);
-    float slopes[numCoords/2];
 
     if (numCoords >= 4)
     { way_winType window = (way_winType) actual_window;
       if (prepare_buffer_copy(&waylandState, window))
-      { // Find the bounds and the slopes, and draw the outline.
+      { // Find the bounds and draw the outline.
         left = x+coords[0]; right = left;
         top = y+coords[1]; bottom = top;
-        slopes[0] = (float)(coords[numCoords-1]-coords[1]) / (float)(coords[numCoords-2]-coords[0]);
         for (point = 2; point+1 < numCoords; point+=2)
         { x1 = x+coords[point-2];
           y1 = y+coords[point-1];
@@ -803,69 +966,45 @@ void drwFPolyLine (const_winType actual_window, intType x, intType y, bstriType
           else if (y1 > bottom) bottom = y1;
           if (y2 < top) top = y2;
           else if (y2 > bottom) bottom = y2;
-          slopes[point/2] = (float)(y1-y2) / (float)(x1-x2);
         }
 
-        // Fill the polygon utilizing the even-odd rule.
+        /* Fill the polygon utilizing the even-odd rule. For every row the crossings
+        of the edges are sorted and the pixels between pairs of crossings are filled.
+        An edge crosses row yPos, if one end is above or at the row and the other end
+        below it. That way a corner, where both edges continue on the same side, is
+        counted twice (or not at all). */
         if (numCoords >= 6) // No need for more work if only a line is being drawn.
-        { maxPos = window->buffer->width * window->buffer->height;
-
-          for (yPos = top; yPos < bottom; yPos++)
-            for (xPos = left, pos = yPos * window->buffer->width + xPos; xPos < right; xPos++, pos++)
-              if (pos < maxPos)
-              { // Check to see if the point is within the polygon.
-                contained = false;
-                for (point = 0, countCorner = false; point+1 < numCoords; point+=2, countCorner = !countCorner)
-                { // For the first point, join from the last point.
-                  if (point == 0)
-                  { x1 = x+coords[numCoords-2];
-                    y1 = y+coords[numCoords-1];
-                    x2 = x+coords[point];
-                    y2 = y+coords[point+1];
-                  }
-                  else
-                  { x1 = x+coords[point-2];
-                    y1 = y+coords[point-1];
-                    x2 = x+coords[point];
-                    y2 = y+coords[point+1];
-                  }
-                  slope = slopes[point/2];
-                  if // Check for intersection.
-                  ( (y1 <= yPos && y2 >= yPos || y2 <= yPos && y1 >= yPos) &&
-                    ( !slope && (x1 >= xPos || x2 >= xPos) ||
-                      // y = mx   x = y/m
-                      slope && xPos-x1 <= (float)(yPos-y1) / slope
-                    ) &&
-                    (countCorner || yPos != y1 && yPos != y2)
-                  )
-                  { // Get the adjacent y's to the both y1 and y2.
-                    if (point == 0)
-                    { y0 = y+coords[numCoords-3];
-                      y3 = y+coords[point+3];
-                    }
-                    else
-                    { if (point >= 4)
-                        y0 = y+coords[point-3];
-                      else
-                        y0 = y+coords[numCoords-(3-point)];
-                      if (point+3 < numCoords)
-                        y3 = y+coords[point+3];
-                      else
-                        y3 = y+coords[1];
-                    }
-                    /* Only count when not a corner point, or when both segments connected to the corner
-                    lie on the same side (y) of the ray. */
-                    if
-                    ( (yPos != y1 || (y2 < y1) != (y0 < y1)) &&
-                      (yPos != y2 || (y1 < y2) != (y3 < y2))
-                    )
-                      contained = !contained;
-                  }
-                }
-                // If the ray has intersected an odd number of segments in the polygon.
-                if (contained)
-                  window->buffer->content[pos] = col;
+        { floatType crossings[numCoords/2];
+
+          yPos = top < 0 ? 0 : top;
+          lastRow = bottom < window->buffer->height ? bottom : window->buffer->height - 1;
+          for (; yPos <= lastRow; yPos++)
+          { numCrossings = 0;
+            for (point = 0; point+1 < numCoords; point+=2)
+            { // For the first point, join from the last point.
+              if (point == 0)
+              { x1 = x+coords[numCoords-2];
+                y1 = y+coords[numCoords-1];
+              }
+              else
+              { x1 = x+coords[point-2];
+                y1 = y+coords[point-1];
+              }
+              x2 = x+coords[point];
+              y2 = y+coords[point+1];
+              if ((y1 <= yPos) != (y2 <= yPos))
+              { crossing = (floatType) x1 + (floatType) (yPos-y1) * (floatType) (x2-x1) / (floatType) (y2-y1);
+                // Insert the crossing, so that the crossings stay sorted.
+                for (pos = numCrossings; pos > 0 && crossings[pos-1] > crossing; pos--)
+                  crossings[pos] = crossings[pos-1];
+                crossings[pos] = crossing;
+                numCrossings++;
               }
+            }
+            for (pos = 0; pos+1 < numCrossings; pos+=2)
+              drawRawSpan(window, yPos, (intType) ceil(crossings[pos]),
+                          (intType) ceil(crossings[pos+1]) - 1, col);
+          }
         }
 
         if (!window->isPixmap)
@@ -1248,8 +1387,6 @@ void drwPFArc
   intType col
 )
 {
-  int dr;
-
   logFunction(printf("drwPFArc(" FMT_U_MEM ", " FMT_D ", " FMT_D ", " FMT_D
                        ", %.4f, %.4f, " FMT_D ", " F_X(08) ")\n",
                        (memSizeType) actual_window, x, y, radius,
@@ -1274,21 +1411,29 @@ void drwPFArc
   { way_winType window = (way_winType) actual_window;
 
     if (prepare_buffer_copy(&waylandState, window))
-    { for (dr = 0; dr < width; dr++)
-      { drawRawArc(window, x, y, radius-dr, startAngle, sweepAngle, col);
-        // There's definitely a more efficient way to fill the gaps...
-        if (dr < width)
-        { drawRawArc(window, x-1, y, radius-dr, startAngle, sweepAngle, col);
-          drawRawArc(window, x+1, y, radius-dr, startAngle, sweepAngle, col);
-          drawRawArc(window, x, y-1, radius-dr, startAngle, sweepAngle, col);
-          drawRawArc(window, x, y+1, radius-dr, startAngle, sweepAngle, col);
+    { /* Fill the ring between the circle of radius and the circle of radius-width
+      (which is left empty) row by row, keeping the pixels inside the sweep. */
+      arcSweepType arc;
+      intType yPos, lastRow, outer, inner;
+
+      initArcSweep(&arc, startAngle, sweepAngle);
+      yPos = y - radius < 0 ? 0 : y - radius;
+      lastRow = y + radius < window->buffer->height ? y + radius : window->buffer->height - 1;
+      for (; yPos <= lastRow; yPos++)
+      { outer = circleHalfWidth(radius, yPos - y);
+        inner = radius > width ? circleHalfWidth(radius - width, yPos - y) : -1;
+        if (inner < 0)
+          drawRawSweepSpan(window, x, y, -outer, outer, yPos - y, &arc, col);
+        else
+        { drawRawSweepSpan(window, x, y, -outer, -inner - 1, yPos - y, &arc, col);
+          drawRawSweepSpan(window, x, y, inner + 1, outer, yPos - y, &arc, col);
         }
       }
 
       if (!window->isPixmap)
       { wl_buffer_add_listener(window->buffer->waylandData, &waylandBufferListener, NULL); // Add listener to destroy buffer.
         wl_surface_attach(window->surface, window->buffer->waylandData, 0, 0);
-        wl_surface_damage_buffer(window->surface, x-radius, y-radius, x+radius, y+radius); // INT32_MAX, INT32_MAX);
+        wl_surface_damage_buffer(window->surface, x-radius, y-radius, 2*radius+1, 2*radius+1);
         wl_surface_commit(window->surface);
         //wl_display_flush(waylandState.display);
         //wl_display_dispatch_pending(waylandState.display);
@@ -1297,7 +1442,6 @@ void drwPFArc
   }
 }
 
-// Unfinished: should tie in with jesko's method to produce a shape similar to other arcs/circles.
 // Renders a circle, but skips the area outside the line formed by start and end angle.
 void drwPFArcChord
 ( const_winType actual_window,
@@ -1335,151 +1479,50 @@ void drwPFArcChord
   { way_winType window = (way_winType) actual_window;
 
     if (prepare_buffer_copy(&waylandState, window))
-    { /* Angles are given as radians. Start angle of 0 is right, sweeps counter-clockwise.
-      As we are dealing with radians, 2 * PI is a full turn (or 360 degrees). */
-      boolType crossingBound = false;
-      startAngle = fmod(startAngle, PI2);
-      if (startAngle < 0)
-        startAngle += PI2;
-      floatType endAngle = startAngle + sweepAngle;
-      if (endAngle < 0)
-      { crossingBound = true;
-        endAngle += PI2;
-      }
-      else
-      if (endAngle > PI2)
-      { crossingBound = true;
-        endAngle = fmod(endAngle, PI2);
-      }
-      // printf("Start: %.10f  End: %.10f  Crossing: %d\n", startAngle, endAngle, crossingBound);
-
-      // Ensure the start angle is earlier in the arc.
-      if (startAngle > endAngle)
-      { floatType tempAngle = endAngle;
-        endAngle = startAngle;
-        startAngle = tempAngle;
-      }
-
-      const float Turn4 = PI/2.0;
-      float slope;
-      int x1, y1, x2, y2, posSign = -1; // Default is to fill above the line.
-      intType xPos, yPos, pos, intercept;
-      const intType maxPos = window->buffer->width * window->buffer->height;
-      // printf("45: %f  90: %f  135: %f  225: %f  335: %f\n", tanf(Turn4/2.0), tanf(Turn4), tanf(Turn4*1.5), tanf(Turn4*2.5), tanf(Turn4*3.5));
-
-      // Find point A.
-      // Need to handle values very close to Turn4 due to floating point rounding issues.
-      if (fabs(Turn4-fmod(startAngle,Turn4)) < 0.000001) // Slopeless angle.
-      { if (startAngle < 1.0 || startAngle > PI2-1.0) // 0
-        { x1 = radius;
-          y1 = 0;
-        }
-        else
-        if (startAngle < PI - 1.0) // Turn4
-        { x1 = 0;
-          y1 = -radius;
-        }
-        else
-        if (startAngle < PI + Turn4 - 1.0) // PI
-        { x1 = -radius;
-          y1 = 0;
-        }
-        else // PI + Turn4
-        { x1 = 0;
-          y1 = radius;
-        }
-      }
-      else
-      { slope = -tanf(startAngle);
-        // printf("slope1: %.10f\n", slope);
-        x1 = !slope ? radius : sqrt((float)(radius*radius) / (slope*slope + 1.0));
-        if (startAngle > Turn4 && startAngle < PI*1.5)
-          x1 = -x1;
-        y1 = slope * (float)x1;
-      }
-
-      // Find point B.
-      if (fabs(Turn4-fmod(endAngle,Turn4)) < 0.000001) // Slopeless angle.
-      { if (endAngle < 1.0 || endAngle > PI2-1.0) // 0
-        { x2 = radius;
-          y2 = 0;
+    { /* The chord from point A (start angle) to point B (end angle) splits the
+      circle. The side of the chord, which contains the middle of the arc, is
+      filled. Angles are given as radians. Start angle of 0 is right, sweeps
+      counter-clockwise. */
+      floatType ax, ay, bx, by, side, factor, limit;
+      intType yPos, lastRow, yd, xd1, xd2;
+
+      ax = (floatType) radius * cos(startAngle);
+      ay = (floatType) radius * -sin(startAngle);
+      bx = (floatType) radius * cos(startAngle + sweepAngle);
+      by = (floatType) radius * -sin(startAngle + sweepAngle);
+      // Sign of the cross product (B - A) x (M - A), with M as middle of the arc.
+      side = (bx - ax) * ((floatType) radius * -sin(startAngle + sweepAngle / 2.0) - ay) -
+             (by - ay) * ((floatType) radius * cos(startAngle + sweepAngle / 2.0) - ax);
+      side = side < 0.0 ? -1.0 : 1.0;
+      /* A pixel (xd, yd) is inside, if side * ((bx-ax)*(yd-ay) - (by-ay)*(xd-ax)) >= 0.
+      For a row this is factor * xd <= limit. */
+      factor = side * (by - ay);
+      yPos = y - radius < 0 ? 0 : y - radius;
+      lastRow = y + radius < window->buffer->height ? y + radius : window->buffer->height - 1;
+      for (; yPos <= lastRow; yPos++)
+      { yd = yPos - y;
+        xd2 = circleHalfWidth(radius, yd);
+        xd1 = -xd2;
+        limit = side * ((bx - ax) * ((floatType) yd - ay) + (by - ay) * ax) + 0.000001;
+        if (factor > 0.0)
+        { if (limit / factor < (floatType) xd2)
+            xd2 = (intType) floor(limit / factor);
         }
         else
-        if (endAngle < PI - 1.0) // Turn4
-        { x2 = 0;
-          y2 = -radius;
-        }
-        else
-        if (endAngle < PI + Turn4 - 1.0) // PI
-        { x2 = -radius;
-          y2 = 0;
-        }
-        else // PI + Turn4
-        { x2 = 0;
-          y2 = radius;
-        }
-      }
-      else
-      { slope = -tanf(endAngle); // We want positive slope to indicate a slant of (\)
-        // printf("slope2: %.10f\n", slope);
-        x2 = !slope ? radius : sqrt((float)(radius*radius) / (slope*slope + 1.0));
-        if (endAngle > Turn4 && endAngle < PI*1.5)
-          x2 = -x2;
-        y2 = slope * (float)x2;
-      }
-
-      // Slope of A to B.
-      slope = x2-x1 ? (float)(y2-y1)/(float)(x2-x1) : 0.0;
-      xPos = x;// - radius;
-      yPos = y;// - radius;
-      if (slope)
-        intercept = (-y1 / slope) + x1;
-
-      // Determine whether or not to fill below the line.
-      if (slope)
-      { if (slope > 0)
-        { if (!crossingBound && startAngle >= Turn4)
-            posSign = 1; // Fill below the line.
+        if (factor < 0.0)
+        { if (limit / factor > (floatType) xd1)
+            xd1 = (intType) ceil(limit / factor);
         }
         else
-        if (crossingBound || startAngle >= PI)
-          posSign = 1;
+        if (limit < 0.0)
+          xd2 = xd1 - 1;
+        drawRawSpan(window, yPos, x + xd1, x + xd2, col);
       }
-      else // Horizontal line.
-      if (y1 == y2)
-      { if (crossingBound == (startAngle < PI))
-          posSign = 1; // Fill below the line.
-      }
-      else // Vertical line
-      if (crossingBound)
-        posSign = 1; // Fill to the right.
-
-      // printf("startAngle: %f  sweep: %f  end: %f  Turn4: %.10f  slope: %.10f  intercept: %ld  fmod: %.10f  div: %.10f  ex: %.10f\n", startAngle, sweepAngle, endAngle, Turn4, slope, intercept, fmod(startAngle, Turn4), startAngle/Turn4, fabs(Turn4-fmod(startAngle,Turn4)));
-      // printf("x1: %d y1: %d   x2: %d y2: %d  sign: %d\n", x1, y1, x2, y2, posSign);
-
-      for (int yd = -radius; yd <= radius; yd++)
-        for (int xd = -radius; xd <= radius; xd++)
-        { pos = (yPos + yd)*window->buffer->width + (xPos + xd);
-          if (pos <= maxPos && xd*xd + yd*yd <= radius*radius)
-          { if (slope)// y = mx + b
-            { if (posSign == 1 && yd >= slope * (float)(xd - intercept) || posSign == -1 && yd <= slope * (float)(xd - intercept))
-                window->buffer->content[pos] = col;
-            }
-            else // Horizontal line.
-            if (y1 == y2)
-            { if (posSign == 1 && yd >= y1 || posSign == -1 && yd <= y1)
-                window->buffer->content[pos] = col;
-            }
-            else // Vertical line.
-            if (posSign == 1 && xd >= x1 || posSign == -1 && xd <= x1)
-                window->buffer->content[pos] = col;
-          }
-        }
 
       if (!window->isPixmap)
       { wl_buffer_add_listener(window->buffer->waylandData, &waylandBufferListener, NULL); // Add listener to destroy buffer.
         wl_surface_attach(window->surface, window->buffer->waylandData, 0, 0);
-        wl_surface_damage_buffer(window->surface, x-radius, y-radius, x+radius, y+radius); // INT32_MAX, INT32_MAX);
+        wl_surface_damage_buffer(window->surface, x-radius, y-radius, 2*radius+1, 2*radius+1);
         wl_surface_commit(window->surface);
         //wl_display_flush(waylandState.display);
         //wl_display_dispatch_pending(waylandState.display);
@@ -1488,7 +1531,6 @@ void drwPFArcChord
   }
 }
 
-// Could likely be optimized (specifically in the gap-filling, as the whole extra line isn't necessary).
 void drwPFArcPieSlice
 ( const_winType actual_window,
   intType x,
@@ -1526,159 +1568,22 @@ void drwPFArcPieSlice
   { way_winType window = (way_winType) actual_window;
 
     if (prepare_buffer_copy(&waylandState, window))
-    { /* Angles are given as radians. Start angle of 0 is right, sweeps counter-clockwise.
-      As we are dealing with radians, 2 * PI is a full turn (or 360 degrees).
-      Jesko's method works with 1/8 turns. */
-      const float Turn8 = PI2 / 8.0;
-      boolType crossingBound = false; // Used to control how we compare to the start/end angles.
-      startAngle = fmod(startAngle, PI2); // Discard full turns.
-      if (startAngle < 0) // When negative, find the corresponding positive angle.
-        startAngle += PI2;
-      floatType endAngle = startAngle + sweepAngle; // Sweep to end.
-      if (endAngle < 0) // When negative, find corresponding, but also note that we are crossing the "bound" (being zero).
-      { crossingBound = true;
-        endAngle += PI2;
-      }
-      else
-      if (endAngle > PI2) // Also crossing the bound when the end is greater than a full turn.
-      { crossingBound = true;
-        endAngle = fmod(endAngle, PI2);
+    { // Fill the circle row by row, keeping the pixels inside the sweep.
+      arcSweepType arc;
+      intType yPos, lastRow, halfWidth;
+
+      initArcSweep(&arc, startAngle, sweepAngle);
+      yPos = y - radius < 0 ? 0 : y - radius;
+      lastRow = y + radius < window->buffer->height ? y + radius : window->buffer->height - 1;
+      for (; yPos <= lastRow; yPos++)
+      { halfWidth = circleHalfWidth(radius, yPos - y);
+        drawRawSweepSpan(window, x, y, -halfWidth, halfWidth, yPos - y, &arc, col);
       }
 
-      // Ensure the start angle is earlier in the arc (for our later angle checks).
-      if (startAngle > endAngle)
-      { floatType tempAngle = endAngle;
-        endAngle = startAngle;
-        startAngle = tempAngle;
-      }
-
-      // Set up Jesko's variables.
-      intType t1 = radius / 16, // This division makes for a smoother edge.
-        t2 = 0,
-        xd = radius,
-        yd = 0;
-      // And some of our own.
-      intType xPos = 0, yPos = 0;
-      floatType angle = 0.0;
-      boolType drewPrior[8] = {false}; // Starts at the right, rotating counter-clockwise.
-      boolType xChanged = false;
-
-      while (xd >= yd)
-      { // Using the coordinate, render the eight mirrored lines, when appropriate.
-        // Render right, downward A (plunges from the middle)
-        xPos = x + xd; yPos = y + yd; angle = PI2 - ((float)yd / (float)xd) * Turn8;
-          if (!crossingBound && angle >= startAngle && angle <= endAngle || crossingBound && (angle <= startAngle || angle >= endAngle))
-          { drawRawLine(window, x, y, xPos, yPos, col);
-            // When both coordinates have changed, render an extra line to cover the gaps.
-            if (xChanged && drewPrior[7])
-              drawRawLine(window, x, y, xPos, yPos-1, col);
-            drewPrior[7] = true;
-          }
-          else
-            drewPrior[7] = false;
-        // Render right, upward A (rises from the middle)
-        yPos = y - yd; angle = ((float)yd / (float)xd) * Turn8;
-          if (!crossingBound && angle >= startAngle && angle <= endAngle || crossingBound && (angle <= startAngle || angle >= endAngle))
-          { drawRawLine(window, x, y, xPos, yPos, col);
-            if (xChanged && drewPrior[0])
-              drawRawLine(window, x, y, xPos, yPos+1, col);
-            drewPrior[0] = true;
-          }
-          else
-            drewPrior[0] = false;
-        // Render left, upward A
-        xPos = x - xd; angle = PI - ((float)yd / (float)xd) * Turn8;
-          if (!crossingBound && angle >= startAngle && angle <= endAngle || crossingBound && (angle <= startAngle || angle >= endAngle))
-          { drawRawLine(window, x, y, xPos, yPos, col);
-            if (xChanged && drewPrior[3])
-              drawRawLine(window, x, y, xPos, yPos+1, col);
-            drewPrior[3] = true;
-          }
-          else
-            drewPrior[3] = false;
-        // Render left, downward A (these first four draw the "parenthesis" portion: ( )
-        yPos = y + yd; angle = PI + ((float)yd / (float)xd) * Turn8;
-          if (!crossingBound && angle >= startAngle && angle <= endAngle || crossingBound && (angle <= startAngle || angle >= endAngle))
-          { drawRawLine(window, x, y, xPos, yPos, col);
-            if (xChanged && drewPrior[4])
-              drawRawLine(window, x, y, xPos, yPos-1, col);
-            drewPrior[4] = true;
-          }
-          else
-            drewPrior[4] = false;
-        // Render right, downard B (touches the bottom)
-        xPos = x + yd; yPos = y + xd; angle = PI2*0.75 + ((float)yd / (float)xd) * Turn8;
-          if (!crossingBound && angle >= startAngle && angle <= endAngle || crossingBound && (angle <= startAngle || angle >= endAngle))
-          { drawRawLine(window, x, y, xPos, yPos, col);
-            if (xChanged && drewPrior[6])
-              drawRawLine(window, x, y, xPos-1, yPos, col);
-            drewPrior[6] = true;
-          }
-          else
-            drewPrior[6] = false;
-        // Render right, upward B (touches the top)
-        yPos = y - xd; angle = PI*0.5 - ((float)yd / (float)xd) * Turn8;
-          if (!crossingBound && angle >= startAngle && angle <= endAngle || crossingBound && (angle <= startAngle || angle >= endAngle))
-          { drawRawLine(window, x, y, xPos, yPos, col);
-            if (xChanged && drewPrior[1])
-              drawRawLine(window, x, y, xPos-1, yPos, col);
-            drewPrior[1] = true;
-          }
-          else
-            drewPrior[1] = false;
-        // Render left, upward B
-        xPos = x - yd; angle = PI*0.5 + ((float)yd / (float)xd) * Turn8;
-          if (!crossingBound && angle >= startAngle && angle <= endAngle || crossingBound && (angle <= startAngle || angle >= endAngle))
-          { drawRawLine(window, x, y, xPos, yPos, col);
-            if (xChanged && drewPrior[2])
-              drawRawLine(window, x, y, xPos+1, yPos, col);
-            drewPrior[2] = true;
-          }
-          else
-            drewPrior[2] = false;
-        // Render left, downward B
-        yPos = y + xd; angle = PI2*0.75 - ((float)yd / (float)xd) * Turn8;
-          if (!crossingBound && angle >= startAngle && angle <= endAngle || crossingBound && (angle <= startAngle || angle >= endAngle))
-          { drawRawLine(window, x, y, xPos, yPos, col);
-            if (xChanged && drewPrior[5])
-              drawRawLine(window, x, y, xPos+1, yPos, col);
-            drewPrior[5] = true;
-          }
-          else
-            drewPrior[5] = false;
-
-        // Adjust position.
-        yd += 1;
-        t1 += yd;
-        t2 = t1 - xd;
-
-        if (t2 >= 0)
-        { t1 = t2;
-          xd -= 1;
-          xChanged = true;
-        }
-        else
-          xChanged = false;
-      }
-
-      /* Fill in the gaps between the diagonal octant joins. These get missed in the main loop due
-      to these lines existing between the last lines drawn. The extra orthogonal lines aren't needed
-      because, the straight lines leave no gaps. */
-      xd = sqrt((radius*radius) / 2.0),
-      yd = xd;
-      if (drewPrior[0] && drewPrior[1])
-        drawRawLine(window, x, y, x+xd, y-yd, col);
-      if (drewPrior[2] && drewPrior[3])
-        drawRawLine(window, x, y, x-xd, y-yd, col);
-      if (drewPrior[4] && drewPrior[5])
-        drawRawLine(window, x, y, x-xd, y+yd, col);
-      if (drewPrior[6] && drewPrior[7])
-        drawRawLine(window, x, y, x+xd, y+yd, col);
-
       if (!window->isPixmap)
       { wl_buffer_add_listener(window->buffer->waylandData, &waylandBufferListener, NULL); // Add listener to destroy buffer.
         wl_surface_attach(window->surface, window->buffer->waylandData, 0, 0);
-        wl_surface_damage_buffer(window->surface, x-radius, y-radius, x+radius, y+radius); // INT32_MAX, INT32_MAX);
+        wl_surface_damage_buffer(window->surface, x-radius, y-radius, 2*radius+1, 2*radius+1);
         wl_surface_commit(window->surface);
         //wl_display_flush(waylandState.display);
         //wl_display_dispatch_pending(waylandState.display);
@@ -1708,59 +1613,12 @@ void drwPFCircle
   { way_winType window = (way_winType) actual_window;
 
     if (prepare_buffer_copy(&waylandState, window))
-    { // Again, using Jesko's method, but combining two horizontal points to form a line
-      intType t1 = radius / 16,
-        t2 = 0,
-        xd = radius,
-        yd = 0;
-      intType maxPos = window->buffer->width * window->buffer->height;
-      intType x1 = 0, x2 = 0, yPos = 0;
-
-      while (xd >= yd)
-      { // Using the coordinate, render the four lines.
-        // Render inner, upward
-        x1 = x - xd; yPos = y - yd;
-        x2 = x + xd;
-        for (intType z = 0, pos = yPos*window->buffer->width + x1; z <= x2-x1; z++, pos++)
-          if (pos < maxPos)
-            window->buffer->content[pos] = col;
-
-        // Render inner, downward
-        x1 = x - xd; yPos = y + yd;
-        x2 = x + xd;
-        for (intType z = 0, pos = yPos*window->buffer->width + x1; z <= x2-x1; z++, pos++)
-          if (pos < maxPos)
-            window->buffer->content[pos] = col;
-
-        // Render outer, upward
-        x1 = x - yd; yPos = y - xd;
-        x2 = x + yd;
-        for (intType z = 0, pos = yPos*window->buffer->width + x1; z <= x2-x1; z++, pos++)
-          if (pos < maxPos)
-            window->buffer->content[pos] = col;
-
-        // Render outer, downward
-        x1 = x - yd; yPos = y + xd;
-        x2 = x + yd;
-        for (intType z = 0, pos = yPos*window->buffer->width + x1; z <= x2-x1; z++, pos++)
-          if (pos < maxPos)
-            window->buffer->content[pos] = col;
-
-        // Adjust position.
-        yd += 1;
-        t1 += yd;
-        t2 = t1 - xd;
-
-        if (t2 >= 0)
-        { t1 = t2;
-          xd -= 1;
-        }
-      }
+    { drawRawDisc(window, x, y, radius, col);
 
       if (!window->isPixmap)
       { wl_buffer_add_listener(window->buffer->waylandData, &waylandBufferListener, NULL); // Add listener to destroy buffer.
         wl_surface_attach(window->surface, window->buffer->waylandData, 0, 0);
-        wl_surface_damage_buffer(window->surface, x-radius, y-radius, x+radius, y+radius); // INT32_MAX, INT32_MAX);
+        wl_surface_damage_buffer(window->surface, x-radius, y-radius, 2*radius+1, 2*radius+1);
         wl_surface_commit(window->surface);
         //wl_display_flush(waylandState.display);
         //wl_display_dispatch_pending(waylandState.display);
@@ -1879,55 +1737,28 @@ void drwPFEllipse
   { way_winType window = (way_winType) actual_window;
 
     if (prepare_buffer_copy(&waylandState, window))
-    { // Utilizing the Freeman approach as laid out in: https://cs.dartmouth.edu/~doug/155.pdf
-      intType a = width/2, b = height/2, xc = x+a, yc = y+b;
-      /* e(x,y) = bˆ2*xˆ2 + aˆ2*yˆ2 - aˆ2*bˆ2 */
-      x = 0, y = b;
-      long a2 = (long)a*a, b2 = (long)b*b;
-      long crit1 = -(a2/4 + a%2 + b2);
-      long crit2 = -(b2/4 + b%2 + a2);
-      long crit3 = -(b2/4 + b%2);
-      long t = -a2*y; /* t = e(x+1/2,y-1/2) - (aˆ2+bˆ2)/4 */
-      long dxt = 2*b2*x, dyt = -2*a2*y;
-      long d2xt = 2*b2, d2yt = 2*a2;
-      while(y>=0 && x<=a)
-      { // Render lines (to fill the ellipse).
-        if (x!=0 && y!=0)
-        { drawRawLine(window, xc+x, yc+y, xc-x, yc+y, col);
-          drawRawLine(window, xc+x, yc-y, xc-x, yc-y, col);
-        }
-        else if (x!=0)
-          drawRawLine(window, xc+x, yc, xc-x, yc, col);
-        else
-        { drawRawPoint(window, xc, yc+y, col);
-          if (y!=0)
-            drawRawPoint(window, xc, yc-y, col);
-        }
-        // Adjust variables.
-        if (t + b2*x <= crit1 || /* e(x+1,y-1/2) <= 0 */
-            t + a2*y <= crit3) /* e(x+1/2,y) <= 0 */
-        { // incx();
-          x++;
-          dxt += d2xt;
-          t += dxt;
-        }
-        else if (t - a2*y > crit2) /* e(x+1/2,y-1) > 0 */
-        { // incy();
-          y--;
-          dyt += d2yt;
-          t += dyt;
-        }
-        else
-        { // incx(); and incy();
-          x++; dxt += d2xt; t += dxt;
-          y--; dyt += d2yt; t += dyt;
+    { /* The ellipse fills the box from (x, y) with width and height. A pixel
+      is inside, if its center (xPos + 0.5, yPos + 0.5) is inside. */
+      const floatType a = (floatType) width / 2.0, b = (floatType) height / 2.0;
+      const floatType xc = (floatType) x + a, yc = (floatType) y + b;
+      floatType yd, halfWidth;
+      intType yPos, lastRow;
+
+      yPos = y < 0 ? 0 : y;
+      lastRow = y + height <= window->buffer->height ? y + height - 1 : window->buffer->height - 1;
+      for (; yPos <= lastRow; yPos++)
+      { yd = ((floatType) yPos + 0.5 - yc) / b;
+        if (yd > -1.0 && yd < 1.0)
+        { halfWidth = a * sqrt(1.0 - yd * yd);
+          drawRawSpan(window, yPos, (intType) ceil(xc - halfWidth - 0.5),
+                      (intType) floor(xc + halfWidth - 0.5), col);
         }
       }
 
       if (!window->isPixmap)
       { wl_buffer_add_listener(window->buffer->waylandData, &waylandBufferListener, NULL); // Add listener to destroy buffer.
         wl_surface_attach(window->surface, window->buffer->waylandData, 0, 0);
-        wl_surface_damage_buffer(window->surface, x-width, y-height, x+width, y+height);
+        wl_surface_damage_buffer(window->surface, x, y, width, height);
         wl_surface_commit(window->surface);
         //wl_display_flush(waylandState.display);
         //wl_display_dispatch_pending(waylandState.display);
@@ -2099,16 +1930,11 @@ void drwPRect (const_winType actual_window, intType x, intType y, intType width,
   { way_winType window = (way_winType) actual_window;
 
     if (prepare_buffer_copy(&waylandState, window))
-    { for (int yPos = y; yPos < y + height; yPos++)
-        for (int xPos = x; xPos < x + width; xPos++)
-        { int pos = yPos*window->buffer->width + xPos;
+    { intType yPos = y < 0 ? 0 : y;
+      intType lastRow = y + height <= window->buffer->height ? y + height - 1 : window->buffer->height - 1;
 
-          if (pos < window->buffer->width * window->buffer->height)
-            window->buffer->content[pos] = col;
-          else
-            goto End;
-        }
-      End:;
+      for (; yPos <= lastRow; yPos++)
+        drawRawSpan(window, yPos, x, x + width - 1, col);
 
       if (!window->isPixmap)
       { wl_buffer_add_listener(window->buffer->waylandData, &waylandBufferListener, NULL); // Add listener to destroy buffer.
@@ -2158,6 +1984,87 @@ void drwPut (const_winType destWindow, intType xDest, intType yDest, const_winTy
   }
 }
 
+/* Copies several areas (glyphs) of the pixmap atlas to destWindow. The array
+glyphs contains GLYPH_ENTRY_SIZE integers per glyph: xSrc, ySrc, width, height,
+xDest and yDest. All glyphs are copied into the buffer first and the surface is
+committed once with the bounding box of the glyphs as damage. */
+void drwPutGlyphs (const_winType destWindow, const_winType atlas, const const_rtlArrayType glyphs)
+{
+  way_winType source, destination;
+  memSizeType numValues, pos;
+  const rtlObjectType *glyph;
+  intType src_x, src_y, width, height, dest_x, dest_y, dx, dy, sPos, dPos;
+  intType minX = INT_MAX, minY = INT_MAX, maxX = INT_MIN, maxY = INT_MIN;
+  boolType bufferPrepared = FALSE, okay = TRUE;
+
+  logFunction(printf("drwPutGlyphs(" FMT_U_MEM ", " FMT_U_MEM ", " FMT_D " .. " FMT_D ")\n",
+                     (memSizeType) destWindow, (memSizeType) atlas,
+                     glyphs->min_position, glyphs->max_position););
+  numValues = arraySize(glyphs);
+  if (unlikely(numValues % GLYPH_ENTRY_SIZE != 0))
+  { logError(printf("drwPutGlyphs(" FMT_U_MEM ", " FMT_U_MEM ", " FMT_D " .. " FMT_D "): "
+                    "Number of elements not a multiple of %d\n",
+                    (memSizeType) destWindow, (memSizeType) atlas,
+                    glyphs->min_position, glyphs->max_position, GLYPH_ENTRY_SIZE););
+    raise_error(RANGE_ERROR);
+  }
+  else if (destWindow && atlas)
+  { source = (way_winType) atlas;
+    destination = (way_winType) destWindow;
+    if (source->buffer && source->buffer->content)
+    { for (pos = 0; okay && pos < numValues; pos += GLYPH_ENTRY_SIZE)
+      { glyph = &glyphs->arr[pos];
+        src_x = glyph[0].value.intValue;
+        src_y = glyph[1].value.intValue;
+        width = glyph[2].value.intValue;
+        height = glyph[3].value.intValue;
+        dest_x = glyph[4].value.intValue;
+        dest_y = glyph[5].value.intValue;
+        if (unlikely(!inIntRange(src_x) || !inIntRange(src_y) ||
+                     width < 0 || width > INT_MAX || height < 0 || height > INT_MAX ||
+                     !inIntRange(dest_x) || !inIntRange(dest_y)))
+        { logError(printf("drwPutGlyphs(" FMT_U_MEM ", " FMT_U_MEM ", " FMT_D " .. " FMT_D "): "
+                          "Glyph " FMT_U_MEM " not in allowed range\n",
+                          (memSizeType) destWindow, (memSizeType) atlas,
+                          glyphs->min_position, glyphs->max_position,
+                          pos / GLYPH_ENTRY_SIZE + 1););
+          raise_error(RANGE_ERROR);
+          okay = FALSE;
+        }
+        else
+        { clamp_common_area(source, destination, &src_x, &src_y, &width, &height, &dest_x, &dest_y);
+          if (width > 0 && height > 0)
+          { // The buffer is prepared once for all glyphs.
+            if (!bufferPrepared)
+            { bufferPrepared = prepare_buffer_copy(&waylandState, destination);
+              okay = bufferPrepared;
+            }
+            if (bufferPrepared)
+            { for (dy = 0; dy < height; dy++)
+              { sPos = (src_y+dy)*source->width + src_x;
+                dPos = (dest_y+dy)*destination->width + dest_x;
+                for (dx = 0; dx < width; dx++)
+                  destination->buffer->content[dPos+dx] = source->buffer->content[sPos+dx];
+              }
+              if (dest_x < minX) minX = dest_x;
+              if (dest_y < minY) minY = dest_y;
+              if (dest_x + width > maxX) maxX = dest_x + width;
+              if (dest_y + height > maxY) maxY = dest_y + height;
+            }
+          }
+        }
+      }
+      // Send one damage request and one commit for all glyphs.
+      if (bufferPrepared && !destination->isPixmap && maxX > minX)
+      { wl_buffer_add_listener(destination->buffer->waylandData, &waylandBufferListener, NULL); // Add listener to destroy buffer.
+        wl_surface_attach(destination->surface, destination->buffer->waylandData, 0, 0);
+        wl_surface_damage_buffer(destination->surface, minX, minY, maxX - minX, maxY - minY);
+        wl_surface_commit(destination->surface);
+      }
+    }
+  }
+}
+
 // Unfinished. Needs downscaling.
 void drwPutScaled
 ( const_winType destWindow,
@@ -2421,7 +2328,7 @@ void resizeWindow (way_winType window, intType width, intType height, bool trigg
   }
 
   if (triggerKey && (window->width != oldWidth || window->height != oldHeight))
-    expand_key_history(&waylandState, K_RESIZE);
+    queue_key_event(&waylandState, K_RESIZE);
 }
 
 // Unfinished.
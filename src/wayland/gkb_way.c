@@ -45,8 +45,6 @@
 #include "keyboard_globals.h"
 #include "state.h"
 
-#define KeyBuffer 10
-
 extern struct ClientState waylandState;
 extern void setResizeReturnsKey (winType resizeWindow, boolType active);
 extern void drwSetCloseAction (winType actual_window, intType closeAction);
@@ -73,10 +71,41 @@ bool poll_events (bool block)
   return result;
 }
 
+// Appends an event to the input ring (dropping the oldest event when it is full).
+static struct InputEvent *push_input_event (struct ClientState *state, int unsigned kind)
+{
+  struct InputRing *ring = &state->inputRing;
+  struct InputEvent *event;
+
+  if (ring->tail - ring->head >= INPUT_RING_SIZE)
+    ring->head++;
+  event = &ring->events[ring->tail & (INPUT_RING_SIZE - 1)];
+  event->kind = kind;
+  event->x = state->pointerPoint.x;
+  event->y = state->pointerPoint.y;
+  ring->tail++;
+  return event;
+}
+
+// Removes pointer motion events at the front of the input ring and
+// updates the position that is reported by gkbClickedXpos/Ypos.
+static void skip_motion_events (struct ClientState *state)
+{
+  struct InputRing *ring = &state->inputRing;
+  struct InputEvent *event;
+
+  while (ring->head != ring->tail &&
+      (event = &ring->events[ring->head & (INPUT_RING_SIZE - 1)])->kind == INPUT_EVENT_MOTION)
+  { state->mousePoint.x = event->x;
+    state->mousePoint.y = event->y;
+    ring->head++;
+  }
+}
+
 bool key_history_populated ()
 {
-  return waylandState.keyHistory && waylandState.keyHistory->keys &&
-    waylandState.keyHistory->keys->use > 0;
+  skip_motion_events(&waylandState);
+  return waylandState.inputRing.head != waylandState.inputRing.tail;
 }
 
 void wait_for_key ()
@@ -174,179 +203,92 @@ uint32_t translate_mouse_button (uint32_t button)
   }
 }
 
+// Returns the bit of key in the pressed keys bitmap or -1 if key is not in the bitmap.
+static int pressed_key_bit (uint32_t key)
+{
+  if (key < PRESSED_CHAR_LIMIT)
+    return (int) key;
+  else
+  if (key >= KEYCODE_BASE && key < KEYCODE_BASE + PRESSED_KEYCODE_LIMIT)
+    return (int) (PRESSED_CHAR_LIMIT + key - KEYCODE_BASE);
+  else
+    return -1;
+}
+
+static boolType key_is_pressed (struct ClientState *state, uint32_t key)
+{
+  int bit = pressed_key_bit(key);
+
+  if (bit >= 0)
+    return (boolType) ((state->keysPressed.bitmap[bit >> 5] >> (bit & 31)) & 1);
+  else
+  { for (int unsigned x = 0; x < state->keysPressed.otherCount; x++)
+      if (state->keysPressed.other[x] == key)
+        return TRUE;
+  }
+  return FALSE;
+}
+
 // Drops all non-mouse keys.
 void reset_pressed_keys (struct ClientState *state)
 {
-  if (state && state->keysPressed && state->keysPressed->use > 0)
-  { int newUse = state->keysPressed->use;
-    for (int unsigned x = 0; x < state->keysPressed->use;)
-      if (state->keysPressed->content[x] < K_MOUSE1 || state->keysPressed->content[x] > K_MOUSE_BACK)
-      { newUse--;
-        if (x + 1 < state->keysPressed->use)
-          state->keysPressed->content[x] = state->keysPressed->content[x+1];
-        else
-          break;
-      }
-      else
-        x++;
-    state->keysPressed->use = newUse;
+  if (state)
+  { uint32_t mouseButtons[PRESSED_BITMAP_WORDS] = { 0 };
+
+    for (uint32_t key = K_MOUSE1; key <= K_MOUSE_BACK; key++)
+    { int bit = pressed_key_bit(key);
+      mouseButtons[bit >> 5] |= state->keysPressed.bitmap[bit >> 5] & ((uint32_t) 1 << (bit & 31));
+    }
+    for (int unsigned x = 0; x < PRESSED_BITMAP_WORDS; x++)
+      state->keysPressed.bitmap[x] = mouseButtons[x];
+    state->keysPressed.otherCount = 0;
   }
 }
 
 void reset_pressed_mouse_buttons (struct ClientState *state)
 {
-  if (state && state->keysPressed && state->keysPressed->use > 0)
-  { int newUse = state->keysPressed->use;
-    for (int unsigned x = 0; x < state->keysPressed->use;)
-      if (state->keysPressed->content[x] >= K_MOUSE1 && state->keysPressed->content[x] <= K_MOUSE_BACK)
-      { newUse--;
-        if (x + 1 < state->keysPressed->use)
-          state->keysPressed->content[x] = state->keysPressed->content[x+1];
-        else
-          break;
-      }
-      else
-        x++;
-    state->keysPressed->use = newUse;
-  }
+  if (state)
+    for (uint32_t key = K_MOUSE1; key <= K_MOUSE_BACK; key++)
+    { int bit = pressed_key_bit(key);
+      state->keysPressed.bitmap[bit >> 5] &= ~((uint32_t) 1 << (bit & 31));
+    }
 }
 
-// Populates the keys-pressed array.
+// Marks the key as pressed.
 void add_pressed_key (struct ClientState *state, uint32_t key)
 {
-  if (!state->keysPressed)
-  { // Allocating a buffer to reduce the number of times we must use malloc.
-    struct KeyArray *newPressed = malloc(sizeof *state->keysPressed + sizeof(uint32_t) * KeyBuffer);
-
-    if (newPressed)
-    { newPressed->content[0] = key;
-      newPressed->size = KeyBuffer;
-      newPressed->use = 1;
-      state->keysPressed = newPressed;
-    }
-    else
-      raise_error(MEMORY_ERROR);
-  }
-  else
-  if (state->keysPressed->use >= state->keysPressed->size)
-  { state->keysPressed->use = state->keysPressed->size;
-    // It's unlikely we'll go above the buffer size for pressed keys, so only allocating 1 more when needed should be fine.
-    struct KeyArray *newPressed = malloc(sizeof *state->keysPressed + sizeof *state->keysPressed->content * (state->keysPressed->size+1));
-
-    if (newPressed)
-    { for (int unsigned x = 0; x < state->keysPressed->use; x++)
-        newPressed->content[x] = state->keysPressed->content[x];
-      newPressed->content[state->keysPressed->use] = key;
-      newPressed->size = state->keysPressed->size + 1;
-      newPressed->use = state->keysPressed->use + 1;
-      free(state->keysPressed);
-      state->keysPressed = newPressed;
-    }
-    else
-      raise_error(MEMORY_ERROR);
-  }
+  int bit = pressed_key_bit(key);
+
+  if (bit >= 0)
+    state->keysPressed.bitmap[bit >> 5] |= (uint32_t) 1 << (bit & 31);
   else
-  { state->keysPressed->content[state->keysPressed->use] = key;
-    state->keysPressed->use++;
+  if (!key_is_pressed(state, key) && state->keysPressed.otherCount < PRESSED_OTHER_SIZE)
+  { state->keysPressed.other[state->keysPressed.otherCount] = key;
+    state->keysPressed.otherCount++;
   }
-
-  /*for (int unsigned x = 0; x < state->keysPressed->use; x++)
-    printf("Now pressed: %c\n", state->keysPressed->content[x]);
-  puts("");*/
 }
 
 void remove_pressed_key (struct ClientState *state, uint32_t key)
 {
-  if (state->keysPressed && state->keysPressed->use > 0)
-  { // Search for the key in the pressed array.
-    for (int unsigned x = 0; x < state->keysPressed->use; x++)
-      if (state->keysPressed->content[x] == key)
-      { // Shrink back down to the buffer.
-        if (state->keysPressed->use > KeyBuffer)
-        { struct KeyArray *newPressed = 0;
-          newPressed = malloc(sizeof *state->keysPressed + sizeof *state->keysPressed->content * (state->keysPressed->size-1));
-
-          if (newPressed)
-          { for (int unsigned y = 0; y < state->keysPressed->use - 1; y++)
-              newPressed->content[y] = state->keysPressed->content[y + (y >= x ? 1 : 0)];
-            newPressed->size = state->keysPressed->size-1;
-            newPressed->use = state->keysPressed->use-1;
-            free(state->keysPressed);
-            state->keysPressed = newPressed;
-          }
-          else
-            raise_error(MEMORY_ERROR);
-        }
-        else // Or continue to use the buffer.
-        { for (int unsigned y = x; y < state->keysPressed->use - 1; y++)
-            state->keysPressed->content[y] = state->keysPressed->content[y+1];
-          state->keysPressed->use--;
-        }
+  int bit = pressed_key_bit(key);
+
+  if (bit >= 0)
+    state->keysPressed.bitmap[bit >> 5] &= ~((uint32_t) 1 << (bit & 31));
+  else
+  { for (int unsigned x = 0; x < state->keysPressed.otherCount; x++)
+      if (state->keysPressed.other[x] == key)
+      { state->keysPressed.otherCount--;
+        state->keysPressed.other[x] = state->keysPressed.other[state->keysPressed.otherCount];
         break;
       }
-
-    /*for (int unsigned x = 0; x < state->keysPressed->use; x++)
-      printf("Still pressed: %c\n", state->keysPressed->content[x]);
-    puts("");*/
   }
 }
 
-void expand_key_history (struct ClientState *state, uint32_t key)
+// Queues a key for gkbGetc (the oldest key is dropped when the input ring is full).
+void queue_key_event (struct ClientState *state, uint32_t key)
 {
   if (state)
-  { if (!state->keyHistory)
-    { struct KeyHistory *newHistory = malloc(sizeof *state->keyHistory);
-
-      if (newHistory)
-      { state->keyHistory = newHistory;
-        state->keyHistory->age = 0;
-        state->keyHistory->keys = 0;
-      }
-      else
-      { raise_error(MEMORY_ERROR);
-        return;
-      }
-    }
-
-    const int unsigned KeyLimit = 200; // We don't want to record keys for all time, so set a limit.
-    const int unsigned KeySpan = (!state->keyHistory->keys || state->keyHistory->keys->use + 1 < KeyLimit)
-      ? (!state->keyHistory->keys ? KeyBuffer : state->keyHistory->keys->use + 5) // Allocate multiple at a time.
-      : KeyLimit;
-
-    if (KeySpan > (state->keyHistory->keys ? state->keyHistory->keys->size : 0))
-    { struct KeyArray *newKeys = malloc(sizeof *state->keyHistory->keys + sizeof(uint32_t) * KeySpan);
-
-      if (newKeys)
-      { const int unsigned oldUse = state->keyHistory->keys ? state->keyHistory->keys->use: 0;
-        newKeys->size = KeySpan;
-        newKeys->use = oldUse + 1;
-
-        if (state->keyHistory->keys)
-          for (int unsigned x = 0; x < state->keyHistory->keys->use; x++)
-            newKeys->content[x] = state->keyHistory->keys->content[x];
-
-        newKeys->content[oldUse] = key;
-
-        free(state->keyHistory->keys);
-        state->keyHistory->keys = newKeys;
-      }
-      else
-        raise_error(MEMORY_ERROR);
-    }
-    else
-    if (KeySpan == KeyLimit)
-    { // Shift the keys back one (dropping the oldest key).
-      if (state->keyHistory->keys)
-        for (int unsigned x = 0; x < state->keyHistory->keys->size - 1; x++)
-          state->keyHistory->keys->content[x] = state->keyHistory->keys->content[x+1];
-
-      state->keyHistory->keys->content[state->keyHistory->keys->size-1] = key;
-    }
-    else
-    { state->keyHistory->keys->content[state->keyHistory->keys->use] = key;
-      state->keyHistory->keys->use++;
-    }
-  }
+    push_input_event(state, INPUT_EVENT_KEY)->key = key;
 }
 
 // Used for buttons and keys, the key parameter should be the Seed7 value (post-translation).
@@ -356,15 +298,14 @@ void alter_switch_state (struct ClientState *state, uint32_t key, bool pressed,
   ( "Alter key state called.\n"
     "  state: %p\n"
     "  key: %u\n"
-    "  pressed: %d\n"
-    "  initialHistory: %p\n",
-    state, key, pressed, state->keyHistory
+    "  pressed: %d\n",
+    state, key, pressed
   );*/
   if (state)
   { if (pressed)
     { add_pressed_key(state, key);
       if (touchHistory)
-        expand_key_history(state, key);
+        queue_key_event(state, key);
     }
     else
       remove_pressed_key(state, key);
@@ -373,44 +314,23 @@ void alter_switch_state (struct ClientState *state, uint32_t key, bool pressed,
 
 boolType alt_pressed (struct ClientState *state)
 {
-  if (state->keysPressed && state->keysPressed->use > 0)
-  { for (int unsigned x = 0; x < state->keysPressed->use; x++)
-      if
-      ( state->keysPressed->content[x] == K_ALT ||
-        state->keysPressed->content[x] == K_LEFT_ALT ||
-        state->keysPressed->content[x] == K_RIGHT_ALT
-      )
-        return TRUE;
-  }
-  return FALSE;
+  return key_is_pressed(state, K_ALT) ||
+    key_is_pressed(state, K_LEFT_ALT) ||
+    key_is_pressed(state, K_RIGHT_ALT);
 }
 
 boolType control_pressed (struct ClientState *state)
 {
-  if (state->keysPressed && state->keysPressed->use > 0)
-  { for (int unsigned x = 0; x < state->keysPressed->use; x++)
-      if
-      ( state->keysPressed->content[x] == K_CONTROL ||
-        state->keysPressed->content[x] == K_LEFT_CONTROL ||
-        state->keysPressed->content[x] == K_RIGHT_CONTROL
-      )
-        return TRUE;
-  }
-  return FALSE;
+  return key_is_pressed(state, K_CONTROL) ||
+    key_is_pressed(state, K_LEFT_CONTROL) ||
+    key_is_pressed(state, K_RIGHT_CONTROL);
 }
 
 boolType shift_pressed (struct ClientState *state)
 {
-  if (state->keysPressed && state->keysPressed->use > 0)
-  { for (int unsigned x = 0; x < state->keysPressed->use; x++)
-      if
-      ( state->keysPressed->content[x] == K_SHIFT ||
-        state->keysPressed->content[x] == K_LEFT_SHIFT ||
-        state->keysPressed->content[x] == K_RIGHT_SHIFT
-      )
-        return TRUE;
-  }
-  return FALSE;
+  return key_is_pressed(state, K_SHIFT) ||
+    key_is_pressed(state, K_LEFT_SHIFT) ||
+    key_is_pressed(state, K_RIGHT_SHIFT);
 }
 
 // Called by the Wayland key event hook (for presses and releases).
@@ -424,20 +344,35 @@ void alter_mouse_button_state (struct ClientState *state, uint32_t button, bool
   alter_switch_state(state, translate_mouse_button(button), pressed, touchHistory);
 }
 
+// Consecutive motions are merged, so moving the pointer does not fill the input ring.
 void record_mouse_movement (struct ClientState *state, int x, int y)
 {
-  state->mousePoint.x = x;
-  state->mousePoint.y = y;
+  struct InputRing *ring = &state->inputRing;
+  struct InputEvent *event;
+
+  state->pointerPoint.x = x;
+  state->pointerPoint.y = y;
+  if (ring->head != ring->tail &&
+      (event = &ring->events[(ring->tail - 1) & (INPUT_RING_SIZE - 1)])->kind == INPUT_EVENT_MOTION)
+  { event->x = x;
+    event->y = y;
+  }
+  else
+    push_input_event(state, INPUT_EVENT_MOTION);
 }
 
 void trigger_mouse_scroll (struct ClientState *state, bool forward)
 {
-  expand_key_history(state, forward ? K_MOUSE4 : K_MOUSE5);
+  queue_key_event(state, forward ? K_MOUSE4 : K_MOUSE5);
 }
 
 void gkbInitKeyboard (void)
 {
   logFunction(printf("gkbInitKeyboard()\n"););
+  waylandState.inputRing.head = 0;
+  waylandState.inputRing.tail = 0;
+  waylandState.pointerPoint.x = 0;
+  waylandState.pointerPoint.y = 0;
   waylandState.mousePoint.x = 0;
   waylandState.mousePoint.y = 0;
 }
@@ -553,49 +488,36 @@ boolType gkbButtonPressed (charType button)
       case K_ALT_PAUSE: target = K_PAUSE; alt = -1; break;
     }
 
-  if (waylandState.keysPressed && waylandState.keysPressed->use > 0)
-  { uint32_t *key = waylandState.keysPressed->content;
-    for (int unsigned x = 0; x < waylandState.keysPressed->use; x++, key++)
-    { // These three keys share the same codes as CTL_H, CTL_I, and CTL_J (which would have been converted above).
-      if (*key == button && (button == K_BS || button == K_TAB || button == K_NL))
-        return true;
-      else
-      if (*key == target)
-        targetFound = TRUE;
-      else
-      { switch (*key)
-        { case K_LEFT_SHIFT:
-          case K_RIGHT_SHIFT:
-            shift = 1;
-            break;
-          case K_LEFT_CONTROL:
-          case K_RIGHT_CONTROL:
-            control = 1;
-            break;
-          case K_LEFT_ALT:
-          case K_RIGHT_ALT:
-            alt = 1;
-            break;
-          default:
-            if ((control || alt) && target >= 'a' && target <= 'z' && *key >= 'A' && *key <= 'Z' && *key - 'A' == target - 'a')
-              targetFound = TRUE;
-        }
-      }
-      if (targetFound && shift >= 0 && control >= 0 && alt >= 0)
-        return TRUE;
-    }
-  }
+  // These three keys share the same codes as CTL_H, CTL_I, and CTL_J (which would have been converted above).
+  if ((button == K_BS || button == K_TAB || button == K_NL) && key_is_pressed(&waylandState, button))
+    return TRUE;
+
+  if (key_is_pressed(&waylandState, K_LEFT_SHIFT) || key_is_pressed(&waylandState, K_RIGHT_SHIFT))
+    shift = 1;
+  if (key_is_pressed(&waylandState, K_LEFT_CONTROL) || key_is_pressed(&waylandState, K_RIGHT_CONTROL))
+    control = 1;
+  if (key_is_pressed(&waylandState, K_LEFT_ALT) || key_is_pressed(&waylandState, K_RIGHT_ALT))
+    alt = 1;
+
+  if (!targetFound)
+    targetFound = key_is_pressed(&waylandState, target) ||
+      ((control || alt) && target >= 'a' && target <= 'z' && key_is_pressed(&waylandState, 'A' + target - 'a'));
+
+  if (targetFound && shift >= 0 && control >= 0 && alt >= 0)
+    return TRUE;
 
   return FALSE;
 }
 
 intType gkbClickedXpos (void)
 {
+  skip_motion_events(&waylandState);
   return (intType) waylandState.mousePoint.x;
 }
 
 intType gkbClickedYpos (void)
 {
+  skip_motion_events(&waylandState);
   return (intType) waylandState.mousePoint.y;
 }
 
@@ -604,13 +526,18 @@ charType gkbGetc (void)
 {
   charType result = K_NONE;
   boolType getNextChar = FALSE;
-  int unsigned newSize;
+  struct InputEvent *event;
 
   do
   { if (!key_history_populated())
       wait_for_key();
 
-    result = waylandState.keyHistory->keys->content[0];
+    // Remove the key from the input ring.
+    event = &waylandState.inputRing.events[waylandState.inputRing.head & (INPUT_RING_SIZE - 1)];
+    waylandState.inputRing.head++;
+    result = event->key;
+    waylandState.mousePoint.x = event->x;
+    waylandState.mousePoint.y = event->y;
 
     // Skip over control characters.
     if (result >= K_SHIFT && result <= K_SCROLL_LOCK)
@@ -691,34 +618,6 @@ charType gkbGetc (void)
       }
     }
 
-    // Remove the key from the history (reallocating at buffer size or every 10 characters beyond it).
-    if
-    ( waylandState.keyHistory->keys->use == KeyBuffer + 1 ||
-      waylandState.keyHistory->keys->use > KeyBuffer && (waylandState.keyHistory->keys->use-KeyBuffer) % 10 == 0
-    )
-    { newSize = (waylandState.keyHistory->keys->use == KeyBuffer + 1) ? KeyBuffer : waylandState.keyHistory->keys->use;
-      struct KeyArray *newKeys = malloc(sizeof *waylandState.keyHistory->keys + sizeof *waylandState.keyHistory->keys->content * newSize);
-
-      if (newKeys)
-      { newKeys->size = newSize;
-        newKeys->use = (newSize == waylandState.keyHistory->keys->use) ? newSize-1 : newSize;
-
-        for (int unsigned x = 0; x < newKeys->use; x++)
-          newKeys->content[x] = waylandState.keyHistory->keys->content[x+1];
-
-        free(waylandState.keyHistory->keys);
-        waylandState.keyHistory->keys = newKeys;
-      }
-      else
-      { // puts("Failed to allocate key history's reduced key block.");
-        raise_error(MEMORY_ERROR);
-      }
-    }
-    else
-    { for (int unsigned x = 0; x < waylandState.keyHistory->keys->use - 1; x++)
-        waylandState.keyHistory->keys->content[x] = waylandState.keyHistory->keys->content[x+1];
-      waylandState.keyHistory->keys->use--;
-    }
   } while (getNextChar);
 
   return result;
@@ -731,8 +630,8 @@ charType gkbRawGetc (void)
 
 boolType gkbInputReady (void)
 {
-  return poll_events(FALSE) && waylandState.keyHistory && waylandState.keyHistory->keys &&
-    waylandState.keyHistory->keys->use > 0;
+  poll_events(FALSE);
+  return key_history_populated();
 }
 
 void gkbSelectInput (winType aWindow, charType aKey, boolType active)
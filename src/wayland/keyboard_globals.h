@@ -3,5 +3,5 @@
 #include "../kbd_drv.h"
 #include "state.h"
 
-void expand_key_history (struct ClientState *state, uint32_t key);
+void queue_key_event (struct ClientState *state, uint32_t key);
 #endif
\ No newline at end of file
@@ -16,17 +16,43 @@ struct KeyState
   int unsigned modifiers;
 };*/
 
-struct KeyArray
+#define INPUT_RING_SIZE 256 // Must be a power of two.
+
+#define INPUT_EVENT_KEY    0 // Key, button, resize or close event.
+#define INPUT_EVENT_MOTION 1 // Pointer motion (consecutive motions are merged).
+
+struct InputEvent
 {
-  int unsigned size;
-  int unsigned use; // Can be a portion of size (to reduce re-allocation).
-  uint32_t content[];
+  int unsigned kind;
+  uint32_t key; // Seed7 key code (only used by INPUT_EVENT_KEY).
+  int x;        // Pointer position when the event was queued.
+  int y;
 };
 
-struct KeyHistory
+// Fixed-capacity queue of input events. The Wayland listeners only
+// advance tail and the readers only advance head (except when the
+// queue is full and the oldest event is dropped). Head and tail are
+// free running and are masked with INPUT_RING_SIZE - 1 when used.
+struct InputRing
+{
+  int unsigned head;
+  int unsigned tail;
+  struct InputEvent events[INPUT_RING_SIZE];
+};
+
+// Pressed keys: Characters below PRESSED_CHAR_LIMIT and the Seed7
+// key codes starting at KEYCODE_BASE are stored in a bitmap. Other
+// key codes (e.g. unmapped keysyms) are stored in a small array.
+#define PRESSED_CHAR_LIMIT 0x1000
+#define PRESSED_KEYCODE_LIMIT 0x200
+#define PRESSED_BITMAP_WORDS ((PRESSED_CHAR_LIMIT + PRESSED_KEYCODE_LIMIT) / 32)
+#define PRESSED_OTHER_SIZE 16
+
+struct PressedKeys
 {
-  time_t age;
-  struct KeyArray *keys;
+  uint32_t bitmap[PRESSED_BITMAP_WORDS];
+  int unsigned otherCount;
+  uint32_t other[PRESSED_OTHER_SIZE];
 };
 
 struct MousePoint
@@ -61,9 +87,10 @@ struct ClientState
   struct xkb_context *xkbContext;
   struct xkb_keymap *xkbKeymap;
 
-  struct KeyHistory *keyHistory;
-  struct KeyArray *keysPressed;
-  struct MousePoint mousePoint;
+  struct InputRing inputRing;
+  struct PressedKeys keysPressed;
+  struct MousePoint pointerPoint; // Latest position reported by Wayland.
+  struct MousePoint mousePoint;   // Position as of the last event read.
 
   // Output (eg monitor).
   int outputWidth;